@@ -235,8 +235,7 @@ namespace QuantLib {
         }
         if (fixingDate == today) {
             // might have been fixed
-            Rate pastFixing =
-                IndexManager::instance().getHistory((underlying_->index())->name())[fixingDate];
+            Rate pastFixing = underlying_->index()->timeSeries()[fixingDate];
             if (pastFixing != Null<Real>()) {
                 return underlyingRate + callCsi_ * callPayoff() + putCsi_  * putPayoff();
             } else
@@ -53,10 +53,10 @@ namespace QuantLib {
 
                 // already fixed part
                 Date today = Settings::instance().evaluationDate();
+                const FixingTimeSeries& history = index->timeSeries();
                 while (i<n && fixingDates[i]<today) {
                     // rate must have been fixed
-                    Rate pastFixing = IndexManager::instance().getHistory(
-                                                index->name())[fixingDates[i]];
+                    Rate pastFixing = history[fixingDates[i]];
                     QL_REQUIRE(pastFixing != Null<Real>(),
                                "Missing " << index->name() <<
                                " fixing for " << fixingDates[i]);
@@ -68,8 +68,7 @@ namespace QuantLib {
                 if (i<n && fixingDates[i] == today) {
                     // might have been fixed
                     try {
-                        Rate pastFixing = IndexManager::instance().getHistory(
-                                                index->name())[fixingDates[i]];
+                        Rate pastFixing = history[fixingDates[i]];
                         if (pastFixing != Null<Real>()) {
                             compoundFactor *= (1.0 + pastFixing*dt[i]);
                             ++i;
@@ -0,0 +1,360 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fftlossmodel.hpp
+    \brief Default loss model using Fourier inversion of the conditional loss
+*/
+
+#ifndef quantlib_fft_loss_model_hpp
+#define quantlib_fft_loss_model_hpp
+
+#include <ql/experimental/credit/constantlosslatentmodel.hpp>
+#include <ql/experimental/credit/defaultlossmodel.hpp>
+#include <ql/math/fastfouriertransform.hpp>
+#include <complex>
+#include <map>
+#include <algorithm>
+
+namespace QuantLib {
+
+    /*! STCDO default loss model for a heterogeneous pool of names,
+    computing the loss distribution conditional to the market factor by
+    discrete Fourier inversion of its characteristic function.
+
+    Losses are discretized in units as in the RecursiveLossModel, so that
+    both models give the same distribution up to rounding. Conditional to
+    the market factor, the characteristic function of the pool loss is
+    the product of the ones of the independent names:
+    \f[
+    \phi(u_k|\omega) = \prod_i \left(1 - p_i(\omega) +
+        p_i(\omega)\, e^{-2\pi\imath k w_i/N}\right)
+    \f]
+    where \f$ w_i \f$ is the loss of the i-th name in loss units and N is
+    a power of two larger than the maximum pool loss; the distribution is
+    recovered with one inverse FastFourierTransform. Names sharing the
+    same loss are grouped, and the roots of unity for each group are
+    computed once per basket instead of at each integration node.
+
+    Names in a group with the same unconditional default probability
+    and factor loadings have the same conditional default probability,
+    so that their factors are raised to the number of such names
+    instead of being multiplied one by one. The cost at each node is
+    proportional to the number of distinct names times N/2, plus the
+    inverse transform; for a homogeneous pool it is much lower than
+    the one of the RecursiveLossModel, which is proportional to the
+    number of names times the maximum loss, while for a pool with no
+    identical names there is no gain.
+
+    The unconditional loss distribution at each date is cached, so that
+    tranches of the same pool reuse it; the cache is used as long as the
+    loss units, the names' probabilities and the factor loadings do not
+    change.
+    */
+    template<class copulaPolicy>
+    class FFTLossModel : public DefaultLossModel {
+    public:
+        explicit FFTLossModel(
+            const std::shared_ptr<ConstantLossLatentmodel<copulaPolicy> >& m,
+            Size nbuckets = 1)
+        : copula_(m), nBuckets_(nbuckets), lossUnit_(0.) { }
+
+        Real expectedTrancheLoss(const Date& date) const;
+        /*! Probabilities of the pool losing k loss units, for k from
+            zero to the maximum pool loss.
+        */
+        std::vector<Real> lossProbability(const Date& date) const;
+        std::map<Real, Probability> lossDistribution(const Date& d) const;
+        Real percentile(const Date& d, Real percentile) const;
+        Real expectedShortfall(const Date& d, Real perctl) const;
+    protected:
+        void resetModel();
+        const std::shared_ptr<ConstantLossLatentmodel<copulaPolicy> > copula_;
+    private:
+        // names of each group with the same conditional default
+        //   probability, as pairs of a representative and their number
+        typedef std::vector<std::vector<std::pair<Size, Size> > >
+            IdenticalNames;
+        IdenticalNames identicalNames(
+            const std::vector<Real>& invProbs) const;
+        std::vector<Real> conditionalLossProb(
+            const std::vector<Real>& invProbs,
+            const IdenticalNames& names,
+            const std::vector<Real>& mktFactor) const;
+        static std::complex<Real> power(std::complex<Real> z, Size n) {
+            std::complex<Real> result(1.);
+            for(; n != 0; n >>= 1) {
+                if(n & 1)
+                    result *= z;
+                z *= z;
+            }
+            return result;
+        }
+        Real trancheLoss(Size lossUnits) const {
+            return std::min(std::max(lossUnits * lossUnit_ - attachAmount_,
+                0.), detachAmount_ - attachAmount_);
+        }
+
+        const Size nBuckets_;
+        mutable Real lossUnit_;
+        mutable Real attachAmount_, detachAmount_;
+        mutable std::vector<Size> wk_;
+        mutable Size maxLoss_;
+        // names grouped by loss and the powers of the roots of unity
+        //   for each group, up to N/2
+        mutable std::vector<std::vector<Size> > groups_;
+        mutable std::vector<std::vector<std::complex<Real> > > roots_;
+        mutable std::shared_ptr<FastFourierTransform> fft_;
+
+        struct CachedDistribution {
+            std::vector<Real> invProbs;
+            std::vector<std::vector<Real> > factorWeights;
+            std::vector<Real> probabilities;
+        };
+        mutable std::map<Date, CachedDistribution> distributions_;
+    };
+
+    typedef FFTLossModel<GaussianCopulaPolicy> FFTGaussLossModel;
+
+    // Inlines ------------------------------------------------
+
+    template<class CP>
+    void FFTLossModel<CP>::resetModel() {
+        const std::vector<Real>& notionals = basket_->remainingNotionals();
+        attachAmount_ = basket_->remainingAttachmentAmount();
+        detachAmount_ = basket_->remainingDetachmentAmount();
+
+        copula_->resetBasket(basket_.currentLink());
+
+        std::vector<Real> lgds;
+        for(Size i=0; i<notionals.size(); ++i)
+            lgds.emplace_back(notionals[i]*(1.-copula_->recoveries()[i]));
+        Real minLgd = QL_MAX_REAL;
+        for(Size i=0; i<lgds.size(); ++i)
+            if(lgds[i] != 0.)
+                minLgd = std::min(minLgd, lgds[i]);
+        QL_REQUIRE(minLgd != QL_MAX_REAL, "no name can incur a loss");
+        const Real lossUnit = minLgd / nBuckets_;
+
+        std::vector<Size> wk;
+        for(Size i=0; i<lgds.size(); ++i)
+            wk.emplace_back(static_cast<Size>(std::floor(lgds[i]/lossUnit + .5)));
+
+        // tranches of the same pool keep the cached distributions
+        if(lossUnit == lossUnit_ && wk == wk_)
+            return;
+        lossUnit_ = lossUnit;
+        wk_.swap(wk);
+        distributions_.clear();
+
+        maxLoss_ = 0;
+        std::map<Size, std::vector<Size> > groups;
+        for(Size i=0; i<wk_.size(); ++i) {
+            maxLoss_ += wk_[i];
+            if(wk_[i] != 0)
+                groups[wk_[i]].emplace_back(i);
+        }
+
+        const Size order =
+            std::max<Size>(FastFourierTransform::min_order(maxLoss_+1), 1);
+        fft_ = std::make_shared<FastFourierTransform>(order);
+        const Size N = fft_->output_size();
+
+        groups_.clear();
+        roots_.clear();
+        for(std::map<Size, std::vector<Size> >::const_iterator it =
+                groups.begin(); it != groups.end(); ++it) {
+            groups_.emplace_back(it->second);
+            std::vector<std::complex<Real> > roots(N/2+1);
+            for(Size k=0; k<=N/2; ++k)
+                roots[k] = std::polar(1.,
+                    -2.*M_PI*static_cast<Real>((k*it->first) % N) / N);
+            roots_.emplace_back(roots);
+        }
+    }
+
+    template<class CP>
+    typename FFTLossModel<CP>::IdenticalNames
+        FFTLossModel<CP>::identicalNames(
+            const std::vector<Real>& invProbs) const
+    {
+        const std::vector<std::vector<Real> >& weights =
+            copula_->factorWeights();
+        IdenticalNames names(groups_.size());
+        for(Size g=0; g<groups_.size(); ++g) {
+            for(Size i=0; i<groups_[g].size(); ++i) {
+                const Size iName = groups_[g][i];
+                Size j = 0;
+                for(; j<names[g].size(); ++j) {
+                    const Size jName = names[g][j].first;
+                    if(invProbs[jName] == invProbs[iName]
+                        && weights[jName] == weights[iName])
+                        break;
+                }
+                if(j == names[g].size())
+                    names[g].emplace_back(iName, 1);
+                else
+                    ++names[g][j].second;
+            }
+        }
+        return names;
+    }
+
+    template<class CP>
+    std::vector<Real> FFTLossModel<CP>::conditionalLossProb(
+        const std::vector<Real>& invProbs,
+        const IdenticalNames& names,
+        const std::vector<Real>& mktFactor) const
+    {
+        const Size N = fft_->output_size();
+        // the characteristic function of a real distribution is
+        //   hermitian: only the first half is computed
+        std::vector<std::complex<Real> > phi(N, std::complex<Real>(1.));
+        for(Size g=0; g<names.size(); ++g) {
+            const std::vector<std::complex<Real> >& roots = roots_[g];
+            for(Size i=0; i<names[g].size(); ++i) {
+                const Size iName = names[g][i].first;
+                const Size count = names[g][i].second;
+                const Probability pDef =
+                    copula_->conditionalDefaultProbabilityInvP(
+                        invProbs[iName], iName, mktFactor);
+                if(count == 1) {
+                    for(Size k=0; k<=N/2; ++k)
+                        phi[k] *= (1.-pDef) + pDef * roots[k];
+                } else {
+                    for(Size k=0; k<=N/2; ++k)
+                        phi[k] *= power((1.-pDef) + pDef * roots[k], count);
+                }
+            }
+        }
+        for(Size k=N/2+1; k<N; ++k)
+            phi[k] = std::conj(phi[N-k]);
+
+        std::vector<std::complex<Real> > inverse(N);
+        fft_->inverse_transform(phi.begin(), phi.end(), inverse.begin());
+
+        std::vector<Real> results(maxLoss_+1);
+        for(Size k=0; k<=maxLoss_; ++k)
+            results[k] = std::max(inverse[k].real() / N, 0.);
+        return results;
+    }
+
+    template<class CP>
+    std::vector<Real>
+        FFTLossModel<CP>::lossProbability(const Date& date) const {
+
+        std::vector<Probability> uncDefProb =
+            basket_->remainingProbabilities(date);
+        std::vector<Real> invProbs;
+        for(Size i=0; i<uncDefProb.size(); ++i)
+            invProbs.emplace_back(
+                copula_->inverseCumulativeY(uncDefProb[i], i));
+
+        typename std::map<Date, CachedDistribution>::const_iterator cached =
+            distributions_.find(date);
+        if(cached != distributions_.end()
+            && cached->second.invProbs == invProbs
+            && cached->second.factorWeights == copula_->factorWeights())
+            return cached->second.probabilities;
+
+        const IdenticalNames names = identicalNames(invProbs);
+        CachedDistribution& distribution = distributions_[date];
+        distribution.probabilities = copula_->integratedExpectedValue(
+            [this, &invProbs, &names](const std::vector<Real>& x) {
+                return conditionalLossProb(invProbs, names, x);
+            });
+        distribution.invProbs.swap(invProbs);
+        distribution.factorWeights = copula_->factorWeights();
+        return distribution.probabilities;
+    }
+
+    template<class CP>
+    inline Real FFTLossModel<CP>::expectedTrancheLoss(
+        const Date& date) const
+    {
+        const std::vector<Real> probs = lossProbability(date);
+        Real expLoss = 0.;
+        for(Size k=0; k<probs.size(); ++k)
+            expLoss += trancheLoss(k) * probs[k];
+        return expLoss;
+    }
+
+    template<class CP>
+    std::map<Real, Probability>
+        FFTLossModel<CP>::lossDistribution(const Date& d) const
+    {
+        std::map<Real, Probability> distrib;
+        std::vector<Real> values = lossProbability(d);
+        Real sum = 0.;
+        for(Size i=0; i<values.size(); ++i) {
+            sum += values[i];
+            distrib.insert(std::make_pair(i * lossUnit_, sum));
+        }
+        return distrib;
+    }
+
+    template<class CP>
+    Real FFTLossModel<CP>::percentile(const Date& d,
+        Real percentile) const
+    {
+        QL_REQUIRE(percentile >= 0. && percentile <= 1.,
+            "Incorrect percentile");
+        const std::vector<Real> probs = lossProbability(d);
+
+        // first loss whose cumulative probability reaches the percentile,
+        //   interpolated linearly with the previous one
+        Real cumulative = probs[0];
+        if(cumulative >= percentile)
+            return trancheLoss(0);
+        Size k = 1;
+        for(; k<probs.size(); ++k) {
+            if(cumulative + probs[k] >= percentile)
+                break;
+            cumulative += probs[k];
+        }
+        // rounding might leave the percentile out of reach
+        if(k == probs.size())
+            return trancheLoss(k - 1);
+        const Real portfLoss = lossUnit_ * (k - 1 +
+            std::min((percentile - cumulative) / probs[k], 1.));
+        return std::min(std::max(portfLoss - attachAmount_, 0.),
+            detachAmount_ - attachAmount_);
+    }
+
+    template<class CP>
+    Real FFTLossModel<CP>::expectedShortfall(const Date& d,
+        Real perctl) const
+    {
+        QL_REQUIRE(perctl >= 0. && perctl < 1., "Incorrect percentile");
+        if(d == Settings::instance().evaluationDate()) return 0.;
+        const std::vector<Real> probs = lossProbability(d);
+
+        // losses beyond the percentile; the loss at the percentile only
+        //   contributes with the probability in excess of it.
+        Real cumulative = 0., suma = 0.;
+        for(Size k=0; k<probs.size(); ++k) {
+            const Real next = cumulative + probs[k];
+            if(next > perctl)
+                suma += trancheLoss(k) *
+                    (next - std::max(cumulative, perctl));
+            cumulative = next;
+        }
+        return suma / (1. - perctl);
+    }
+
+}
+
+#endif
@@ -35,6 +35,10 @@
 #include <ql/experimental/math/tcopulapolicy.hpp>
 
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
+#include <ql/math/randomnumbers/randomsequencegenerator.hpp>
+#include <ql/math/statistics/tdigeststatistics.hpp>
+#include <ql/utilities/parallelfor.hpp>
+#include <algorithm>
 
 /* Intended to replace
     ql\experimental\credit\randomdefaultmodel.Xpp
@@ -58,7 +62,8 @@ namespace QuantLib {
     data. The statistic post processing needs to have the results stored in
     memory and simulations can not be consumed at generation time, typically
     because some statistics are conditional on others (e.g. ESF) or/and
-    parametric (percentile, etc...)
+    parametric (percentile, etc...); unless the statistics are accumulated
+    on the fly at given dates.
 
     Simulation events do not derive from each other, and they are specialized
     for each type; duck typing applies for variable names (see the statistic
@@ -73,10 +78,27 @@ namespace QuantLib {
     Generates the factors and variable samples and determines event threshold
     but it is not responsible for actual event specification; thats the derived
     classes responsibility according to what they model.
-    Derived classes need mainly to implement nextSample (Worker::nextSample in
-    the multithreaded version) to compute the simulation event generated, if
-    any, from the latent variables sample. They also have the accompanying
-    event trait to specify.
+    Derived classes need mainly to implement nextSample to compute the
+    simulation events generated, if any, from the latent variables sample.
+    They also have the accompanying event trait to specify.
+
+    Simulations can be split among several threads. Each thread draws a
+    contiguous range of simulations from its own substream: a Sobol
+    generator skips to the first point of the range, so that results do not
+    depend on the number of threads; Mersenne-Twister sequences are taken
+    from non-overlapping streams (see MersenneTwisterStreamFactory); other
+    generators are seeded independently.
+
+    By default the events of all simulations are stored and each statistic
+    rescans them. Alternatively, loss statistics can be accumulated on the
+    fly at a set of horizon dates (see accumulateStatistics) and the events
+    are then discarded, so that memory does not grow with the number of
+    simulations.
+
+    \warning with more than one thread, the latent model and the default
+             probability curves are accessed concurrently. The first
+             simulation is run beforehand so as to trigger any lazy
+             calculation.
     */
     /* CRTP used for performance to avoid virtual table resolution in the Monte
     Carlo. Not only in sample generation but access; quite an amount of time can
@@ -84,9 +106,6 @@ namespace QuantLib {
     positions that part of the problem will be starting to overtake the
     simulation costs.
 
-    \todo: someone with sound experience on cache misses look into this, the
-    statistics will be getting memory in and out of the cpu heavily and it
-    might be possible to get performance out of that.
     \todo: parallelize the statistics computation, things like Var/ESF splits
     are very expensive.
     \todo: consider another design, taking the statistics outside the models.
@@ -100,17 +119,55 @@ namespace QuantLib {
         // random generation is performed in this class only.
         typedef typename LatentModel<copulaPolicy>::template FactorSampler<USNG>
             copulaRNG_type;
+        typedef simEvent<derivedRandomLM<copulaPolicy, USNG> > simEvent_type;
     protected:
         RandomLM(Size numFactors,
             Size numLMVars,
             const copulaPolicy& copula,
             Size nSims,
-            BigNatural seed)
+            BigNatural seed,
+            Size threads = 1)
         : seed_(seed), numFactors_(numFactors), numLMVars_(numLMVars),
-          nSims_(nSims), copula_(copula) {}
+          nSims_(nSims), threads_(threads), copula_(copula) {}
+
+        /* Events of a simulation; they are stored contiguously with those of
+        the other simulations. */
+        class simEventRange {
+          public:
+            simEventRange(const simEvent_type* begin, const simEvent_type* end)
+            : begin_(begin), end_(end) {}
+            Size size() const { return end_ - begin_; }
+            const simEvent_type& operator[](Size i) const {
+                return begin_[i];
+            }
+          private:
+            const simEvent_type *begin_, *end_;
+        };
+
+        /* Statistics accumulated at a horizon date while simulating. The
+        nth-event hits take a memory quadratic in the basket size. */
+        struct horizonStatistics {
+            explicit horizonStatistics(Size basketSize)
+            : eventCounts(basketSize+1, 0),
+              nthEventHits(basketSize*basketSize, 0) {}
+            void merge(const horizonStatistics& other) {
+                trancheLosses.merge(other.trancheLosses);
+                for(Size i=0; i<eventCounts.size(); i++)
+                    eventCounts[i] += other.eventCounts[i];
+                for(Size i=0; i<nthEventHits.size(); i++)
+                    nthEventHits[i] += other.nthEventHits[i];
+            }
+            TDigestStatistics trancheLosses;
+            // number of simulations with a given number of events
+            std::vector<Size> eventCounts;
+            // times the name j was the (i+1)-th event, at i*basketSize+j
+            std::vector<Size> nthEventHits;
+        };
 
         void update() {
-            simsBuffer_.clear();
+            simEvents_.clear();
+            simEventsEnd_.clear();
+            horizonStats_.clear();
             // tell basket to notify instruments, etc, we are invalid
             if(!basket_.empty()) basket_->notifyObservers();
             LazyObject::update();
@@ -119,29 +176,87 @@ namespace QuantLib {
         void performCalculations() const {
             static_cast<const derivedRandomLM<copulaPolicy, USNG>* >(
                 this)->initDates();//in update?
-            copulasRng_ = std::make_shared<copulaRNG_type>(copula_, seed_);
             performSimulations();
         }
 
         void performSimulations() const {
-            // Next sequence should determine the event and push it into buffer
-            for(Size i=nSims_; i; i--) {
-                const std::vector<Real>& sample =
-                    copulasRng_->nextSequence().value;
-                static_cast<const derivedRandomLM<copulaPolicy, USNG>* >(
-                    this)->nextSample(sample);
-            // alternatively make call an explicit local method...
+            const derivedRandomLM<copulaPolicy, USNG>* derived =
+                static_cast<const derivedRandomLM<copulaPolicy, USNG>* >(this);
+            Size workers = std::max<Size>(std::min(threads_, nSims_), 1);
+
+            Date today = Settings::instance().evaluationDate();
+            std::vector<Date::serial_type> horizonDays;
+            for(Size i=0; i<horizonDates_.size(); i++)
+                horizonDays.emplace_back(horizonDates_[i].serialNumber() -
+                    today.serialNumber());
+            const bool storeEvents = horizonDays.empty();
+
+            // each worker takes a contiguous range of simulations
+            std::vector<std::shared_ptr<copulaRNG_type> > samplers;
+            for(Size w=0; w<workers; w++)
+                samplers.emplace_back(workerSampler(w, w*nSims_/workers));
+            std::vector<std::vector<simEvent_type> > events(workers);
+            std::vector<std::vector<Size> > eventsEnd(workers);
+            std::vector<std::vector<horizonStatistics> > stats(workers,
+                std::vector<horizonStatistics>(horizonDays.size(),
+                    horizonStatistics(basket_->size())));
+
+            auto simulate = [&](Size w, Size first, Size last) {
+                std::vector<simEvent_type> simBuffer;
+                for(Size i=first; i<last; i++) {
+                    const std::vector<Real>& sample =
+                        samplers[w]->nextSequence().value;
+                    // Next sequence should determine the events and store
+                    //   them or add them to the statistics
+                    if(storeEvents) {
+                        derived->nextSample(sample, events[w]);
+                        eventsEnd[w].emplace_back(events[w].size());
+                    } else {
+                        simBuffer.clear();
+                        derived->nextSample(sample, simBuffer);
+                        addToStatistics(simBuffer, horizonDays, stats[w]);
+                    }
+                }
+            };
+            // triggers lazy calculations before going multithreaded
+            simulate(0, 0, std::min<Size>(nSims_, 1));
+            parallelFor(workers, workers, [&](Size w) {
+                simulate(w, w == 0 ? std::min<Size>(nSims_, 1)
+                                   : w*nSims_/workers,
+                         (w+1)*nSims_/workers);
+            });
+
+            // merge in worker order
+            if(storeEvents) {
+                simEvents_.swap(events[0]);
+                simEventsEnd_.swap(eventsEnd[0]);
+                for(Size w=1; w<workers; w++) {
+                    Size offset = simEvents_.size();
+                    simEvents_.insert(simEvents_.end(), events[w].begin(),
+                        events[w].end());
+                    for(Size i=0; i<eventsEnd[w].size(); i++)
+                        simEventsEnd_.emplace_back(offset + eventsEnd[w][i]);
+                    std::vector<simEvent_type>().swap(events[w]);
+                }
+            } else {
+                horizonStats_.swap(stats[0]);
+                for(Size w=1; w<workers; w++)
+                    for(Size h=0; h<horizonStats_.size(); h++)
+                        horizonStats_[h].merge(stats[w][h]);
             }
         }
 
         /* Method to access simulation results and avoiding a copy of
         each thread results buffer. PerformCalculations should have been called.
-        Here in the monothread version this method is redundant/trivial but
-        serves to detach the statistics access to the way the simulations are
+        Serves to detach the statistics access to the way the simulations are
         stored.
         */
-        const std::vector<simEvent<derivedRandomLM<copulaPolicy, USNG> > >&
-            getSim(const Size iSim) const { return simsBuffer_[iSim]; }
+        simEventRange getSim(const Size iSim) const {
+            const simEvent_type* data = simEvents_.data();
+            return simEventRange(
+                data + (iSim == 0 ? 0 : simEventsEnd_[iSim-1]),
+                data + simEventsEnd_[iSim]);
+        }
 
         /* Allows statistics to be written generically for fixed and random
         recovery rates. */
@@ -207,19 +322,81 @@ namespace QuantLib {
         //@}
     public:
         virtual ~RandomLM() {}
+        /*! Accumulates the loss statistics at the given dates while
+        simulating, instead of storing the simulated events. Statistics are
+        then only available at these dates; percentiles and expected
+        shortfall are estimated from a t-digest (see TDigestStatistics) and
+        the statistics conditional on the events (default correlation, loss
+        distribution and histogram, VaR splits) are not available.
+        An empty set of dates reverts to storing the events.
+        */
+        void accumulateStatistics(const std::vector<Date>& horizonDates) {
+            horizonDates_ = horizonDates;
+            update();
+        }
     private:
+        // Sobol points are taken from the same sequence for all workers
+        std::shared_ptr<copulaRNG_type> workerSampler(Size,
+            Size firstSim, const SobolRsg*) const {
+            SobolRsg rsg(copula_.numFactors(), seed_);
+            rsg.skipTo(firstSim);
+            return std::make_shared<copulaRNG_type>(copula_, rsg);
+        }
+        std::shared_ptr<copulaRNG_type> workerSampler(Size worker, Size,
+            const RandomSequenceGenerator<MersenneTwisterUniformRng>*) const {
+            return std::make_shared<copulaRNG_type>(copula_,
+                RandomSequenceGenerator<MersenneTwisterUniformRng>(
+                    copula_.numFactors(),
+                    MersenneTwisterStreamFactory(seed_).stream(worker)));
+        }
+        // other generators are seeded from a Mersenne-Twister sequence
+        template <class G>
+        std::shared_ptr<copulaRNG_type> workerSampler(Size worker, Size,
+            const G*) const {
+            BigNatural seed = seed_;
+            if(seed_ != 0 && worker != 0) {
+                MersenneTwisterUniformRng rng(seed_);
+                for(Size i=0; i<worker; i++) {
+                    do {
+                        seed = rng.nextInt32();
+                    } while (seed == 0);
+                }
+            }
+            return std::make_shared<copulaRNG_type>(copula_, seed);
+        }
+        std::shared_ptr<copulaRNG_type> workerSampler(Size worker,
+            Size firstSim) const {
+            return workerSampler(worker, firstSim,
+                static_cast<const USNG*>(nullptr));
+        }
+        /* Adds the events of a simulation to the statistics at each horizon.
+        Events are sorted in time in the process. */
+        void addToStatistics(std::vector<simEvent_type>& events,
+            const std::vector<Date::serial_type>& horizonDays,
+            std::vector<horizonStatistics>& stats) const;
+        // index of the statistics accumulated at the date, Null if none
+        Size horizonIndex(const Date& d) const;
+        void requireEvents() const {
+            QL_REQUIRE(horizonDates_.empty(),
+                "Statistic not available, simulated events are not stored.");
+        }
+
         BigNatural seed_;
     protected:
         const Size numFactors_;
         const Size numLMVars_;
 
         const Size nSims_;
+        const Size threads_;
 
-        mutable std::vector<std::vector<simEvent<derivedRandomLM<copulaPolicy,
-            USNG > > > > simsBuffer_;
+        // horizons of the statistics accumulated on the fly, if any
+        std::vector<Date> horizonDates_;
+        // events of all simulations, simulation i ending at simEventsEnd_[i]
+        mutable std::vector<simEvent_type> simEvents_;
+        mutable std::vector<Size> simEventsEnd_;
+        mutable std::vector<horizonStatistics> horizonStats_;
 
         mutable copulaPolicy copula_;
-        mutable std::shared_ptr<copulaRNG_type> copulasRng_;
 
         // Maximum time inversion horizon
         static const Size maxHorizon_ = 4050; // over 11 years
@@ -227,6 +404,56 @@ namespace QuantLib {
     };
 
 
+    template<template <class, class> class D, class C, class URNG>
+    void RandomLM<D, C, URNG>::addToStatistics(
+        std::vector<simEvent_type>& events,
+        const std::vector<Date::serial_type>& horizonDays,
+        std::vector<horizonStatistics>& stats) const
+    {
+        Date today = Settings::instance().evaluationDate();
+        Real attachAmount = basket_->attachmentAmount();
+        Real detachAmount = basket_->detachmentAmount();
+        Size basketSize = basket_->size();
+
+        // stable, for the first name among simultaneous events to be ranked
+        std::stable_sort(events.begin(), events.end());
+        for(Size h=0; h<horizonDays.size(); h++) {
+            Real portfSimLoss=0.;
+            Size nEvents = 0, nRanked = 0;
+            // events within the time horizon come first
+            for(; nEvents < events.size() &&
+                    horizonDays[h] > static_cast<Date::serial_type>(
+                        events[nEvents].dayFromRef); nEvents++) {
+                const simEvent_type& evt = events[nEvents];
+                Size iName = evt.nameIdx;
+                portfSimLoss +=
+                    basket_->exposure(basket_->names()[iName],
+                        Date(evt.dayFromRef + today.serialNumber())) *
+                            (1.-getEventRecovery(evt));
+                // as in probsBeingNthEvent, only one event a day is ranked
+                if(nEvents == 0 ||
+                   events[nEvents-1].dayFromRef != evt.dayFromRef)
+                    stats[h].nthEventHits[(nRanked++)*basketSize + iName]++;
+            }
+            stats[h].eventCounts[nEvents]++;
+            stats[h].trancheLosses.add(
+                std::min(std::max(portfSimLoss - attachAmount, 0.),
+                    detachAmount - attachAmount));
+        }
+    }
+
+
+    template<template <class, class> class D, class C, class URNG>
+    Size RandomLM<D, C, URNG>::horizonIndex(const Date& d) const {
+        if(horizonDates_.empty()) return Null<Size>();
+        std::vector<Date>::const_iterator it =
+            std::find(horizonDates_.begin(), horizonDates_.end(), d);
+        QL_REQUIRE(it != horizonDates_.end(),
+            "Statistics were not accumulated at " << d << ".");
+        return std::distance(horizonDates_.begin(), it);
+    }
+
+
     /* ---- Statistics ---------------------------------------------------  */
 
     template<template <class, class> class D, class C, class URNG>
@@ -242,11 +469,20 @@ namespace QuantLib {
 
         if(n==0) return 1.;
 
+        Size h = horizonIndex(d);
+        if(h != Null<Size>()) {
+            const std::vector<Size>& eventCounts =
+                horizonStats_[h].eventCounts;
+            Real counts = 0.;
+            for(Size k=n; k<eventCounts.size(); k++)
+                counts += eventCounts[k];
+            return counts/nSims_;
+        }
+
         Real counts = 0.;
         for(Size iSim=0; iSim < nSims_; iSim++) {
             Size simCount = 0;
-            const std::vector<simEvent<D<C, URNG> > >& events =
-                getSim(iSim);
+            const simEventRange events = getSim(iSim);
             for(Size iEvt=0; iEvt < events.size(); iEvt++)
                 // duck type on the members:
                 if(val > events[iEvt].dayFromRef) simCount++;
@@ -272,8 +508,14 @@ namespace QuantLib {
         Natural val = d.serialNumber() - today.serialNumber();
 
         std::vector<Probability> hitsByDate(basketSize, 0.);
-        for(Size iSim=0; iSim < nSims_; iSim++) {
-            const std::vector<simEvent<D<C, URNG> > >& events = getSim(iSim);
+        Size h = horizonIndex(d);
+        if(h != Null<Size>()) {
+            const std::vector<Size>& hits = horizonStats_[h].nthEventHits;
+            std::copy(hits.begin() + (n-1)*basketSize,
+                hits.begin() + n*basketSize, hitsByDate.begin());
+        }
+        else for(Size iSim=0; iSim < nSims_; iSim++) {
+            const simEventRange events = getSim(iSim);
             std::map<unsigned short, unsigned short> namesDefaulting;
             for(Size iEvt=0; iEvt < events.size(); iEvt++) {
                 // if event is within time horizon...
@@ -305,6 +547,7 @@ namespace QuantLib {
     {
         // a control variate with the probabilities is possible
         calculate();
+        requireEvents();
         Date today = Settings::instance().evaluationDate();
 
         QL_REQUIRE(d>today, "Date for statistic must be in the future.");
@@ -317,7 +560,7 @@ namespace QuantLib {
         Real expectedDefi = 0.;
         Real expectedDefj = 0.;
         for(Size iSim=0; iSim < nSims_; iSim++) {
-            const std::vector<simEvent<D<C, URNG> > >& events = getSim(iSim);
+            const simEventRange events = getSim(iSim);
             Real imatch = 0., jmatch = 0.;
             for(Size iEvt=0; iEvt < events.size(); iEvt++) {
                 if((val > events[iEvt].dayFromRef) &&
@@ -355,13 +598,22 @@ namespace QuantLib {
         Date today = Settings::instance().evaluationDate();
         Date::serial_type val = d.serialNumber() - today.serialNumber();
 
+        Size h = horizonIndex(d);
+        if(h != Null<Size>()) {
+            const TDigestStatistics& lossStats =
+                horizonStats_[h].trancheLosses;
+            return std::make_pair(lossStats.mean(), lossStats.errorEstimate()
+                * InverseCumulativeNormal::standard_value(
+                    0.5*(1.+confidencePerc)));
+        }
+
         Real attachAmount = basket_->attachmentAmount();
         Real detachAmount = basket_->detachmentAmount();
 
         // Real trancheLoss= 0.;
         GeneralStatistics lossStats;
         for(Size iSim=0; iSim < nSims_; iSim++) {
-            const std::vector<simEvent<D<C, URNG> > >& events = getSim(iSim);
+            const simEventRange events = getSim(iSim);
 
             Real portfSimLoss=0.;
             for(Size iEvt=0; iEvt < events.size(); iEvt++) {
@@ -415,12 +667,13 @@ namespace QuantLib {
         QL_REQUIRE(d >= today,
             "Requested percentile date must lie after computation date.");
         calculate();
+        requireEvents();
 
         Real attachAmount = basket_->attachmentAmount();
         Real detachAmount = basket_->detachmentAmount();
 
         for(Size iSim=0; iSim < nSims_; iSim++) {
-            const std::vector<simEvent<D<C, URNG> > >& events = getSim(iSim);
+            const simEventRange events = getSim(iSim);
 
             Real portfSimLoss=0.;
             for(Size iEvt=0; iEvt < events.size(); iEvt++) {
@@ -461,10 +714,24 @@ namespace QuantLib {
         Date::serial_type val = d.serialNumber() - today.serialNumber();
         if(val <= 0) return 0.;// plus basket realized losses
 
+        Size h = horizonIndex(d);
+        if(h != Null<Size>()) {
+            const TDigestStatistics& losses = horizonStats_[h].trancheLosses;
+            Real perctlInf = losses.percentile(percent);
+            std::pair<Real, Size> tail = losses.expectationValue(
+                [](Real x) { return x; },
+                [perctlInf](Real x) { return x >= perctlInf; });
+            Probability probOverQ =
+                static_cast<Real>(tail.second) / static_cast<Real>(nSims_);
+            return ( perctlInf * (1.-percent-probOverQ) +
+                (tail.second == 0 ? 0. : tail.first * probOverQ)
+                )/(1.-percent);
+        }
+
         //GenericRiskStatistics<GeneralStatistics> statsX;
         std::vector<Real> losses;
         for(Size iSim=0; iSim < nSims_; iSim++) {
-            const std::vector<simEvent<D<C, URNG> > >& events = getSim(iSim);
+            const simEventRange events = getSim(iSim);
             Real portfSimLoss=0.;
             for(Size iEvt=0; iEvt < events.size(); iEvt++) {
                 if(val > static_cast<Date::serial_type>(
@@ -556,8 +823,9 @@ namespace QuantLib {
         std::vector<Real> rankLosses;
         Date today = Settings::instance().evaluationDate();
         Date::serial_type val = d.serialNumber() - today.serialNumber();
-        for(Size iSim=0; iSim < nSims_; iSim++) {
-            const std::vector<simEvent<D<C, URNG> > >& events = getSim(iSim);
+        Size h = horizonIndex(d);
+        if(h == Null<Size>()) for(Size iSim=0; iSim < nSims_; iSim++) {
+            const simEventRange events = getSim(iSim);
             Real portfSimLoss=0.;
             for(Size iEvt=0; iEvt < events.size(); iEvt++) {
                 if(val > static_cast<Date::serial_type>(
@@ -578,8 +846,15 @@ namespace QuantLib {
         }
 
         std::sort(rankLosses.begin(), rankLosses.end());
+        // loss of a given rank, estimated if the losses were not stored
+        auto rankLoss = [&](Size rank) -> Real {
+            if(h == Null<Size>()) return rankLosses[rank];
+            const TDigestStatistics& losses = horizonStats_[h].trancheLosses;
+            return rank == 0 ? losses.min() :
+                losses.percentile(static_cast<Real>(rank) / nSims_);
+        };
         Size quantilePosition = static_cast<Size>(floor(nSims_*percentile));
-        Real quantileValue = rankLosses[quantilePosition];
+        Real quantileValue = rankLoss(quantilePosition);
 
         // compute confidence interval:
         const Probability confInterval = 0.95;// as an argument?
@@ -618,8 +893,8 @@ namespace QuantLib {
             s++;
             s = std::min(nSims_-1, s);
         }
-        lowerPercentile = rankLosses[r];
-        upperPercentile = rankLosses[s];
+        lowerPercentile = rankLoss(r);
+        upperPercentile = rankLoss(s);
 
         return std::tuple<Real, Real, Real>(quantileValue,
             lowerPercentile, upperPercentile);
@@ -649,6 +924,7 @@ namespace QuantLib {
         /* Check 'loss' value integrity: i.e. is within tranche limits? (should
             have been done basket...)*/
         calculate();
+        requireEvents();
 
         Real attachAmount = basket_->attachmentAmount();
         Real detachAmount = basket_->detachmentAmount();
@@ -661,10 +937,10 @@ namespace QuantLib {
         Date::serial_type val = date.serialNumber() - today.serialNumber();
 
         for(Size iSim=0; iSim < nSims_; iSim++) {
-            const std::vector<simEvent<D<C, URNG> > >& events = getSim(iSim);
+            const simEventRange events = getSim(iSim);
             Real portfSimLoss=0.;
             //std::vector<Real> splitBuffer(numLiveNames_, 0.);
-            std::vector<simEvent<D<C, URNG> > > splitEventsBuffer;
+            std::vector<simEvent_type> splitEventsBuffer;
 
             for(Size iEvt=0; iEvt < events.size(); iEvt++) {
                 if(val > static_cast<Date::serial_type>(
@@ -830,10 +1106,11 @@ namespace QuantLib {
             const std::vector<Real>& recoveries = std::vector<Real>(),
             Size nSims = 0,// stats will crash on div by zero, FIX ME.
             Real accuracy = 1.e-6,
-            BigNatural seed = 2863311530)
+            BigNatural seed = 2863311530,
+            Size threads = 1)
         : RandomLM< ::QuantLib::RandomDefaultLM, copulaPolicy, USNG>
             (model->numFactors(), model->size(), model->copula(),
-                nSims, seed ),
+                nSims, seed, threads),
           model_(model),
           recoveries_(recoveries.size()==0 ? std::vector<Real>(model->size(),
             0.) : recoveries),
@@ -848,10 +1125,11 @@ namespace QuantLib {
                 model,
             Size nSims = 0,// stats will crash on div by zero, FIX ME.
             Real accuracy = 1.e-6,
-            BigNatural seed = 2863311530)
+            BigNatural seed = 2863311530,
+            Size threads = 1)
         : RandomLM< ::QuantLib::RandomDefaultLM, copulaPolicy, USNG>
             (model->numFactors(), model->size(), model->copula(),
-                nSims, seed ),
+                nSims, seed, threads),
           model_(model),
           recoveries_(model->recoveries()),
           accuracy_(accuracy)
@@ -874,7 +1152,8 @@ namespace QuantLib {
         */
         friend class RandomLM< ::QuantLib::RandomDefaultLM, copulaPolicy, USNG>;
     protected:
-        void nextSample(const std::vector<Real>& values) const;
+        void nextSample(const std::vector<Real>& values,
+            std::vector<defaultSimEvent>& events) const;
         void initDates() const {
             /* Precalculate horizon time default probabilities (used to
               determine if the default took place and subsequently compute its
@@ -933,11 +1212,10 @@ namespace QuantLib {
 
     template<class C, class URNG>
     void RandomDefaultLM<C, URNG>::nextSample(
-        const std::vector<Real>& values) const
+        const std::vector<Real>& values,
+        std::vector<defaultSimEvent>& events) const
     {
         const std::shared_ptr<Pool>& pool = this->basket_->pool();
-        // starts with no events
-        this->simsBuffer_.emplace_back(std::vector<defaultSimEvent> ());
 
         for(Size iName=0; iName<model_->size(); iName++) {
             Real latentVarSample =
@@ -965,8 +1243,7 @@ namespace QuantLib {
                                         std::log(1.-simDefaultProb)
                     /std::log(1.-data_.horizonDefaultPs_[iName])));
                    */
-                this->simsBuffer_.back().emplace_back(defaultSimEvent(iName,
-                    dateSTride));
+                events.emplace_back(defaultSimEvent(iName, dateSTride));
                //emplace_back
             }
         /* Used to remove sims with no events. Uses less memory, faster
@@ -83,10 +83,11 @@ namespace QuantLib {
                 copula,
             Size nSims = 0,
             Real accuracy = 1.e-6, 
-            BigNatural seed = 2863311530)
+            BigNatural seed = 2863311530,
+            Size threads = 1)
         : RandomLM< ::QuantLib::RandomLossLM, copulaPolicy, USNG>
             (copula->numFactors(), copula->size(), copula->copula(), 
-                nSims, seed),
+                nSims, seed, threads),
           copula_(copula), accuracy_(accuracy)
     {
         // redundant through basket?
@@ -102,7 +103,8 @@ namespace QuantLib {
         */
         friend class RandomLM< ::QuantLib::RandomLossLM, copulaPolicy, USNG>;
     protected:
-        void nextSample(const std::vector<Real>& values) const;
+        void nextSample(const std::vector<Real>& values,
+            std::vector<defaultSimEvent>& events) const;
 
         // see note on randomdefaultlatentmodel
         void initDates() const {
@@ -155,10 +157,10 @@ namespace QuantLib {
 
     template<class C, class URNG>
     void RandomLossLM<C, URNG>::nextSample(
-        const std::vector<Real>& values) const 
+        const std::vector<Real>& values,
+        std::vector<defaultSimEvent>& events) const 
     {
         const std::shared_ptr<Pool>& pool = this->basket_->pool();
-        this->simsBuffer_.emplace_back(std::vector<defaultSimEvent> ());
 
         // half the model is defaults, the other half are RRs...
         for(Size iName=0; iName<copula_->size()/2; iName++) {
@@ -212,7 +214,7 @@ namespace QuantLib {
                 Real recovery = 
                     copula_->conditionalRecovery(latentRRVarSample,
                         iName, eventDate);
-                this->simsBuffer_.back().emplace_back(
+                events.emplace_back(
                   defaultSimEvent(iName, dateSTride, recovery));
                 //emplace_back
             }
@@ -221,10 +223,6 @@ namespace QuantLib {
         default probability, otherwise is more expensive and sim access has 
         to be modified. However low probability is also an indicator that 
         variance reduction is needed. */
-        //if(simsBuffer.back().empty()) {
-        //    emptySims_++;// Size; intilzd to zero
-        //    simsBuffer.pop_back();
-        //}
         }
     }
 
@@ -63,7 +63,7 @@ namespace QuantLib {
 
         class LessButNotCloseEnough {
           public:
-            bool operator()(Real a, Real b) {
+            bool operator()(Real a, Real b) const {
                 return !(close_enough(a, b, 100) || b < a);
             }
         };
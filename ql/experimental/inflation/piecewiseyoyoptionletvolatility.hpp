@@ -219,6 +219,7 @@ namespace QuantLib {
 
     template <class I, template <class> class B, class T>
     void PiecewiseYoYOptionletVolatilityCurve<I,B,T>::update() {
+        bootstrap_.curveUpdated();
         base_curve::update();
         LazyObject::update();
     }
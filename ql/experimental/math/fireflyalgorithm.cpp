@@ -29,15 +29,18 @@ namespace QuantLib {
         std::shared_ptr<Intensity> intensity,
         std::shared_ptr<RandomWalk> randomWalk,
         Size Mde, Real mutation,
-        Real crossover, unsigned long seed):
+        Real crossover, unsigned long seed, Size threads,
+        bool synchronousDE):
         mutation_(mutation), crossover_(crossover),
-        M_(M), Mde_(Mde), Mfa_(M_-Mde_), 
+        M_(M), Mde_(Mde), Mfa_(M_-Mde_), threads_(threads),
+        synchronousDE_(synchronousDE),
         intensity_(intensity),
         randomWalk_(randomWalk),
         drawIndex_(base_generator_type(seed), uniform_integer(Mfa_, Mde > 0 ? M_-1 : M_)),
         rng_(seed){
         QL_REQUIRE(M_ >= Mde_,
             "Differential Evolution subpopulation cannot be larger than total population");
+        QL_REQUIRE(threads_ > 0, "Positive number of threads required");
     }
 
     void FireflyAlgorithm::startState(Problem &P, const EndCriteria &endCriteria) {
@@ -64,8 +67,12 @@ namespace QuantLib {
                 //Assign X=lb+(ub-lb)*random
                 x[j] = lX_[j] + bounds[j] * sample[j];
             }
-            //Evaluate point
-            values_.emplace_back(std::make_pair(P.value(x), i));
+        }
+
+        //Evaluate points
+        Array values = P.value(x_, threads_);
+        for (Size i = 0; i < M_; i++) {
+            values_.emplace_back(std::make_pair(values[i], i));
         }
 
         //init intensity & randomWalk
@@ -87,6 +94,8 @@ namespace QuantLib {
         bool isFA = Mfa_ > 0 ? true : false;
         //Variables for DE
         Array z(N_, 0.0);
+        std::vector<Array> trials;
+        std::vector<Size> trialIndices;
         Size indexR1, indexR2;
         uniform_integer::param_type nParam(0, N_ );
 
@@ -115,6 +124,8 @@ namespace QuantLib {
 
             //Differential evolution
             if(Mfa_ < M_){
+                trials.clear();
+                trialIndices.clear();
                 Size indexBest = values_[0].second;
                 Array& xBest = x_[indexBest];
                 for (Size i = Mfa_; i < M_; i++) { 
@@ -150,6 +161,12 @@ namespace QuantLib {
                             z[j] = uX_[j];
                         }
                     }
+                    if (synchronousDE_) {
+                        //Evaluate later, together with the other trials
+                        trials.push_back(z);
+                        trialIndices.push_back(index);
+                        continue;
+                    }
                     Real val = P.value(z);
                     if (val < values_[index].first) {
                         //Accept new point
@@ -163,6 +180,21 @@ namespace QuantLib {
                         }
                     }
                 }
+                Array vals = P.value(trials, threads_);
+                for (Size i = 0; i < trials.size(); i++) {
+                    Size index = trialIndices[i];
+                    if (vals[i] < values_[index].first) {
+                        //Accept new point
+                        x_[index] = trials[i];
+                        values_[index].first = vals[i];
+                        //mark best
+                        if (vals[i] < bestValue) {
+                            bestValue = vals[i];
+                            bestX = trials[i];
+                            iterationStat = 0;
+                        }
+                    }
+                }
             }
                 
             //Firefly algorithm
@@ -173,30 +205,38 @@ namespace QuantLib {
                 //Prepare random walk
                 randomWalk_->walk();
 
-                //Loop over particles
+                //Loop over particles; new positions only depend on
+                //the current one, so they can be evaluated together
+                trials.assign(Mfa_, z);
                 for (Size i = 0; i < Mfa_; i++) {
                     Size index = values_[i].second;
-                    Array& x   = x_[index];
-                    Array& xI  = xI_[index];
-                    Array& xRW = xRW_[index];
+                    const Array& x   = x_[index];
+                    const Array& xI  = xI_[index];
+                    const Array& xRW = xRW_[index];
+                    Array& y = trials[i];
 
                     //Loop over dimensions
                     for (Size j = 0; j < N_; j++) {
                         //Update position
-                        z[j] = x[j] + xI[j] + xRW[j];
+                        y[j] = x[j] + xI[j] + xRW[j];
                         //Enforce bounds on positions
-                        if (z[j] < lX_[j]) {
-                            z[j] = lX_[j];
+                        if (y[j] < lX_[j]) {
+                            y[j] = lX_[j];
                         }
-                        else if (z[j] > uX_[j]) {
-                            z[j] = uX_[j];
+                        else if (y[j] > uX_[j]) {
+                            y[j] = uX_[j];
                         }
                     }
-                    Real val = P.value(z);
+                }
+                Array vals = P.value(trials, threads_);
+                for (Size i = 0; i < Mfa_; i++) {
+                    Size index = values_[i].second;
+                    Array& x = x_[index];
+                    Real val = vals[i];
                     if(!std::isnan(val))
 					{
 						//Accept new point
-                        x = z;
+                        x = trials[i];
                         values_[index].first = val;
                         //mark best
                         if (val < bestValue) {
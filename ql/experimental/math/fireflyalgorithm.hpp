@@ -78,6 +78,20 @@ namespace QuantLib {
                     if R_{i,j} > CR X_{i,j}^{k+1}
     Where CR is the crossover constant, and R is a random uniformly distributed
     number
+
+    By default, each DE trial is accepted as soon as it is evaluated,
+    so that it is taken into account by the following ones.  If
+    synchronousDE is true, the DE operator is applied instead to the
+    population as it was at the start of the iteration, and the
+    trials are accepted at the end of it; this allows them to be
+    evaluated together.
+
+    The new positions of each iteration can be evaluated on multiple
+    threads as in Problem::value(const std::vector<Array>&, Size);
+    with asynchronous DE, this only applies to the firefly
+    subpopulation.  Random numbers are drawn before the evaluations,
+    so that the results only depend on the seed, not on the number of
+    threads.
     */
     class FireflyAlgorithm : public OptimizationMethod {
       public:
@@ -89,7 +103,8 @@ namespace QuantLib {
             std::shared_ptr<Intensity> intensity,
             std::shared_ptr<RandomWalk> randomWalk,
             Size Mde = 0, Real mutationFactor = 1.0,
-            Real crossoverFactor = 0.5, unsigned long seed = SeedGenerator::instance().get());
+            Real crossoverFactor = 0.5, unsigned long seed = SeedGenerator::instance().get(),
+            Size threads = 1, bool synchronousDE = false);
         void startState(Problem &P, const EndCriteria &endCriteria);
         EndCriteria::Type minimize(Problem &P, const EndCriteria &endCriteria);
 
@@ -98,7 +113,8 @@ namespace QuantLib {
         std::vector<std::pair<Real, Size> > values_;
         Array lX_, uX_;
         Real mutation_, crossover_;
-        Size M_, N_, Mde_, Mfa_;
+        Size M_, N_, Mde_, Mfa_, threads_;
+        bool synchronousDE_;
         std::shared_ptr<Intensity> intensity_;
         std::shared_ptr<RandomWalk> randomWalk_;
         variate_integer drawIndex_;
@@ -63,6 +63,10 @@ namespace QuantLib {
     void operator()(Array & steps, const Array &currentPoint,
     Real aCurrentValue, const Array & currTemp) const;
     \endcode
+
+    The annealing chain itself is sequential, each point being drawn around the
+    last accepted one; the evaluations needed for reannealing can be performed on
+    multiple threads (see ReannealingFiniteDifferences).
     */
     template <class Sampler, class Probability, class Temperature, class Reannealing = ReannealingTrivial>
     class HybridSimulatedAnnealing : public OptimizationMethod {
@@ -408,6 +408,9 @@ namespace QuantLib
     sensitive dimensions, therefore a reannealing schedule might raise the
     temperature seen by those more fruitful dimensions so as to allow for more
     movement along the dimensions of interest
+
+    The bumped points can be evaluated on multiple threads as in
+    Problem::value(const std::vector<Array>&, Size).
     */
     class ReannealingFiniteDifferences {
     public:
@@ -417,11 +420,13 @@ namespace QuantLib
             const Array & upper = Array(),
             Real stepSize = 1e-7,
             Real minSize = 1e-10,
-            Real functionTol = 1e-10)
+            Real functionTol = 1e-10,
+            Size threads = 1)
             : stepSize_(stepSize), minSize_(minSize),
-            functionTol_(functionTol), N_(dimension), bound_(false),
+            functionTol_(functionTol), N_(dimension), threads_(threads), bound_(false),
             lower_(lower), upper_(upper), initialTemp_(dimension, initialTemp),
             bounded_(dimension, 1.0) {
+            QL_REQUIRE(threads_ > 0, "Positive number of threads required");
             if (lower.size() > 0 && upper.size() > 0) {
                 QL_REQUIRE(lower.size() == N_, "Incompatible input");
                 QL_REQUIRE(upper.size() == N_, "Incompatible input");
@@ -439,11 +444,12 @@ namespace QuantLib
 
             Array finiteDiffs(N_, 0.0);
             double finiteDiffMax = 0.0;
-            Array ofssetPoint(currentPoint);
+            std::vector<Array> offsetPoints(N_, currentPoint);
+            for (Size i = 0; i < N_; i++)
+                offsetPoints[i][i] += stepSize_;
+            Array offsetValues = problem_->value(offsetPoints, threads_);
             for (Size i = 0; i < N_; i++) {
-                ofssetPoint[i] += stepSize_;
-                finiteDiffs[i] = bounded_[i] * std::abs((problem_->value(ofssetPoint) - currentValue) / stepSize_);
-                ofssetPoint[i] -= stepSize_;
+                finiteDiffs[i] = bounded_[i] * std::abs((offsetValues[i] - currentValue) / stepSize_);
                 if (finiteDiffs[i] < minSize_)
                     finiteDiffs[i] = minSize_;
                 if (finiteDiffs[i] > finiteDiffMax)
@@ -463,7 +469,7 @@ namespace QuantLib
     private:
         Problem *problem_;
         Real stepSize_, minSize_, functionTol_;
-        Size N_;
+        Size N_, threads_;
         bool bound_;
         Array lower_, upper_, initialTemp_, bounded_;
     };
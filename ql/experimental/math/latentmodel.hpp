@@ -439,6 +439,11 @@ namespace QuantLib {
                     : sequenceGen_(copula.numFactors(), seed), // base case construction
                       x_(std::vector<Real>(copula.numFactors()), 1.0),
                       copula_(copula) {}
+            //! samples the factors from a given sequence generator
+            FactorSampler(const copulaType &copula, const USNG &sequenceGen)
+                    : sequenceGen_(sequenceGen),
+                      x_(std::vector<Real>(copula.numFactors()), 1.0),
+                      copula_(copula) {}
 
             /*! Returns a sample of the factor set \f$ M_k\,Z_i\f$.
             This method has the vocation of being specialized at particular 
@@ -31,10 +31,11 @@ namespace QuantLib {
         std::shared_ptr<Topology> topology,
         std::shared_ptr<Inertia> inertia,
         Real c1, Real c2,
-        unsigned long seed)
-        : M_(M), rng_(seed),
+        unsigned long seed, Size threads)
+        : M_(M), threads_(threads), rng_(seed),
         topology_(topology),
         inertia_(inertia) {
+        QL_REQUIRE(threads_ > 0, "Positive number of threads required");
         Real phi = c1 + c2;
         QL_ENSURE(phi*phi - 4 * phi, "Invalid phi");
         c0_ = 2.0 / std::abs(2.0 - phi - sqrt(phi*phi - 4 * phi));
@@ -46,9 +47,11 @@ namespace QuantLib {
         std::shared_ptr<Topology> topology,
         std::shared_ptr<Inertia> inertia,
         Real omega, Real c1, Real c2,
-        unsigned long seed)
-        : M_(M), c0_(omega), c1_(c1), c2_(c2), rng_(seed),
-        topology_(topology), inertia_(inertia) {}
+        unsigned long seed, Size threads)
+        : M_(M), threads_(threads), c0_(omega), c1_(c1), c2_(c2), rng_(seed),
+        topology_(topology), inertia_(inertia) {
+        QL_REQUIRE(threads_ > 0, "Positive number of threads required");
+    }
 
     void ParticleSwarmOptimization::startState(Problem &P, const EndCriteria &endCriteria) {
         QL_REQUIRE(topology_, "Invalid topology");
@@ -59,7 +62,6 @@ namespace QuantLib {
         X_.reserve(M_);
         V_.reserve(M_);
         pBX_.reserve(M_);
-        pBF_ = Array(M_);
         gBX_.reserve(M_);
         gBF_ = Array(M_);
         uX_ = P.constraint().upperBound(P.currentValue());
@@ -83,10 +85,11 @@ namespace QuantLib {
                 //Assign V=(ub-lb)*2*random-(ub-lb) -> between (lb-ub) and (ub-lb)
                 v[j] = bounds[j] * (2.0*sample[2 * j + 1] - 1.0);
             }
-            //Evaluate X and assign as personal best
+            //Assign X as personal best
             pBX_.emplace_back(X_.back());
-            pBF_[i] = P.value(X_.back());
         }
+        //Evaluate personal bests
+        pBF_ = P.value(X_, threads_);
 
         //init topology & inertia
         topology_->init(this);
@@ -131,7 +134,7 @@ namespace QuantLib {
             //Loop over particles
             for (Size i = 0; i < M_; i++) {
                 Array& x = X_[i];
-                Array& pB = pBX_[i];
+                const Array& pB = pBX_[i];
                 const Array& gB = gBX_[i];
                 Array& v = V_[i];
 
@@ -151,12 +154,15 @@ namespace QuantLib {
                         v[j] = 0.0;
                     }
                 }
-                //Evaluate x
-                Real f = P.value(x);
+            }
+            //Evaluate new positions
+            Array fX = P.value(X_, threads_);
+            for (Size i = 0; i < M_; i++) {
+                Real f = fX[i];
                 if (f < pBF_[i]) {
                     //Update personal best
                     pBF_[i] = f;
-                    pB = x;
+                    pBX_[i] = X_[i];
                     //Check stationary condition
                     if (f < bestValue) {
                         bestValue = f;
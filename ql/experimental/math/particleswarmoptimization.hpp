@@ -85,6 +85,11 @@ namespace QuantLib {
 
     The optimization stops either because the number of iterations has been reached
     or because the stationary function value limit has been reached.
+
+    The new positions of each iteration can be evaluated on multiple threads
+    as in Problem::value(const std::vector<Array>&, Size). Random numbers are
+    drawn before the evaluations, so that the results only depend on the seed
+    and not on the number of threads.
     */
     class ParticleSwarmOptimization : public OptimizationMethod {
       public:
@@ -96,12 +101,14 @@ namespace QuantLib {
             std::shared_ptr<Topology> topology,
             std::shared_ptr<Inertia> inertia,
             Real c1 = 2.05, Real c2 = 2.05,
-            unsigned long seed = SeedGenerator::instance().get());
+            unsigned long seed = SeedGenerator::instance().get(),
+            Size threads = 1);
         explicit ParticleSwarmOptimization(const Size M,
             std::shared_ptr<Topology> topology,
             std::shared_ptr<Inertia> inertia,
             Real omega, Real c1, Real c2,
-            unsigned long seed = SeedGenerator::instance().get());
+            unsigned long seed = SeedGenerator::instance().get(),
+            Size threads = 1);
         void startState(Problem &P, const EndCriteria &endCriteria);
         EndCriteria::Type minimize(Problem &P, const EndCriteria &endCriteria);
 
@@ -109,7 +116,7 @@ namespace QuantLib {
         std::vector<Array> X_, V_, pBX_, gBX_;
         Array pBF_, gBF_;
         Array lX_, uX_;
-        Size M_, N_;
+        Size M_, N_, threads_;
         Real c0_, c1_, c2_;
         MersenneTwisterUniformRng rng_;
         std::shared_ptr<Topology> topology_;
@@ -25,19 +25,47 @@
 #include <ql/termstructures/volatility/equityfx/fixedlocalvolsurface.hpp>
 #include <ql/experimental/models/hestonslvmcmodel.hpp>
 #include <ql/experimental/processes/hestonslvprocess.hpp>
+#include <ql/utilities/parallelfor.hpp>
 
 #include <memory>
 #include <algorithm>
-#if defined(__GNUC__) && (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wunused-local-typedefs"
-#endif
-#include <ql/math/threedimensionalarray.hpp>
-#if defined(__GNUC__) && (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
-#pragma GCC diagnostic pop
-#endif
 
 namespace QuantLib {
+
+    namespace {
+
+        typedef std::vector<std::pair<Real, Real> > state_type;
+
+        /* sorts contiguous chunks on separate threads and merges
+           them pairwise; as the order of equal elements doesn't
+           matter, the result is the same as std::sort's. */
+        void sortState(state_type& x, Size threads) {
+            const Size n = x.size(), chunks = std::min(threads, n);
+            if (chunks <= 1) {
+                std::sort(x.begin(), x.end());
+                return;
+            }
+
+            const auto bound = [&x, n, chunks](Size c) {
+                return x.begin() + c*n/chunks;
+            };
+            parallelFor(chunks, chunks, [&](Size c) {
+                std::sort(bound(c), bound(c+1));
+            });
+            for (Size width=1; width < chunks; width*=2) {
+                const Size merges = (chunks + 2*width - 1)/(2*width);
+                parallelFor(merges, threads, [&](Size i) {
+                    const Size lo = 2*i*width;
+                    const Size mid = std::min(lo + width, chunks);
+                    const Size hi = std::min(lo + 2*width, chunks);
+                    if (mid < hi)
+                        std::inplace_merge(bound(lo), bound(mid), bound(hi));
+                });
+            }
+        }
+
+    }
+
     HestonSLVMCModel::HestonSLVMCModel(
         const Handle<LocalVolTermStructure>& localVol,
         const Handle<HestonModel>& hestonModel,
@@ -46,13 +74,16 @@ namespace QuantLib {
         Size timeStepsPerYear,
         Size nBins,
         Size calibrationPaths,
-        const std::vector<Date>& mandatoryDates)
+        const std::vector<Date>& mandatoryDates,
+        Size threads)
     : localVol_(localVol),
       hestonModel_(hestonModel),
       brownianGeneratorFactory_(brownianGeneratorFactory),
       endDate_(endDate),
       nBins_(nBins),
-      calibrationPaths_(calibrationPaths) {
+      calibrationPaths_(calibrationPaths),
+      threads_(threads) {
+        QL_REQUIRE(threads_ > 0, "positive number of threads required");
 
         registerWith(localVol_);
         registerWith(hestonModel_);
@@ -128,55 +159,61 @@ namespace QuantLib {
         const std::shared_ptr<HestonSLVProcess> slvProcess
             = std::make_shared<HestonSLVProcess>(hestonProcess, leverageFunction_);
 
-        std::vector<std::pair<Real, Real> > pairs(
-                calibrationPaths_, std::make_pair(spot->value(), v0));
+        state_type pairs(calibrationPaths_, std::make_pair(spot->value(), v0));
 
         const Size k = calibrationPaths_ / nBins_;
         const Size m = calibrationPaths_ % nBins_;
 
         const Size timeSteps = timeGrid_->size()-1;
 
-        typedef threeDimensionalArray path_type;
-        path_type paths(calibrationPaths_, timeSteps, 2);
+        // increments stored step by step, so that each step reads
+        // a contiguous block
+        std::vector<Real> dws(2*calibrationPaths_*timeSteps);
 
         const std::shared_ptr<BrownianGenerator> brownianGenerator =
             brownianGeneratorFactory_->create(2, timeSteps);
 
+        std::vector<Real> tmp(2);
         for (Size i=0; i < calibrationPaths_; ++i) {
             brownianGenerator->nextPath();
-            std::vector<Real> tmp(2);
             for (Size j=0; j < timeSteps; ++j) {
                 brownianGenerator->nextStep(tmp);
-                paths(i, j, 0) = tmp[0];
-                paths(i, j, 1) = tmp[1];
+                dws[2*(j*calibrationPaths_ + i)]   = tmp[0];
+                dws[2*(j*calibrationPaths_ + i)+1] = tmp[1];
             }
         }
 
         for (Size n=1; n < timeGrid_->size(); ++n) {
             const Time t = timeGrid_->at(n-1);
             const Time dt = timeGrid_->dt(n-1);
+            const Real* dwn = &dws[2*(n-1)*calibrationPaths_];
 
-            Array x0(2), dw(2);
-
-            for (Size i=0; i < calibrationPaths_; ++i) {
+            const auto evolve = [&](Size i) {
+                Array x0(2), dw(2);
                 x0[0] = pairs[i].first;
                 x0[1] = pairs[i].second;
 
-                dw[0] = paths(i, n-1, 0);
-                dw[1] = paths(i, n-1, 1);
+                dw[0] = dwn[2*i];
+                dw[1] = dwn[2*i+1];
 
                 x0 = slvProcess->evolve(t, x0, dt, dw);
 
                 pairs[i].first = x0[0];
                 pairs[i].second = x0[1];
-            }
+            };
+            // the first path is evolved on this thread, possibly
+            // triggering lazy calculations, and the others in parallel
+            evolve(0);
+            parallelFor(calibrationPaths_-1, threads_, [&](Size i) {
+                evolve(i+1);
+            });
 
-            std::sort(pairs.begin(), pairs.end());
+            sortState(pairs, threads_);
 
-            Size s = 0u, e = 0u;
-            for (Size i=0; i < nBins_; ++i) {
+            parallelFor(nBins_, threads_, [&](Size i) {
                 const Size inc = k + (i < m);
-                e = s + inc;
+                const Size s = i*k + std::min(i, m);
+                const Size e = s + inc;
 
                 Real sum=0.0;
                 for (Size j=s; j < e; ++j) {
@@ -187,9 +224,7 @@ namespace QuantLib {
                 vStrikes[n]->at(i) = 0.5*(pairs[e-1].first + pairs[s].first);
                 (*L)[i][n] = std::sqrt(square(
                      localVol_->localVol(t, vStrikes[n]->at(i), true))/sum);
-
-                s = e;
-            }
+            });
 
             leverageFunction_->setInterpolation<Linear>();
         }
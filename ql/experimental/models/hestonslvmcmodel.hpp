@@ -38,6 +38,18 @@ namespace QuantLib {
         Anthonie W. van der Stoep,Lech A. Grzelak, Cornelis W. Oosterlee, 2013,
         The Heston Stochastic-Local Volatility Model: Efficient Monte Carlo Simulation
         http://papers.ssrn.com/sol3/papers.cfm?abstract_id=2278122
+
+        The propagation of the paths, their sorting and the estimation
+        of the conditional expectations in each bin can be split among
+        multiple threads; the resulting leverage function does not
+        depend on their number.  The Brownian increments are still
+        drawn on a single thread.
+
+        \warning with more than one thread, the Heston process and the
+                 local volatility are used concurrently; any lazy
+                 calculation of the underlying term structures is
+                 triggered beforehand by the first evaluations, which
+                 are performed on the calling thread.
     */
 
     class HestonSLVMCModel : public LazyObject {
@@ -50,7 +62,8 @@ namespace QuantLib {
             Size timeStepsPerYear = 365,
             Size nBins = 201,
             Size calibrationPaths = (1 << 15),
-            const std::vector<Date>& mandatoryDates = std::vector<Date>());
+            const std::vector<Date>& mandatoryDates = std::vector<Date>(),
+            Size threads = 1);
 
         std::shared_ptr<HestonProcess> hestonProcess() const;
         std::shared_ptr<LocalVolTermStructure> localVol() const;
@@ -64,7 +77,7 @@ namespace QuantLib {
         const Handle<HestonModel> hestonModel_;
         const std::shared_ptr<BrownianGeneratorFactory> brownianGeneratorFactory_;
         const Date endDate_;
-        const Size nBins_, calibrationPaths_;
+        const Size nBins_, calibrationPaths_, threads_;
         std::shared_ptr<TimeGrid> timeGrid_;
 
         mutable std::shared_ptr<FixedLocalVolSurface> leverageFunction_;
@@ -61,8 +61,8 @@ namespace QuantLib {
         virtual Real fixing(const Date& fixingDate,
                             bool forecastTodaysFixing = false) const = 0;
         //! returns the fixing TimeSeries
-        const TimeSeries<Real>& timeSeries() const {
-            return IndexManager::instance().getHistory(name());
+        const FixingTimeSeries& timeSeries() const {
+            return IndexManager::instance().getHistory(historyId());
         }
         //! check if index allows for native fixings.
         /*! If this returns false, calls to addFixing and similar
@@ -92,7 +92,7 @@ namespace QuantLib {
                         bool forceOverwrite = false) {
             checkNativeFixingsAllowed();
             std::string tag = name();
-            TimeSeries<Real> h = IndexManager::instance().getHistory(tag);
+            FixingTimeSeries h = IndexManager::instance().getHistory(tag);
             bool noInvalidFixing = true, noDuplicatedFixing = true;
             Date invalidDate, duplicatedDate;
             Real nullValue = Null<Real>();
@@ -132,11 +132,32 @@ namespace QuantLib {
         }
         //! clears all stored historical fixings
         void clearFixings();
+      protected:
+        //! identifier of the fixings in the IndexManager
+        /*! The name of the index is resolved at the first call,
+            which must not happen in a constructor: derived classes
+            might override name().
+        */
+        IndexManager::HistoryId historyId() const;
       private:
         //! check if index allows for native fixings
         void checkNativeFixingsAllowed();
+        mutable IndexManager::HistoryId historyId_;
     };
 
+    // inline definitions
+
+    inline IndexManager::HistoryId Index::historyId() const {
+        #if defined(QL_ENABLE_SESSIONS)
+        // each session has its own manager
+        return IndexManager::instance().historyId(name());
+        #else
+        if (historyId_.empty())
+            historyId_ = IndexManager::instance().historyId(name());
+        return historyId_;
+        #endif
+    }
+
 }
 
 #endif
@@ -2,6 +2,7 @@
 /* Add the files to be included into Makefile.am instead. */
 
 #include <ql/indexes/bmaindex.hpp>
+#include <ql/indexes/fixingsloader.hpp>
 #include <ql/indexes/iborindex.hpp>
 #include <ql/indexes/indexmanager.hpp>
 #include <ql/indexes/inflationindex.hpp>
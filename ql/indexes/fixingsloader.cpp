@@ -0,0 +1,290 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/indexes/fixingsloader.hpp>
+#include <ql/utilities/dataparsers.hpp>
+#include <ql/utilities/stringutils.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define QL_FIXINGS_LOADER_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using std::string;
+
+namespace QuantLib {
+
+    namespace {
+
+        /* Layout of the binary file, in native byte order:
+
+           magic           8 bytes
+           version         uint32
+           index count     uint32
+           for each index:
+             name length   uint32
+             name          name-length bytes
+             first serial  int32
+             day count     uint32
+             fixings       day-count doubles, NaN for missing days
+        */
+        const char magic[8] = { 'Q', 'L', 'F', 'I', 'X', 'B', 'I', 'N' };
+        const std::uint32_t version = 1;
+
+        // the slots are moved into the series with no copy
+        FixingTimeSeries denseSeries(Date::serial_type first,
+                                     std::vector<Real>&& slots) {
+            DenseDateMap<Real> values;
+            values.assign(Date(first), std::move(slots));
+            return FixingTimeSeries(std::move(values));
+        }
+
+        string trimmed(const string& s) {
+            string::size_type first = s.find_first_not_of(" \t\r");
+            if (first == string::npos)
+                return string();
+            string::size_type last = s.find_last_not_of(" \t\r");
+            return s.substr(first, last - first + 1);
+        }
+
+        class BinaryReader {
+          public:
+            BinaryReader(const char* begin, const char* end,
+                         const string& fileName)
+            : current_(begin), end_(end), fileName_(fileName) {}
+            template <class T>
+            T read() {
+                T x;
+                readBytes(&x, sizeof(T));
+                return x;
+            }
+            void readValues(std::vector<double>& out) {
+                readBytes(out.data(), out.size() * sizeof(double));
+            }
+            template <class T>
+            void readValues(std::vector<T>& out) {
+                for (T& x : out)
+                    x = read<double>();
+            }
+            void readBytes(void* out, std::size_t n) {
+                QL_REQUIRE(std::size_t(end_ - current_) >= n,
+                           "unexpected end of fixings file " << fileName_);
+                std::memcpy(out, current_, n);
+                current_ += n;
+            }
+            bool atEnd() const { return current_ == end_; }
+          private:
+            const char* current_;
+            const char* end_;
+            const string& fileName_;
+        };
+
+        Size loadFixings(const char* begin, const char* end,
+                         const string& fileName) {
+            BinaryReader reader(begin, end, fileName);
+            char header[sizeof(magic)];
+            reader.readBytes(header, sizeof(magic));
+            QL_REQUIRE(std::memcmp(header, magic, sizeof(magic)) == 0,
+                       fileName << " is not a fixings file");
+            std::uint32_t fileVersion = reader.read<std::uint32_t>();
+            QL_REQUIRE(fileVersion == version,
+                       "unsupported version " << fileVersion
+                       << " of fixings file " << fileName);
+
+            std::uint32_t indexes = reader.read<std::uint32_t>();
+            for (std::uint32_t i=0; i<indexes; ++i) {
+                string name(reader.read<std::uint32_t>(), '\0');
+                reader.readBytes(&name[0], name.size());
+                Date::serial_type first = reader.read<std::int32_t>();
+                std::uint32_t days = reader.read<std::uint32_t>();
+                QL_REQUIRE(days <= std::numeric_limits<std::size_t>::max()
+                                   / sizeof(double),
+                           "invalid size in fixings file " << fileName);
+                std::vector<Real> slots(days);
+                reader.readValues(slots);
+                IndexManager::instance().setHistory(
+                    name, denseSeries(first, std::move(slots)));
+            }
+            QL_REQUIRE(reader.atEnd(),
+                       "unexpected data at the end of fixings file "
+                       << fileName);
+            return indexes;
+        }
+
+        #ifdef QL_FIXINGS_LOADER_MMAP
+        class MappedFile {
+          public:
+            explicit MappedFile(const string& fileName)
+            : fd_(-1), data_(nullptr), size_(0) {
+                fd_ = ::open(fileName.c_str(), O_RDONLY);
+                QL_REQUIRE(fd_ != -1, "cannot open " << fileName);
+                struct stat info;
+                QL_REQUIRE(::fstat(fd_, &info) == 0,
+                           "cannot read the size of " << fileName);
+                size_ = info.st_size;
+                if (size_ > 0) {
+                    void* data =
+                        ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+                    QL_REQUIRE(data != MAP_FAILED,
+                               "cannot map " << fileName << " in memory");
+                    data_ = static_cast<const char*>(data);
+                }
+            }
+            ~MappedFile() {
+                if (data_ != nullptr)
+                    ::munmap(const_cast<char*>(data_), size_);
+                if (fd_ != -1)
+                    ::close(fd_);
+            }
+            MappedFile(const MappedFile&) = delete;
+            MappedFile& operator=(const MappedFile&) = delete;
+            const char* begin() const { return data_; }
+            const char* end() const { return data_ + size_; }
+          private:
+            int fd_;
+            const char* data_;
+            std::size_t size_;
+        };
+        #endif
+
+    }
+
+    Size loadFixingsFromCsv(const string& fileName) {
+        std::ifstream file(fileName.c_str());
+        QL_REQUIRE(file.is_open(), "cannot open " << fileName);
+
+        // fixings are collected by index before being stored
+        typedef std::vector<std::pair<Date::serial_type, Real> > data;
+        std::map<string, data> fixings;
+        string line;
+        Size lineNumber = 0;
+        while (std::getline(file, line)) {
+            ++lineNumber;
+            line = trimmed(line);
+            if (line.empty() || line[0] == '#')
+                continue;
+            string::size_type first = line.find(',');
+            string::size_type second =
+                first == string::npos ? first : line.find(',', first + 1);
+            QL_REQUIRE(second != string::npos,
+                       "invalid fixing at line " << lineNumber << " of "
+                       << fileName << ": three fields expected");
+            string name = trimmed(line.substr(0, first));
+            string date = trimmed(line.substr(first + 1, second - first - 1));
+            string value = trimmed(line.substr(second + 1));
+            QL_REQUIRE(!name.empty(),
+                       "missing index name at line " << lineNumber << " of "
+                       << fileName);
+
+            Date d;
+            try {
+                d = DateParser::parseISO(date);
+            } catch (std::exception& e) {
+                QL_FAIL("invalid date at line " << lineNumber << " of "
+                        << fileName << ": " << e.what());
+            }
+            char* valueEnd;
+            Real fixing = std::strtod(value.c_str(), &valueEnd);
+            QL_REQUIRE(!value.empty() && *valueEnd == '\0',
+                       "invalid fixing at line " << lineNumber << " of "
+                       << fileName << ": " << value);
+            fixings[to_upper_copy(name)].emplace_back(d.serialNumber(),
+                                                      fixing);
+        }
+
+        for (std::map<string, data>::const_iterator i = fixings.begin();
+             i != fixings.end(); ++i) {
+            Date::serial_type first = i->second.front().first;
+            Date::serial_type last = first;
+            for (data::const_iterator j = i->second.begin();
+                 j != i->second.end(); ++j) {
+                first = std::min(first, j->first);
+                last = std::max(last, j->first);
+            }
+            std::vector<Real> slots(last - first + 1,
+                                    std::numeric_limits<Real>::quiet_NaN());
+            for (data::const_iterator j = i->second.begin();
+                 j != i->second.end(); ++j)
+                slots[j->first - first] = j->second;
+            IndexManager::instance().setHistory(
+                i->first, denseSeries(first, std::move(slots)));
+        }
+        return fixings.size();
+    }
+
+    Size loadFixingsFromBinary(const string& fileName, bool memoryMapped) {
+        #ifdef QL_FIXINGS_LOADER_MMAP
+        if (memoryMapped) {
+            MappedFile file(fileName);
+            return loadFixings(file.begin(), file.end(), fileName);
+        }
+        #endif
+        std::ifstream file(fileName.c_str(), std::ios::binary);
+        QL_REQUIRE(file.is_open(), "cannot open " << fileName);
+        std::vector<char> buffer((std::istreambuf_iterator<char>(file)),
+                                 std::istreambuf_iterator<char>());
+        return loadFixings(buffer.data(), buffer.data() + buffer.size(),
+                           fileName);
+    }
+
+    void saveFixingsToBinary(const string& fileName) {
+        std::ofstream file(fileName.c_str(), std::ios::binary);
+        QL_REQUIRE(file.is_open(), "cannot open " << fileName);
+
+        std::vector<string> names = IndexManager::instance().histories();
+        file.write(magic, sizeof(magic));
+        file.write(reinterpret_cast<const char*>(&version), sizeof(version));
+        std::uint32_t indexes = names.size();
+        file.write(reinterpret_cast<const char*>(&indexes), sizeof(indexes));
+
+        std::vector<double> slots;
+        for (Size i=0; i<names.size(); ++i) {
+            const FixingTimeSeries& history =
+                IndexManager::instance().getHistory(names[i]);
+            std::uint32_t length = names[i].size();
+            file.write(reinterpret_cast<const char*>(&length),
+                       sizeof(length));
+            file.write(names[i].data(), length);
+
+            std::int32_t first = history.firstDate().serialNumber();
+            std::uint32_t days =
+                history.lastDate().serialNumber() - first + 1;
+            slots.assign(days, std::numeric_limits<double>::quiet_NaN());
+            for (FixingTimeSeries::const_iterator j = history.begin();
+                 j != history.end(); ++j)
+                slots[j->first.serialNumber() - first] = j->second;
+            file.write(reinterpret_cast<const char*>(&first), sizeof(first));
+            file.write(reinterpret_cast<const char*>(&days), sizeof(days));
+            file.write(reinterpret_cast<const char*>(slots.data()),
+                       days * sizeof(double));
+        }
+        QL_REQUIRE(file.good(), "error while writing " << fileName);
+    }
+
+}
@@ -0,0 +1,72 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fixingsloader.hpp
+    \brief bulk loading of past index fixings
+*/
+
+#ifndef quantlib_fixings_loader_hpp
+#define quantlib_fixings_loader_hpp
+
+#include <ql/indexes/indexmanager.hpp>
+
+namespace QuantLib {
+
+    /*! The functions below store in the IndexManager the fixings of
+        several indexes at once.  The fixings of each index are
+        collected into a single FixingTimeSeries before being stored,
+        so that observers are notified once per index; the fixings
+        already stored for the indexes in the file are replaced.
+        Unlike Index::addFixings(), no check is made on the validity
+        of the fixing dates.
+
+        The functions return the number of indexes whose fixings were
+        loaded.
+    */
+
+    //! loads fixings from a CSV file
+    /*! Each line holds the name of an index, a date in ISO format
+        (yyyy-mm-dd) and a fixing, separated by commas, as in
+        <tt>EURIBOR6M Actual/360,2024-01-15,0.0391</tt>.  Empty lines
+        and lines starting with '#' are skipped; if the same date is
+        given twice for an index, the last fixing is kept.
+    */
+    Size loadFixingsFromCsv(const std::string& fileName);
+
+    //! loads fixings from a binary file written by saveFixingsToBinary()
+    /*! The file stores the fixings of each index as a contiguous
+        block of daily values, which are copied with no parsing into
+        the storage of the new series.  If memoryMapped is true, the
+        file is mapped in memory and the values are copied from the
+        mapping, instead of being read into an intermediate buffer
+        first; this is only supported on POSIX systems, and the flag
+        is ignored elsewhere.
+
+        \warning the format uses the native byte order and is not
+                 portable across platforms with different endianness.
+    */
+    Size loadFixingsFromBinary(const std::string& fileName,
+                               bool memoryMapped = false);
+
+    //! saves all the fixings stored in the IndexManager to a binary file
+    /*! \relates loadFixingsFromBinary */
+    void saveFixingsToBinary(const std::string& fileName);
+
+}
+
+
+#endif
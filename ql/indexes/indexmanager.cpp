@@ -31,20 +31,31 @@ using std::string;
 
 namespace QuantLib {
 
+    IndexManager::HistoryId
+    IndexManager::historyId(const string& name) const {
+        return HistoryId(&data_[to_upper_copy(name)]);
+    }
+
     bool IndexManager::hasHistory(const string& name) const {
-        return data_.find(to_upper_copy(name)) != data_.end();
+        history_map::const_iterator i = data_.find(to_upper_copy(name));
+        return i != data_.end() && !i->second.value().empty();
     }
 
-    const TimeSeries<Real>&
+    const FixingTimeSeries&
     IndexManager::getHistory(const string& name) const {
         return data_[to_upper_copy(name)].value();
     }
 
     void IndexManager::setHistory(const string& name,
-                                  const TimeSeries<Real>& history) {
+                                  const FixingTimeSeries& history) {
         data_[to_upper_copy(name)] = history;
     }
 
+    void IndexManager::setHistory(const string& name,
+                                  FixingTimeSeries&& history) {
+        data_[to_upper_copy(name)] = std::move(history);
+    }
+
     std::shared_ptr<Observable>
     IndexManager::notifier(const string& name) const {
         return data_[to_upper_copy(name)];
@@ -55,16 +66,21 @@ namespace QuantLib {
         temp.reserve(data_.size());
         for (history_map::const_iterator i=data_.begin();
              i!=data_.end(); ++i)
-            temp.emplace_back(i->first);
+            if (!i->second.value().empty())
+                temp.emplace_back(i->first);
         return temp;
     }
 
     void IndexManager::clearHistory(const string& name) {
-        data_.erase(to_upper_copy(name));
+        history_map::iterator i = data_.find(to_upper_copy(name));
+        if (i != data_.end() && !i->second.value().empty())
+            i->second = FixingTimeSeries();
     }
 
     void IndexManager::clearHistories() {
-        data_.clear();
+        for (history_map::iterator i=data_.begin(); i!=data_.end(); ++i)
+            if (!i->second.value().empty())
+                i->second = FixingTimeSeries();
     }
 
 }
@@ -25,25 +25,58 @@
 #define quantlib_index_manager_hpp
 
 #include <ql/timeseries.hpp>
+#include <ql/utilities/densedatemap.hpp>
 #include <ql/patterns/singleton.hpp>
 #include <ql/utilities/observablevalue.hpp>
 
 
 namespace QuantLib {
 
+    //! time series of index fixings, stored contiguously by date
+    typedef TimeSeries<Real, DenseDateMap<Real> > FixingTimeSeries;
+
     //! global repository for past index fixings
-    /*! \note index names are case insensitive */
+    /*! Fixings can be looked up by index name or, more efficiently,
+        through a HistoryId resolving the name once.  Fixings are
+        stored in a FixingTimeSeries, so that they take one Real per
+        day between the first and the last one and can be looked up
+        in constant time.
+
+        \note index names are case insensitive
+    */
     class IndexManager : public Singleton<IndexManager> {
         friend class Singleton<IndexManager>;
       private:
+        typedef ObservableValue<FixingTimeSeries> history;
         IndexManager() {}
       public:
+        //! pre-resolved reference to the fixings of an index
+        /*! It remains valid, and refers to the same index, for the
+            lifetime of the manager, even if the fixings are cleared
+            or replaced.
+        */
+        class HistoryId {
+          public:
+            HistoryId() : history_(nullptr) {}
+            bool empty() const { return history_ == nullptr; }
+          private:
+            friend class IndexManager;
+            explicit HistoryId(const history* h) : history_(h) {}
+            const history* history_;
+        };
+        //! returns the identifier of the fixings of the index
+        /*! The name is registered if it wasn't already. */
+        HistoryId historyId(const std::string& name) const;
         //! returns whether historical fixings were stored for the index
         bool hasHistory(const std::string& name) const;
         //! returns the (possibly empty) history of the index fixings
-        const TimeSeries<Real>& getHistory(const std::string& name) const;
+        const FixingTimeSeries& getHistory(const std::string& name) const;
+        //! returns the history of the index fixings without name lookup
+        const FixingTimeSeries& getHistory(HistoryId id) const;
         //! stores the historical fixings of the index
-        void setHistory(const std::string& name, const TimeSeries<Real>&);
+        /*! Series using other containers are converted. */
+        void setHistory(const std::string& name, const FixingTimeSeries&);
+        void setHistory(const std::string& name, FixingTimeSeries&&);
         //! observer notifying of changes in the index fixings
         std::shared_ptr<Observable> notifier(const std::string& name) const;
         //! returns all names of the indexes for which fixings were stored
@@ -53,11 +86,20 @@ namespace QuantLib {
         //! clears all stored fixings
         void clearHistories();
       private:
-        typedef std::map<std::string, ObservableValue<TimeSeries<Real> > >
-                                                                  history_map;
+        // entries are never removed, so that identifiers and notifiers
+        // stay valid; cleared histories are replaced by empty ones
+        typedef std::map<std::string, history> history_map;
         mutable history_map data_;
     };
 
+    // inline definitions
+
+    inline const FixingTimeSeries&
+    IndexManager::getHistory(IndexManager::HistoryId id) const {
+        QL_REQUIRE(!id.empty(), "null history id");
+        return id.history_->value();
+    }
+
 }
 
 
@@ -81,7 +81,7 @@ namespace QuantLib {
                                     bool /*forecastTodaysFixing*/) const {
         if (!needsForecast(aFixingDate)) {
             std::pair<Date,Date> lim = inflationPeriod(aFixingDate, frequency_);
-            const TimeSeries<Real>& ts = timeSeries();
+            const FixingTimeSeries& ts = timeSeries();
             Real pastFixing = ts[lim.first];
             QL_REQUIRE(pastFixing != Null<Real>(),
                        "Missing " << name() << " fixing for " << lim.first);
@@ -228,7 +228,7 @@ namespace QuantLib {
 
         // four cases with ratio() and interpolated()
 
-        const TimeSeries<Real>& ts = timeSeries();
+        const FixingTimeSeries& ts = timeSeries();
         if (ratio()) {
 
             if(interpolated()){ // IS ratio, IS interpolated
@@ -255,8 +255,7 @@ namespace QuantLib {
                 QL_REQUIRE(limBefFirstFix != Null<Rate>(),
                             "Missing " << name() << " fixing for "
                             << limBef.first );
-                Rate limBefSecondFix =
-                IndexManager::instance().getHistory(name())[limBef.second+1];
+                Rate limBefSecondFix = ts[limBef.second+1];
                 QL_REQUIRE(limBefSecondFix != Null<Rate>(),
                             "Missing " << name() << " fixing for "
                             << limBef.second+1 );
@@ -523,24 +523,6 @@ namespace QuantLib {
         return result;
     }
 
-    inline Matrix operator*(const Matrix& m1,
-        const Matrix& m2) {
-        QL_REQUIRE(m1.columns() == m2.rows(),
-            "matrices with different sizes (" <<
-            m1.rows() << "x" << m1.columns() << ", " <<
-            m2.rows() << "x" << m2.columns() << ") cannot be "
-            "multiplied");
-        Matrix result(m1.rows(), m2.columns(), 0.0);
-        for (Size i = 0; i < result.rows(); ++i) {
-            for (Size k = 0; k < m1.columns(); ++k) {
-                for (Size j = 0; j < result.columns(); ++j) {
-                    result[i][j] += m1[i][k] * m2[k][j];
-                }
-            }
-        }
-        return result;
-    }
-
     inline Matrix transpose(const Matrix& m) {
         Matrix result(m.columns(), m.rows());
 #if defined(QL_PATCH_MSVC) && defined(QL_DEBUG)
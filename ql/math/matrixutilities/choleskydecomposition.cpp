@@ -19,7 +19,7 @@
 */
 
 #include <ql/math/matrixutilities/choleskydecomposition.hpp>
-#include <ql/math/comparison.hpp>
+#include <ql/math/matrixutilities/denselinearalgebra.hpp>
 
 namespace QuantLib {
 
@@ -36,30 +36,13 @@ namespace QuantLib {
                            "input matrix is not symmetric");
         #endif
 
-        Matrix result(size, size, 0.0);
-        Real sum;
-        for (i=0; i<size; i++) {
-            for (j=i; j<size; j++) {
-                sum = S[i][j];
-                for (Integer k=0; k<=Integer(i)-1; k++) {
-                    sum -= result[i][k]*result[j][k];
-                }
-                if (i == j) {
-                    QL_REQUIRE(flexible || sum > 0.0,
-                               "input matrix is not positive definite");
-                    // To handle positive semi-definite matrices take the
-                    // square root of sum if positive, else zero.
-                    result[i][i] = std::sqrt(std::max<Real>(sum, 0.0));
-                } else {
-                    // With positive semi-definite matrices is possible
-                    // to have result[i][i]==0.0
-                    // In this case sum happens to be zero as well
-                    result[j][i] = close_enough(result[i][i], 0.0)
-                                       ? 0.0
-                                       : sum / result[i][i];
-                }
-            }
-        }
+        // the upper triangle of S is used, while the factorization
+        // reads the lower one
+        Matrix result(size, size);
+        for (i=0; i<size; i++)
+            for (j=i; j<size; j++)
+                result[j][i] = S[i][j];
+        choleskyFactorization(result, flexible);
         return result;
     }
 
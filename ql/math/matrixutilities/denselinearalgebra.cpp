@@ -0,0 +1,435 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/matrixutilities/denselinearalgebra.hpp>
+#include <ql/math/comparison.hpp>
+#include <ql/utilities/parallelfor.hpp>
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+#if defined(QL_USE_MKL)
+#include <mkl.h>
+#define QL_DENSE_LINEAR_ALGEBRA_BACKEND
+#elif defined(QL_USE_CBLAS)
+#include <cblas.h>
+#include <lapacke.h>
+#define QL_DENSE_LINEAR_ALGEBRA_BACKEND
+#endif
+
+namespace QuantLib {
+
+    namespace {
+
+        #if defined(QL_DENSE_LINEAR_ALGEBRA_BACKEND)
+        static_assert(std::is_same<Real, double>::value,
+                      "the CBLAS/LAPACKE backend requires Real to be double");
+        #endif
+
+        // size of the register tile computed by the micro-kernel
+        const Size mr = 4, nr = 8;
+        // size of the blocks of the operands kept in cache
+        const Size mc = 64, kc = 256, nc = 512;
+        // size of the panels of the decompositions
+        const Size nb = 64;
+        // below these numbers of multiply-adds, the product is
+        // computed directly or on a single thread, respectively
+        const Size blockedThreshold = 32*32*32;
+        const Size parallelThreshold = 128*128*128;
+
+        // copies a block of a into panels of mr rows, column by
+        // column, padding the last panel with zeros
+        void packA(Size m, Size k, const Real* a, Size lda, Real* out) {
+            for (Size i=0; i<m; i+=mr) {
+                const Size rows = std::min(mr, m-i);
+                for (Size p=0; p<k; ++p) {
+                    for (Size r=0; r<rows; ++r)
+                        out[r] = a[(i+r)*lda+p];
+                    for (Size r=rows; r<mr; ++r)
+                        out[r] = 0.0;
+                    out += mr;
+                }
+            }
+        }
+
+        // copies a block of b into panels of nr columns, row by row,
+        // padding the last panel with zeros
+        void packB(Size k, Size n, const Real* b, Size ldb, Real* out) {
+            for (Size j=0; j<n; j+=nr) {
+                const Size cols = std::min(nr, n-j);
+                for (Size p=0; p<k; ++p) {
+                    const Real* row = b + p*ldb + j;
+                    for (Size c=0; c<cols; ++c)
+                        out[c] = row[c];
+                    for (Size c=cols; c<nr; ++c)
+                        out[c] = 0.0;
+                    out += nr;
+                }
+            }
+        }
+
+        // c += alpha a b for an mr x nr tile of c; the accumulators are
+        // kept in registers and only the given rows and columns of c
+        // are written back
+        void microKernel(Size k, Real alpha,
+                         const Real* a, const Real* b,
+                         Real* c, Size ldc, Size rows, Size cols) {
+            Real t[mr][nr] = {};
+            for (Size p=0; p<k; ++p) {
+                for (Size r=0; r<mr; ++r)
+                    for (Size s=0; s<nr; ++s)
+                        t[r][s] += a[r]*b[s];
+                a += mr;
+                b += nr;
+            }
+            for (Size r=0; r<rows; ++r)
+                for (Size s=0; s<cols; ++s)
+                    c[r*ldc+s] += alpha*t[r][s];
+        }
+
+        // c += alpha a b on the calling thread; a is m x k, b is k x n
+        // and all matrices are stored by rows with the given strides
+        void gemmSerial(Size m, Size n, Size k, Real alpha,
+                        const Real* a, Size lda,
+                        const Real* b, Size ldb,
+                        Real* c, Size ldc) {
+            if (m*n*k <= blockedThreshold) {
+                for (Size i=0; i<m; ++i) {
+                    Real* ci = c + i*ldc;
+                    for (Size p=0; p<k; ++p) {
+                        const Real aip = alpha*a[i*lda+p];
+                        const Real* bp = b + p*ldb;
+                        for (Size j=0; j<n; ++j)
+                            ci[j] += aip*bp[j];
+                    }
+                }
+                return;
+            }
+
+            const Size ncMax = std::min(nc, (n+nr-1)/nr*nr);
+            std::vector<Real> packedA(mc*kc), packedB(kc*ncMax);
+            for (Size jc=0; jc<n; jc+=nc) {
+                const Size ncb = std::min(nc, n-jc);
+                for (Size pc=0; pc<k; pc+=kc) {
+                    const Size kcb = std::min(kc, k-pc);
+                    packB(kcb, ncb, b + pc*ldb + jc, ldb, &packedB[0]);
+                    for (Size ic=0; ic<m; ic+=mc) {
+                        const Size mcb = std::min(mc, m-ic);
+                        packA(mcb, kcb, a + ic*lda + pc, lda, &packedA[0]);
+                        for (Size jr=0; jr<ncb; jr+=nr) {
+                            for (Size ir=0; ir<mcb; ir+=mr) {
+                                microKernel(kcb, alpha,
+                                            &packedA[ir*kcb],
+                                            &packedB[jr*kcb],
+                                            c + (ic+ir)*ldc + jc + jr, ldc,
+                                            std::min(mr, mcb-ir),
+                                            std::min(nr, ncb-jr));
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        // c += alpha a b, splitting the largest dimension of c among
+        // threads in contiguous chunks of whole register tiles
+        void gemm(Size m, Size n, Size k, Real alpha,
+                  const Real* a, Size lda,
+                  const Real* b, Size ldb,
+                  Real* c, Size ldc, Size threads) {
+            if (m == 0 || n == 0 || k == 0)
+                return;
+            if (threads <= 1 || m*n*k < parallelThreshold) {
+                gemmSerial(m, n, k, alpha, a, lda, b, ldb, c, ldc);
+                return;
+            }
+            if (m >= n) {
+                const Size tiles = (m+mr-1)/mr;
+                const Size workers = std::min(threads, tiles);
+                parallelFor(workers, workers, [&](Size w) {
+                    const Size first = std::min(w*tiles/workers*mr, m);
+                    const Size last = std::min((w+1)*tiles/workers*mr, m);
+                    gemmSerial(last-first, n, k, alpha,
+                               a + first*lda, lda, b, ldb,
+                               c + first*ldc, ldc);
+                });
+            } else {
+                const Size tiles = (n+nr-1)/nr;
+                const Size workers = std::min(threads, tiles);
+                parallelFor(workers, workers, [&](Size w) {
+                    const Size first = std::min(w*tiles/workers*nr, n);
+                    const Size last = std::min((w+1)*tiles/workers*nr, n);
+                    gemmSerial(m, last-first, k, alpha,
+                               a, lda, b + first, ldb,
+                               c + first, ldc);
+                });
+            }
+        }
+
+    }
+
+
+    Matrix matrixProduct(const Matrix& m1, const Matrix& m2, Size threads) {
+        QL_REQUIRE(m1.columns() == m2.rows(),
+            "matrices with different sizes (" <<
+            m1.rows() << "x" << m1.columns() << ", " <<
+            m2.rows() << "x" << m2.columns() << ") cannot be "
+            "multiplied");
+        Matrix result(m1.rows(), m2.columns(), 0.0);
+        if (result.empty() || m1.empty())
+            return result;
+        #if defined(QL_DENSE_LINEAR_ALGEBRA_BACKEND)
+        cblas_dgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans,
+                    m1.rows(), m2.columns(), m1.columns(), 1.0,
+                    &*m1.begin(), m1.columns(),
+                    &*m2.begin(), m2.columns(),
+                    0.0, &*result.begin(), result.columns());
+        #else
+        gemm(m1.rows(), m2.columns(), m1.columns(), 1.0,
+             &*m1.begin(), m1.columns(),
+             &*m2.begin(), m2.columns(),
+             &*result.begin(), result.columns(), threads);
+        #endif
+        return result;
+    }
+
+
+    Real luDecomposition(Matrix& m, std::vector<Size>& pivots,
+                         Size threads) {
+        const Size n = m.rows();
+        QL_REQUIRE(n == m.columns(), "matrix is not square");
+        pivots.resize(n);
+        if (n == 0)
+            return 1.0;
+
+        Real* a = &*m.begin();
+
+        #if defined(QL_DENSE_LINEAR_ALGEBRA_BACKEND)
+        std::vector<lapack_int> ipiv(n);
+        const lapack_int info =
+            LAPACKE_dgetrf(LAPACK_ROW_MAJOR, n, n, a, n, ipiv.data());
+        QL_REQUIRE(info >= 0,
+                   "Failed to obtain LU decomposition of the matrix.");
+        Real sign = 1.0;
+        for (Size i=0; i<n; ++i) {
+            pivots[i] = ipiv[i] - 1;
+            if (pivots[i] != i)
+                sign = -sign;
+        }
+        return info > 0 ? 0.0 : sign;
+        #else
+        Real sign = 1.0;
+        bool singular = false;
+
+        for (Size k0=0; k0<n; k0+=nb) {
+            const Size kb = std::min(nb, n-k0);
+            const Size k1 = k0 + kb;
+
+            // factor the panel of columns [k0, k1)
+            for (Size k=k0; k<k1; ++k) {
+                Size p = k;
+                for (Size i=k+1; i<n; ++i)
+                    if (std::fabs(a[i*n+k]) > std::fabs(a[p*n+k]))
+                        p = i;
+                pivots[k] = p;
+                if (p != k) {
+                    std::swap_ranges(a + k*n, a + (k+1)*n, a + p*n);
+                    sign = -sign;
+                }
+                const Real pivot = a[k*n+k];
+                // the rest of the column is zero as well
+                if (pivot == 0.0) {
+                    singular = true;
+                    continue;
+                }
+                for (Size i=k+1; i<n; ++i) {
+                    Real* ai = a + i*n;
+                    const Real l = ai[k] /= pivot;
+                    const Real* ak = a + k*n;
+                    for (Size j=k+1; j<k1; ++j)
+                        ai[j] -= l*ak[j];
+                }
+            }
+            if (k1 == n)
+                break;
+
+            // rows [k0, k1) of the upper factor
+            for (Size i=k0+1; i<k1; ++i) {
+                Real* ai = a + i*n;
+                for (Size p=k0; p<i; ++p) {
+                    const Real l = ai[p];
+                    const Real* ap = a + p*n;
+                    for (Size j=k1; j<n; ++j)
+                        ai[j] -= l*ap[j];
+                }
+            }
+
+            // update of the trailing submatrix
+            gemm(n-k1, n-k1, kb, -1.0,
+                 a + k1*n + k0, n, a + k0*n + k1, n,
+                 a + k1*n + k1, n, threads);
+        }
+
+        return singular ? 0.0 : sign;
+        #endif
+    }
+
+
+    void luSolve(const Matrix& lu, const std::vector<Size>& pivots,
+                 Matrix& b, Size threads) {
+        const Size n = lu.rows();
+        QL_REQUIRE(n == lu.columns(), "matrix is not square");
+        QL_REQUIRE(pivots.size() == n,
+                   "wrong number of pivots (" << pivots.size()
+                   << ", " << n << " required)");
+        QL_REQUIRE(b.rows() == n,
+                   "wrong number of rows for the right-hand side ("
+                   << b.rows() << ", " << n << " required)");
+        const Size m = b.columns();
+        if (n == 0 || m == 0)
+            return;
+
+        const Real* a = &*lu.begin();
+        Real* x = &*b.begin();
+
+        #if defined(QL_DENSE_LINEAR_ALGEBRA_BACKEND)
+        std::vector<lapack_int> ipiv(n);
+        for (Size i=0; i<n; ++i)
+            ipiv[i] = pivots[i] + 1;
+        const lapack_int info =
+            LAPACKE_dgetrs(LAPACK_ROW_MAJOR, 'N', n, m,
+                           const_cast<Real*>(a), n, ipiv.data(), x, m);
+        QL_REQUIRE(info == 0, "Could not solve the linear system.");
+        #else
+        for (Size i=0; i<n; ++i)
+            if (pivots[i] != i)
+                std::swap_ranges(x + i*m, x + (i+1)*m, x + pivots[i]*m);
+
+        // forward substitution with the unit lower factor
+        for (Size i0=0; i0<n; i0+=nb) {
+            const Size i1 = std::min(i0+nb, n);
+            gemm(i1-i0, m, i0, -1.0, a + i0*n, n, x, m,
+                 x + i0*m, m, threads);
+            for (Size i=i0+1; i<i1; ++i) {
+                Real* xi = x + i*m;
+                for (Size p=i0; p<i; ++p) {
+                    const Real l = a[i*n+p];
+                    const Real* xp = x + p*m;
+                    for (Size j=0; j<m; ++j)
+                        xi[j] -= l*xp[j];
+                }
+            }
+        }
+
+        // backward substitution with the upper factor
+        for (Size i0=(n-1)/nb*nb;; i0-=nb) {
+            const Size i1 = std::min(i0+nb, n);
+            gemm(i1-i0, m, n-i1, -1.0, a + i0*n + i1, n, x + i1*m, m,
+                 x + i0*m, m, threads);
+            for (Size i=i1; i-->i0; ) {
+                Real* xi = x + i*m;
+                for (Size p=i+1; p<i1; ++p) {
+                    const Real u = a[i*n+p];
+                    const Real* xp = x + p*m;
+                    for (Size j=0; j<m; ++j)
+                        xi[j] -= u*xp[j];
+                }
+                const Real d = a[i*n+i];
+                for (Size j=0; j<m; ++j)
+                    xi[j] /= d;
+            }
+            if (i0 == 0)
+                break;
+        }
+        #endif
+    }
+
+
+    void choleskyFactorization(Matrix& m, bool flexible, Size threads) {
+        const Size n = m.rows();
+        QL_REQUIRE(n == m.columns(), "input matrix is not a square matrix");
+        if (n == 0)
+            return;
+
+        Real* a = &*m.begin();
+
+        // semi-definite matrices are not handled by the backend
+        #if defined(QL_DENSE_LINEAR_ALGEBRA_BACKEND)
+        if (!flexible) {
+            const lapack_int info =
+                LAPACKE_dpotrf(LAPACK_ROW_MAJOR, 'L', n, a, n);
+            QL_REQUIRE(info == 0, "input matrix is not positive definite");
+            for (Size i=0; i<n; ++i)
+                std::fill(a + i*n + i + 1, a + (i+1)*n, 0.0);
+            return;
+        }
+        #endif
+
+        std::vector<Real> transposed;
+
+        for (Size k0=0; k0<n; k0+=nb) {
+            const Size k1 = std::min(k0+nb, n);
+
+            // columns [k0, k1) of the factor; the contributions of the
+            // previous columns were subtracted by the trailing updates
+            for (Size i=k0; i<k1; ++i) {
+                const Real* ai = a + i*n;
+                for (Size j=i; j<n; ++j) {
+                    Real* aj = a + j*n;
+                    Real sum = aj[i];
+                    for (Size p=k0; p<i; ++p)
+                        sum -= ai[p]*aj[p];
+                    if (i == j) {
+                        QL_REQUIRE(flexible || sum > 0.0,
+                                   "input matrix is not positive definite");
+                        // To handle positive semi-definite matrices take
+                        // the square root of sum if positive, else zero.
+                        aj[i] = std::sqrt(std::max<Real>(sum, 0.0));
+                    } else {
+                        // With positive semi-definite matrices is possible
+                        // to have ai[i]==0.0
+                        // In this case sum happens to be zero as well
+                        aj[i] = close_enough(ai[i], 0.0) ? 0.0 : sum/ai[i];
+                    }
+                }
+            }
+            if (k1 == n)
+                break;
+
+            // update of the lower triangle of the trailing submatrix,
+            // by blocks of rows
+            const Size kb = k1-k0, rest = n-k1;
+            transposed.resize(kb*rest);
+            for (Size j=0; j<rest; ++j)
+                for (Size p=0; p<kb; ++p)
+                    transposed[p*rest+j] = a[(k1+j)*n+k0+p];
+            const Size blocks = (rest+nb-1)/nb;
+            const Size workers =
+                rest*rest*kb < 2*parallelThreshold ? 1 : threads;
+            parallelFor(blocks, workers, [&](Size block) {
+                const Size r0 = block*nb, r1 = std::min(r0+nb, rest);
+                gemmSerial(r1-r0, r1, kb, -1.0,
+                           a + (k1+r0)*n + k0, n, &transposed[0], rest,
+                           a + (k1+r0)*n + k1, n);
+            });
+        }
+
+        for (Size i=0; i<n; ++i)
+            std::fill(a + i*n + i + 1, a + (i+1)*n, 0.0);
+    }
+
+}
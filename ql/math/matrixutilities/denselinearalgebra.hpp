@@ -0,0 +1,104 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file denselinearalgebra.hpp
+    \brief blocked kernels for dense linear algebra
+*/
+
+#ifndef quantlib_dense_linear_algebra_hpp
+#define quantlib_dense_linear_algebra_hpp
+
+#include <ql/math/matrix.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    /*! The functions below are the built-in kernels used for the
+        product of matrices, the LU decomposition behind inverse() and
+        determinant(), and the Cholesky decomposition.
+
+        The matrix product is blocked so that the operands fit in
+        cache; each block is copied in panels which are multiplied by a
+        small register-tiled kernel whose inner loops are contiguous,
+        so that the compiler can vectorize them.  The decompositions
+        are blocked as well, and spend most of their time in the same
+        product kernel when updating the trailing submatrix.
+
+        Large problems can be split among several threads; the
+        partition depends only on the sizes of the matrices and on the
+        number of threads, so that results are reproducible for a
+        given number of threads.  Small problems always run on the
+        calling thread.
+
+        If the library is configured with QL_USE_MKL or QL_USE_CBLAS,
+        the functions dispatch instead to the corresponding CBLAS and
+        LAPACKE routines (dgemm, dgetrf, dgetrs and dpotrf) of Intel
+        MKL or of the implementation found at configure time, such as
+        OpenBLAS, BLIS or the reference LAPACK; in that case, the
+        number of threads is managed by the library and the given one
+        is ignored.  The flexible Cholesky decomposition of positive
+        semi-definite matrices always uses the built-in kernel.
+    */
+
+    //! product of two matrices
+    /*! \relates Matrix */
+    Matrix matrixProduct(const Matrix& m1, const Matrix& m2,
+                         Size threads = 1);
+
+    //! in-place LU decomposition with partial pivoting
+    /*! On exit, the strictly lower triangle of \f$ m \f$ holds the
+        multipliers of the unit lower triangular factor and the upper
+        triangle holds the upper triangular factor; row \f$ i \f$ was
+        interchanged with row pivots[i] at the \f$ i \f$-th step.
+
+        The returned value is the sign of the permutation, or zero if
+        the matrix is singular; in the latter case, the decomposition
+        is still completed, and has a zero on the diagonal.
+
+        \relates Matrix
+    */
+    Real luDecomposition(Matrix& m,
+                         std::vector<Size>& pivots,
+                         Size threads = 1);
+
+    //! solves \f$ A X = B \f$ given the LU decomposition of A
+    /*! The right-hand sides are the columns of \f$ b \f$, which is
+        overwritten with the solutions.
+
+        \relates Matrix
+    */
+    void luSolve(const Matrix& lu,
+                 const std::vector<Size>& pivots,
+                 Matrix& b,
+                 Size threads = 1);
+
+    //! in-place Cholesky decomposition
+    /*! Only the lower triangle of \f$ m \f$ is read; on exit, it holds
+        the lower triangular factor and the upper triangle is zero.  If
+        flexible is true, positive semi-definite matrices are accepted
+        as in CholeskyDecomposition().
+
+        \relates Matrix
+    */
+    void choleskyFactorization(Matrix& m,
+                               bool flexible = false,
+                               Size threads = 1);
+
+}
+
+
+#endif
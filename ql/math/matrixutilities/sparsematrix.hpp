@@ -126,6 +126,7 @@ namespace QuantLib {
     template<typename T>
     SparseMatrixGeneral<T> &SparseMatrixGeneral<T>::operator*=(const T &x) {
         std::for_each(values_.begin(), values_.end(), [x](T& y) {  y *= x; });
+        return *this;
     }
 
     template<typename T>
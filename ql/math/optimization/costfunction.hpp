@@ -89,6 +89,12 @@ namespace QuantLib {
 
         //! Default epsilon for finite difference method :
         virtual Real finiteDifferenceEpsilon() const { return 1e-8; }
+
+        //! whether jacobian() is overloaded with an exact calculation
+        /*! Optimization methods can use it to prefer the Jacobian
+            of the cost function over their own finite differences.
+        */
+        virtual bool hasAnalyticJacobian() const { return false; }
     };
 
     class ParametersTransformation {
@@ -19,6 +19,7 @@
 */
 
 #include <ql/math/optimization/differentialevolution.hpp>
+#include <ql/utilities/parallelfor.hpp>
 
 namespace QuantLib {
 
@@ -259,13 +260,17 @@ namespace QuantLib {
                                - lowerBound_[memIter]);
                 }
             }
-            // evaluate objective function as soon as possible to avoid unnecessary loops
+        }
+        // the random numbers are all drawn; the members can be
+        // evaluated in any order
+        parallelFor(population.size(), configuration().threads,
+                    [&](Size popIter) {
             try {
                 population[popIter].cost = costFunction.value(population[popIter].values);
             } catch (Error&) {
                 population[popIter].cost = QL_MAX_REAL;
             }
-        }
+        });
     }
 
     void DifferentialEvolution::getCrossoverMask(
@@ -344,15 +349,18 @@ namespace QuantLib {
 
         // use initial values provided by the user
         population.front().values = p.currentValue();
-        population.front().cost = p.costFunction().value(population.front().values);
         // rest of the initial population is random
         for (Size j = 1; j < population.size(); ++j) {
             for (Size i = 0; i < p.currentValue().size(); ++i) {
                 Real l = lowerBound_[i], u = upperBound_[i];
                 population[j].values[i] = l + (u-l)*rng_.nextReal();
             }
-            population[j].cost = p.costFunction().value(population[j].values);
         }
+        const CostFunction& costFunction = p.costFunction();
+        parallelFor(population.size(), configuration().threads,
+                    [&](Size j) {
+            population[j].cost = costFunction.value(population[j].values);
+        });
     }
 
 }
@@ -50,6 +50,11 @@ namespace QuantLib {
         3) various weights distributions for the differences (dither etc.)
         4) printFullInfo parameter usage to track the algorithm
 
+        The members of each generation can be evaluated on multiple
+        threads (see Configuration::withThreads); random numbers are
+        drawn before the evaluations, so that the results only depend
+        on the seed and not on the number of threads.
+
         \warning This was reported to fail tests on Mac OS X 10.8.4.
     */
 
@@ -87,6 +92,7 @@ namespace QuantLib {
             Real stepsizeWeight, crossoverProbability;
             unsigned long seed;
             bool applyBounds, crossoverIsAdaptive;
+            Size threads;
 
             Configuration()
             : strategy(BestMemberWithJitter),
@@ -96,7 +102,8 @@ namespace QuantLib {
               crossoverProbability(0.9),
               seed(0),
               applyBounds(true),
-              crossoverIsAdaptive(false) {}
+              crossoverIsAdaptive(false),
+              threads(1) {}
 
             Configuration& withBounds(bool b = true) {
                 applyBounds = b;
@@ -144,6 +151,15 @@ namespace QuantLib {
                 strategy = s;
                 return *this;
             }
+
+            /*! the trials of each generation are evaluated together as
+                in Problem::value(const std::vector<Array>&, Size).
+            */
+            Configuration& withThreads(Size n) {
+                QL_REQUIRE(n>0, "Positive number of threads required");
+                threads = n;
+                return *this;
+            }
         };
 
 
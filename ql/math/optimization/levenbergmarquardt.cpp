@@ -54,7 +54,10 @@ namespace QuantLib {
         initCostValues_ = P.costFunction().values(x_);
         int m = initCostValues_.size();
         int n = x_.size();
-        if(useCostFunctionsJacobian_) {
+        const bool useCostFunctionsJacobian =
+            useCostFunctionsJacobian_
+            || P.costFunction().hasAnalyticJacobian();
+        if(useCostFunctionsJacobian) {
             initJacobian_ = Matrix(m,n);
             P.costFunction().jacobian(initJacobian_, x_);
         }
@@ -92,7 +95,7 @@ namespace QuantLib {
         MINPACK::LmdifCostFunction lmdifCostFunction =
             [this](int m, int n, Real* x, Real* fvec, int* iflag ){this->fcn(m, n, x, fvec, iflag);};
         MINPACK::LmdifCostFunction lmdifJacFunction =
-            useCostFunctionsJacobian_
+            useCostFunctionsJacobian
                 ? [this](int m, int n, Real* x, Real* fvec, int* iflag){this->jacFcn(m,n,x,fvec,iflag);}
                 : MINPACK::LmdifCostFunction(NULL);
         MINPACK::lmdif(m, n, xx.data(), fvec.data(),
@@ -44,6 +44,9 @@ namespace QuantLib {
         (oder 2, but requiring more function
         evaluations) compared to the forward
         difference implemented here (order 1).
+        The Jacobian of the cost function is also
+        used if the latter declares it analytic
+        (see CostFunction::hasAnalyticJacobian).
 
         \ingroup optimizers
     */
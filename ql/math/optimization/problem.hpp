@@ -28,6 +28,8 @@
 
 #include <ql/math/optimization/method.hpp>
 #include <ql/math/optimization/costfunction.hpp>
+#include <ql/utilities/parallelfor.hpp>
+#include <vector>
 
 namespace QuantLib {
 
@@ -58,6 +60,15 @@ namespace QuantLib {
         //! call cost values computation and increment evaluation counter
         Array values(const Array& x);
 
+        //! call cost function computation on each point and increment evaluation counter
+        /*! The points are split among the given number of threads;
+            the results do not depend on their number.
+
+            \warning with more than one thread, the cost function is
+                     called concurrently and must be safe for it.
+        */
+        Array value(const std::vector<Array>& x, Size threads = 1);
+
         //! call cost function gradient computation and increment
         //  evaluation counter
         void gradient(Array& grad_f,
@@ -123,6 +134,15 @@ namespace QuantLib {
         return costFunction_.values(x);
     }
 
+    inline Array Problem::value(const std::vector<Array>& x, Size threads) {
+        Array y(x.size());
+        functionEvaluation_ += Integer(x.size());
+        parallelFor(x.size(), threads, [&](Size i) {
+            y[i] = costFunction_.value(x[i]);
+        });
+        return y;
+    }
+
     inline void Problem::gradient(Array& grad_f,
                                   const Array& x) {
         ++gradientEvaluation_;
@@ -68,9 +68,159 @@
 
 #include <ql/math/randomnumbers/seedgenerator.hpp>
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
+#include <ql/errors.hpp>
+#include <algorithm>
+#include <bitset>
+#include <cstdint>
+#include <mutex>
 
 namespace QuantLib {
 
+    namespace {
+
+        // Polynomials over GF(2) are stored as bit vectors; the i-th
+        // bit of the vector is the coefficient of x^i.
+        typedef std::vector<std::uint64_t> Polynomial;
+
+        // degree of the characteristic polynomial of MT19937
+        const Size degree = 19937;
+        const Size words = degree/64 + 1;
+
+        inline bool coefficient(const Polynomial& p, Size i) {
+            return ((p[i/64] >> (i%64)) & 1) != 0;
+        }
+
+        // p ^= q * x^shift
+        void addShifted(Polynomial& p, const Polynomial& q, Size shift) {
+            Size w = shift/64, b = shift%64;
+            for (Size i=0; i<q.size() && i+w<p.size(); ++i) {
+                p[i+w] ^= q[i] << b;
+                if (b != 0 && i+w+1 < p.size())
+                    p[i+w+1] ^= q[i] >> (64-b);
+            }
+        }
+
+        // bits [pos, pos+64) of p, padded with zeros
+        inline std::uint64_t extract(const Polynomial& p, Size pos) {
+            Size w = pos/64, b = pos%64;
+            std::uint64_t lo = w < p.size() ? p[w] >> b : 0;
+            std::uint64_t hi =
+                (b != 0 && w+1 < p.size()) ? p[w+1] << (64-b) : 0;
+            return lo | hi;
+        }
+
+        /* Characteristic polynomial of the MT19937 recurrence, obtained
+           with the Berlekamp-Massey algorithm from the sequence of the
+           least significant bits of its output; it doesn't depend on
+           the seed. */
+        Polynomial characteristicPolynomial() {
+            const Size n = 2*degree;
+            // the sequence is stored in reverse order, so that the
+            // bits entering the discrepancy are contiguous
+            Polynomial reversed(n/64 + 2, 0);
+            MersenneTwisterUniformRng rng(5489UL);
+            for (Size i=0; i<n; ++i) {
+                Size pos = n-1-i;
+                reversed[pos/64] |=
+                    std::uint64_t(rng.nextInt32() & 1) << (pos%64);
+            }
+
+            Polynomial c(n/64 + 2, 0), b(n/64 + 2, 0), t;
+            c[0] = b[0] = 1;
+            Size L = 0, m = 1;
+            for (Size i=0; i<n; ++i) {
+                std::uint64_t sum = 0;
+                for (Size w=0; w<=L/64; ++w)
+                    sum ^= c[w] & extract(reversed, n-1-i + 64*w);
+                bool discrepancy = (std::bitset<64>(sum).count() & 1) != 0;
+                if (!discrepancy) {
+                    ++m;
+                } else if (2*L <= i) {
+                    t = c;
+                    addShifted(c, b, m);
+                    L = i+1-L;
+                    b.swap(t);
+                    m = 1;
+                } else {
+                    addShifted(c, b, m);
+                    ++m;
+                }
+            }
+            QL_ENSURE(L == degree,
+                      "unexpected linear complexity (" << L << ")");
+
+            // the characteristic polynomial is the reciprocal of the
+            // connection polynomial
+            Polynomial phi(words+1, 0);
+            for (Size k=0; k<=degree; ++k)
+                if (coefficient(c, degree-k))
+                    phi[k/64] |= std::uint64_t(1) << (k%64);
+            return phi;
+        }
+
+        class JumpPolynomials {
+          public:
+            // x^(2^k) modulo the characteristic polynomial
+            Polynomial get(Size k) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (powers_.empty()) {
+                    Polynomial phi = characteristicPolynomial();
+                    for (Size s=0; s<64; ++s) {
+                        Polynomial shifted(words+2, 0);
+                        addShifted(shifted, phi, s);
+                        shiftedPhi_.push_back(shifted);
+                    }
+                    Polynomial x(words, 0);
+                    x[0] = 2;
+                    powers_.push_back(x);
+                }
+                while (powers_.size() <= k)
+                    powers_.push_back(square(powers_.back()));
+                return powers_[k];
+            }
+          private:
+            Polynomial square(const Polynomial& p) const {
+                Polynomial q(2*words+2, 0);
+                for (Size i=0; i<p.size(); ++i) {
+                    q[2*i] = spread(std::uint32_t(p[i]));
+                    q[2*i+1] = spread(std::uint32_t(p[i] >> 32));
+                }
+                // reduce modulo the characteristic polynomial
+                for (Size i=2*degree; i>=degree; --i) {
+                    if (coefficient(q, i)) {
+                        Size shift = i - degree;
+                        const Polynomial& phi = shiftedPhi_[shift%64];
+                        Size w = shift/64;
+                        for (Size j=0; j<phi.size() && j+w<q.size(); ++j)
+                            q[j+w] ^= phi[j];
+                    }
+                }
+                q.resize(words);
+                return q;
+            }
+            static std::uint64_t spread(std::uint32_t x) {
+                // interleaves the bits of x with zeros
+                std::uint64_t v = x;
+                v = (v | (v << 16)) & 0x0000FFFF0000FFFFULL;
+                v = (v | (v << 8))  & 0x00FF00FF00FF00FFULL;
+                v = (v | (v << 4))  & 0x0F0F0F0F0F0F0F0FULL;
+                v = (v | (v << 2))  & 0x3333333333333333ULL;
+                v = (v | (v << 1))  & 0x5555555555555555ULL;
+                return v;
+            }
+            std::mutex mutex_;
+            std::vector<Polynomial> powers_;
+            // characteristic polynomial times x^s, s = 0...63
+            std::vector<Polynomial> shiftedPhi_;
+        };
+
+        JumpPolynomials& jumpPolynomials() {
+            static JumpPolynomials polynomials;
+            return polynomials;
+        }
+
+    }
+
     // constant vector a
     const unsigned long MersenneTwisterUniformRng::MATRIX_A = 0x9908b0dfUL;
     // most significant w-r bits
@@ -123,23 +273,79 @@ namespace QuantLib {
     }
 
     void MersenneTwisterUniformRng::twist() const {
-        static const unsigned long mag01[2]={0x0UL, MATRIX_A};
-        /* mag01[x] = x * MATRIX_A  for x=0,1 */
+        /* (0 - x) & MATRIX_A = x * MATRIX_A for x=0,1; unlike a table
+           lookup, this allows the compiler to vectorize the loops */
         Size kk;
         unsigned long y;
 
         for (kk=0;kk<N-M;kk++) {
             y = (mt[kk]&UPPER_MASK)|(mt[kk+1]&LOWER_MASK);
-            mt[kk] = mt[kk+M] ^ (y >> 1) ^ mag01[y & 0x1UL];
+            mt[kk] = mt[kk+M] ^ (y >> 1) ^ ((0UL - (y & 0x1UL)) & MATRIX_A);
         }
         for (;kk<N-1;kk++) {
             y = (mt[kk]&UPPER_MASK)|(mt[kk+1]&LOWER_MASK);
-            mt[kk] = mt[(kk+M)-N] ^ (y >> 1) ^ mag01[y & 0x1UL];
+            mt[kk] = mt[(kk+M)-N] ^ (y >> 1)
+                ^ ((0UL - (y & 0x1UL)) & MATRIX_A);
         }
         y = (mt[N-1]&UPPER_MASK)|(mt[0]&LOWER_MASK);
-        mt[N-1] = mt[M-1] ^ (y >> 1) ^ mag01[y & 0x1UL];
+        mt[N-1] = mt[M-1] ^ (y >> 1) ^ ((0UL - (y & 0x1UL)) & MATRIX_A);
 
         mti = 0;
     }
 
+    void MersenneTwisterUniformRng::fill(Real* begin, Size n) const {
+        while (n > 0) {
+            if (mti==N)
+                twist();
+            Size m = std::min(n, N-mti);
+            const unsigned long* y = mt + mti;
+            for (Size i=0; i<m; ++i)
+                begin[i] = (Real(temper(y[i])) + 0.5)/4294967296.0;
+            mti += m;
+            begin += m;
+            n -= m;
+        }
+    }
+
+    void MersenneTwisterUniformRng::jumpAhead(Size k) {
+        const Polynomial p = jumpPolynomials().get(k);
+
+        /* The words in mt are consecutive terms of the sequence; they
+           are replaced by the terms 2^k positions later, computed as
+           p(A) applied to the state, A being the transition matrix.
+           The sum is accumulated while running the recurrence on a
+           circular copy of the state, one term at a time. */
+        unsigned long s[N], result[N];
+        std::copy(mt, mt+N, s);
+        std::fill(result, result+N, 0UL);
+        Size i = 0;
+        for (Size j=0; j<degree; ++j) {
+            if (coefficient(p, j)) {
+                for (Size r=0; r<N-i; ++r)
+                    result[r] ^= s[i+r];
+                for (Size r=0; r<i; ++r)
+                    result[N-i+r] ^= s[r];
+            }
+            unsigned long y = (s[i]&UPPER_MASK)|(s[(i+1)%N]&LOWER_MASK);
+            s[i] = s[(i+M)%N] ^ (y >> 1) ^ ((0UL - (y & 0x1UL)) & MATRIX_A);
+            i = (i+1)%N;
+        }
+        std::copy(result, result+N, mt);
+    }
+
+
+    MersenneTwisterStreamFactory::MersenneTwisterStreamFactory(
+                                unsigned long seed, Size log2StreamLength)
+    : first_(seed), log2StreamLength_(log2StreamLength) {}
+
+    MersenneTwisterUniformRng
+    MersenneTwisterStreamFactory::stream(Size i) const {
+        MersenneTwisterUniformRng rng = first_;
+        for (Size b=0; i!=0; ++b, i>>=1) {
+            if ((i & 1) != 0)
+                rng.jumpAhead(log2StreamLength_ + b);
+        }
+        return rng;
+    }
+
 }
@@ -35,8 +35,19 @@ namespace QuantLib {
 
         For more details see http://www.math.keio.ac.jp/matumoto/emt.html
 
+        The generator can be advanced by \f$ 2^k \f$ draws without
+        drawing them by means of jumpAhead(), which multiplies the
+        state by the polynomial \f$ x^{2^k} \f$ modulo the
+        characteristic polynomial of the recurrence (see Haramoto
+        et al., "Efficient jump ahead for F2-linear random number
+        generators", 2008). This is used by
+        MersenneTwisterStreamFactory to provide non-overlapping
+        streams to parallel simulations.
+
         \test the correctness of the returned values is tested by
               checking them against known good results.
+        \test jumps are tested against the corresponding number of
+              draws.
     */
     class MersenneTwisterUniformRng {
       private:
@@ -62,26 +73,40 @@ namespace QuantLib {
             if (mti==N)
                 twist(); /* generate N words at a time */
 
-            unsigned long y = mt[mti++];
-
-            /* Tempering */
-            y ^= (y >> 11);
-            y ^= (y << 7) & 0x9d2c5680UL;
-            y ^= (y << 15) & 0xefc60000UL;
-            y ^= (y >> 18);
-            return y;
+            return temper(mt[mti++]);
         }
+        /*! fills the given range with random numbers in the
+            (0.0, 1.0)-interval; the result is the same as that of
+            \f$ n \f$ calls to nextReal().
+        */
+        void fill(Real* begin, Size n) const;
+        /*! advances the generator by \f$ 2^k \f$ draws, as if
+            nextInt32() had been called \f$ 2^k \f$ times.
+
+            \note the first jump by a given \f$ k \f$ computes the
+                  corresponding jump polynomial, which takes a time
+                  proportional to \f$ k \f$; polynomials are cached
+                  and shared by all instances.
+        */
+        void jumpAhead(Size k);
         unsigned long operator()() const {
 	    return nextInt32();
 	}
-	unsigned long max() const {
+	static constexpr unsigned long max() {
 		return 0xffffffff;
 	}
-	unsigned long min() const {
+	static constexpr unsigned long min() {
 		return 0;
 	}
 
       private:
+        static unsigned long temper(unsigned long y) {
+            y ^= (y >> 11);
+            y ^= (y << 7) & 0x9d2c5680UL;
+            y ^= (y << 15) & 0xefc60000UL;
+            y ^= (y >> 18);
+            return y;
+        }
         void seedInitialization(unsigned long seed);
         void twist() const;
         mutable unsigned long mt[N];
@@ -89,6 +114,29 @@ namespace QuantLib {
         static const unsigned long MATRIX_A, UPPER_MASK, LOWER_MASK;
     };
 
+
+    //! Factory of non-overlapping Mersenne Twister streams
+    /*! The \f$ i \f$-th stream starts \f$ 2^k i \f$ draws after
+        the state given by the seed; therefore, streams do not
+        overlap unless more than \f$ 2^k \f$ numbers are drawn from
+        any of them.  Each stream is obtained from the seeded state
+        by at most \f$ \log_2 i + 1 \f$ jumps.
+    */
+    class MersenneTwisterStreamFactory {
+      public:
+        /*! if the given seed is 0, a random seed will be chosen
+            based on clock() */
+        explicit MersenneTwisterStreamFactory(unsigned long seed = 0,
+                                              Size log2StreamLength = 64);
+        //! returns the i-th stream
+        MersenneTwisterUniformRng stream(Size i) const;
+        //! base-2 logarithm of the number of draws between streams
+        Size log2StreamLength() const { return log2StreamLength_; }
+      private:
+        MersenneTwisterUniformRng first_;
+        Size log2StreamLength_;
+    };
+
 }
 
 
@@ -27,6 +27,8 @@
 #define quantlib_sobol_ld_rsg_hpp
 
 #include <ql/methods/montecarlo/sample.hpp>
+#include <ql/errors.hpp>
+#include <algorithm>
 #include <vector>
 
 namespace QuantLib {
@@ -100,11 +102,21 @@ namespace QuantLib {
         or so dimensions which is why we have the Alternative
         Primitive Polynomials.
 
+        Points can also be drawn in blocks by means of nextInt32Block()
+        and nextBlock(), which avoid the per-point overhead of
+        nextSequence() and store the points contiguously.  Together
+        with skipTo(), whose cost is logarithmic in the number of
+        skipped points, this allows several workers to draw disjoint
+        slices of the same sequence: after skipTo(n) on a newly built
+        generator, the next point drawn is the n-th one.
+
         \test
         - the correctness of the returned values is tested by
           reproducing known good values.
         - the correctness of the returned values is tested by checking
           their discrepancy against known good values.
+        - the points returned in blocks and after skipping are checked
+          against those returned one by one.
     */
     class SobolRsg {
       public:
@@ -127,9 +139,23 @@ namespace QuantLib {
                 sequence_.value[k] = v[k] * normalizationFactor_;
             return sequence_;
         }
+        /*! fills the block with the next \f$ n \f$ points of the
+            sequence, stored point by point; that is, the \f$ k \f$-th
+            coordinate of the \f$ i \f$-th point is stored at index
+            \f$ i d + k \f$, \f$ d \f$ being the dimension.  The
+            generator is left in the same state as after \f$ n \f$
+            calls to nextInt32Sequence().
+        */
+        void nextInt32Block(Size n, std::vector<unsigned long>& block) const;
+        /*! fills the block with the next \f$ n \f$ points of the
+            sequence, normalized to (0,1) and stored as in
+            nextInt32Block(); lastSequence() returns the last of them.
+        */
+        void nextBlock(Size n, std::vector<Real>& block) const;
         const sample_type& lastSequence() const { return sequence_; }
         Size dimension() const { return dimensionality_; }
       private:
+        const unsigned long* directionIntegersByBit() const;
         static const int bits_;
         static const double normalizationFactor_;
         Size dimensionality_;
@@ -138,8 +164,99 @@ namespace QuantLib {
         mutable sample_type sequence_;
         mutable std::vector<unsigned long> integerSequence_;
         std::vector<std::vector<unsigned long> > directionIntegers_;
+        // direction integers stored bit by bit, so that the integers
+        // used by a Gray-code update of all dimensions are contiguous
+        mutable std::vector<unsigned long> directionIntegersByBit_;
     };
 
+
+    // inline definitions
+
+    inline const unsigned long* SobolRsg::directionIntegersByBit() const {
+        if (directionIntegersByBit_.empty()) {
+            Size bits = directionIntegers_[0].size();
+            directionIntegersByBit_.resize(bits*dimensionality_);
+            for (Size j=0; j<bits; ++j)
+                for (Size k=0; k<dimensionality_; ++k)
+                    directionIntegersByBit_[j*dimensionality_+k] =
+                        directionIntegers_[k][j];
+        }
+        return &directionIntegersByBit_[0];
+    }
+
+    inline void SobolRsg::nextInt32Block(
+                          Size n, std::vector<unsigned long>& block) const {
+        const Size d = dimensionality_;
+        block.resize(n*d);
+        if (n == 0)
+            return;
+
+        const unsigned long* v = directionIntegersByBit();
+        Size i = 0;
+        if (firstDraw_) {
+            // the first point is the initial state of the generator
+            firstDraw_ = false;
+            std::copy(integerSequence_.begin(), integerSequence_.end(),
+                      block.begin());
+            i = 1;
+        }
+        const unsigned long* previous =
+            (i == 0) ? &integerSequence_[0] : &block[0];
+        for (; i<n; ++i) {
+            sequenceCounter_++;
+            QL_REQUIRE(sequenceCounter_ != 0, "period exceeded");
+
+            // Gray-code update: find rightmost zero bit of the counter
+            Size j = 0;
+            unsigned long c = sequenceCounter_;
+            while (c & 1) {
+                c >>= 1;
+                j++;
+            }
+            const unsigned long* vj = v + j*d;
+            unsigned long* current = &block[i*d];
+            for (Size k=0; k<d; ++k)
+                current[k] = previous[k] ^ vj[k];
+            previous = current;
+        }
+        std::copy(block.end()-d, block.end(), integerSequence_.begin());
+    }
+
+    inline void SobolRsg::nextBlock(Size n, std::vector<Real>& block) const {
+        const Size d = dimensionality_;
+        block.resize(n*d);
+        if (n == 0)
+            return;
+
+        const unsigned long* v = directionIntegersByBit();
+        unsigned long* x = &integerSequence_[0];
+        Size i = 0;
+        if (firstDraw_) {
+            firstDraw_ = false;
+            for (Size k=0; k<d; ++k)
+                block[k] = x[k] * normalizationFactor_;
+            i = 1;
+        }
+        for (; i<n; ++i) {
+            sequenceCounter_++;
+            QL_REQUIRE(sequenceCounter_ != 0, "period exceeded");
+
+            Size j = 0;
+            unsigned long c = sequenceCounter_;
+            while (c & 1) {
+                c >>= 1;
+                j++;
+            }
+            const unsigned long* vj = v + j*d;
+            Real* current = &block[i*d];
+            for (Size k=0; k<d; ++k) {
+                x[k] ^= vj[k];
+                current[k] = x[k] * normalizationFactor_;
+            }
+        }
+        std::copy(block.end()-d, block.end(), sequence_.value.begin());
+    }
+
 }
 
 #endif
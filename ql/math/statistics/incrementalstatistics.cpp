@@ -130,6 +130,13 @@ namespace QuantLib {
             downsideData_.emplace_back(std::make_pair(value, valueWeight));
     }
 
+    void IncrementalStatistics::merge(const IncrementalStatistics& other) {
+        data_.insert(data_.end(), other.data_.begin(), other.data_.end());
+        downsideData_.insert(downsideData_.end(),
+                             other.downsideData_.begin(),
+                             other.downsideData_.end());
+    }
+
     void IncrementalStatistics::reset() {
         data_.clear();
         downsideData_.clear();
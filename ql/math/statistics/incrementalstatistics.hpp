@@ -140,6 +140,10 @@ namespace QuantLib {
                 add(*begin, *wbegin);
         }
 
+        //! adds the data collected by another instance
+        /*! The data are appended after the ones already collected. */
+        void merge(const IncrementalStatistics& other);
+
         //! resets the data to a null set
         void reset();
         //@}
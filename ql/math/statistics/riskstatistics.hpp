@@ -26,6 +26,7 @@
 
 #include <ql/math/functional.hpp>
 #include <ql/math/statistics/gaussianstatistics.hpp>
+#include <ql/math/statistics/tdigeststatistics.hpp>
 
 namespace QuantLib {
 
@@ -43,6 +44,9 @@ namespace QuantLib {
       public:
         typedef typename S::value_type value_type;
 
+        GenericRiskStatistics() {}
+        GenericRiskStatistics(const S& s) : S(s) {}
+
         /*! returns the variance of observations below the mean,
             \f[ \frac{N}{N-1}
                 \mathrm{E}\left[ (x-\langle x \rangle)^2 \;|\;
@@ -123,6 +127,15 @@ namespace QuantLib {
     */
     typedef GenericRiskStatistics<GaussianStatistics> RiskStatistics;
 
+    //! risk measures tool with bounded memory
+    /*! Percentile-based measures such as value-at-risk and expected
+        shortfall are estimated from a t-digest; see TDigestStatistics.
+        The compression can be set by passing an instance, as in
+        <tt>TDigestRiskStatistics(TDigestStatistics(100.0))</tt>.
+    */
+    typedef GenericRiskStatistics<GenericGaussianStatistics<TDigestStatistics> >
+        TDigestRiskStatistics;
+
 
 
     // inline definitions
@@ -52,8 +52,14 @@ namespace QuantLib {
         // typedefs
         typedef StatisticsType statistics_type;
         typedef std::vector<typename StatisticsType::value_type> value_type;
-        // constructor
+        // constructors
         GenericSequenceStatistics(Size dimension = 0);
+        /*! the statistics of each dimension are copies of the given
+            prototype, after it is reset; this allows to set their
+            parameters, such as the compression of a t-digest.
+        */
+        GenericSequenceStatistics(Size dimension,
+                                  const statistics_type& prototype);
         //! \name inspectors
         //@{
         Size size() const { return dimension_; }
@@ -111,6 +117,10 @@ namespace QuantLib {
         //! \name Modifiers
         //@{
         void reset(Size dimension = 0);
+        /*! adds the data collected by another instance; the
+            underlying statistics class must provide a merge method.
+        */
+        void merge(const GenericSequenceStatistics& other);
         template <class Sequence>
         void add(const Sequence& sample,
                  Real weight = 1.0) {
@@ -142,6 +152,7 @@ namespace QuantLib {
         //@}
       protected:
         Size dimension_;
+        statistics_type prototype_;
         std::vector<statistics_type> stats_;
         mutable std::vector<Real> results_;
         Matrix quadraticSum_;
@@ -153,6 +164,7 @@ namespace QuantLib {
     */
     typedef GenericSequenceStatistics<Statistics> SequenceStatistics;
     typedef GenericSequenceStatistics<IncrementalStatistics> SequenceStatisticsInc;
+    typedef GenericSequenceStatistics<TDigestRiskStatistics> SequenceStatisticsTDigest;
 
     // inline definitions
 
@@ -162,6 +174,15 @@ namespace QuantLib {
         reset(dimension);
     }
 
+    template <class Stat>
+    inline GenericSequenceStatistics<Stat>::GenericSequenceStatistics(
+                                                Size dimension,
+                                                const Stat& prototype)
+    : dimension_(0), prototype_(prototype) {
+        prototype_.reset();
+        reset(dimension);
+    }
+
     template <class Stat>
     inline Size GenericSequenceStatistics<Stat>::samples() const {
         return (stats_.size() == 0) ? 0 : stats_[0].samples();
@@ -235,7 +256,7 @@ namespace QuantLib {
                     stats_[i].reset();
             } else {
                 dimension_ = dimension;
-                stats_ = std::vector<Stat>(dimension);
+                stats_ = std::vector<Stat>(dimension, prototype_);
                 results_ = std::vector<Real>(dimension);
             }
             quadraticSum_ = Matrix(dimension_, dimension_, 0.0);
@@ -244,6 +265,21 @@ namespace QuantLib {
         }
     }
 
+    template <class Stat>
+    void GenericSequenceStatistics<Stat>::merge(
+                                const GenericSequenceStatistics<Stat>& other) {
+        if (other.dimension_ == 0)
+            return;
+        if (dimension_ == 0)
+            reset(other.dimension_);
+        QL_REQUIRE(dimension_ == other.dimension_,
+                   "dimension mismatch: " << dimension_ <<
+                   " required, " << other.dimension_ << " provided");
+        quadraticSum_ += other.quadraticSum_;
+        for (Size i=0; i<dimension_; ++i)
+            stats_[i].merge(other.stats_[i]);
+    }
+
     template <class Stat>
     Matrix GenericSequenceStatistics<Stat>::covariance() const {
         Real sampleWeight = weightSum();
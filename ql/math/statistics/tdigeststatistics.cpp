@@ -0,0 +1,255 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/statistics/tdigeststatistics.hpp>
+#include <ql/mathconstants.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace QuantLib {
+
+    TDigestStatistics::TDigestStatistics(Real compression)
+    : compression_(compression) {
+        QL_REQUIRE(compression_ >= 10.0,
+                   "compression (" << compression_
+                   << ") must be at least 10");
+        bufferSize_ = static_cast<Size>(5.0*compression_);
+        reset();
+    }
+
+    Real TDigestStatistics::mean() const {
+        QL_REQUIRE(weightSum_ > 0.0, "empty sample set");
+        return mean_;
+    }
+
+    Real TDigestStatistics::variance() const {
+        Size N = samples();
+        QL_REQUIRE(N > 1, "sample number <=1, unsufficient");
+        QL_REQUIRE(weightSum_ > 0.0, "empty sample set");
+        return (m2_/weightSum_) * (N/(N-1.0));
+    }
+
+    Real TDigestStatistics::standardDeviation() const {
+        return std::sqrt(variance());
+    }
+
+    Real TDigestStatistics::errorEstimate() const {
+        return std::sqrt(variance()/samples());
+    }
+
+    Real TDigestStatistics::skewness() const {
+        Size N = samples();
+        QL_REQUIRE(N > 2, "sample number <=2, unsufficient");
+        Real x = m3_/weightSum_;
+        Real sigma = standardDeviation();
+        return (x/(sigma*sigma*sigma)) * (N/(N-1.0)) * (N/(N-2.0));
+    }
+
+    Real TDigestStatistics::kurtosis() const {
+        Size N = samples();
+        QL_REQUIRE(N > 3, "sample number <=3, unsufficient");
+        Real x = m4_/weightSum_;
+        Real sigma2 = variance();
+        Real c1 = (N/(N-1.0)) * (N/(N-2.0)) * ((N+1.0)/(N-3.0));
+        Real c2 = 3.0 * ((N-1.0)/(N-2.0)) * ((N-1.0)/(N-3.0));
+        return c1*(x/(sigma2*sigma2)) - c2;
+    }
+
+    Real TDigestStatistics::min() const {
+        QL_REQUIRE(samples() > 0, "empty sample set");
+        return min_;
+    }
+
+    Real TDigestStatistics::max() const {
+        QL_REQUIRE(samples() > 0, "empty sample set");
+        return max_;
+    }
+
+    Real TDigestStatistics::percentile(Real percent) const {
+        QL_REQUIRE(percent > 0.0 && percent <= 1.0,
+                   "percentile (" << percent << ") must be in (0.0, 1.0]");
+        QL_REQUIRE(weightSum_ > 0.0, "empty sample set");
+        compress();
+        return quantile(percent * weightSum_);
+    }
+
+    Real TDigestStatistics::topPercentile(Real percent) const {
+        QL_REQUIRE(percent > 0.0 && percent <= 1.0,
+                   "percentile (" << percent << ") must be in (0.0, 1.0]");
+        QL_REQUIRE(weightSum_ > 0.0, "empty sample set");
+        compress();
+        return quantile((1.0 - percent) * weightSum_);
+    }
+
+    Size TDigestStatistics::centroids() const {
+        compress();
+        return centroids_.size();
+    }
+
+    void TDigestStatistics::add(Real value, Real weight) {
+        QL_REQUIRE(weight >= 0.0, "negative weight (" << weight
+                   << ") not allowed");
+        if (samples_ == 0) {
+            min_ = max_ = value;
+        } else {
+            min_ = std::min(value, min_);
+            max_ = std::max(value, max_);
+        }
+        ++samples_;
+        if (weight == 0.0)
+            return;
+
+        combine(weight, value, 0.0, 0.0, 0.0);
+
+        Centroid c = { value, weight, 1 };
+        addCentroid(c);
+    }
+
+    void TDigestStatistics::merge(const TDigestStatistics& other) {
+        if (&other == this) {
+            TDigestStatistics copy(other);
+            merge(copy);
+            return;
+        }
+        if (other.samples_ == 0)
+            return;
+        if (samples_ == 0) {
+            min_ = other.min_;
+            max_ = other.max_;
+        } else {
+            min_ = std::min(other.min_, min_);
+            max_ = std::max(other.max_, max_);
+        }
+        samples_ += other.samples_;
+        if (other.weightSum_ == 0.0)
+            return;
+
+        combine(other.weightSum_, other.mean_,
+                other.m2_, other.m3_, other.m4_);
+
+        for (const auto& c : other.centroids_)
+            addCentroid(c);
+        for (const auto& c : other.buffer_)
+            addCentroid(c);
+    }
+
+    void TDigestStatistics::reset() {
+        centroids_.clear();
+        buffer_.clear();
+        samples_ = 0;
+        weightSum_ = mean_ = m2_ = m3_ = m4_ = 0.0;
+        min_ = max_ = Null<Real>();
+    }
+
+    void TDigestStatistics::combine(Real wB, Real meanB,
+                                    Real m2B, Real m3B, Real m4B) {
+        // pairwise update of the central moments (Pebay, 2008)
+        Real wA = weightSum_, W = wA + wB;
+        Real delta = meanB - mean_, delta2 = delta*delta;
+        Real m2 = m2_ + m2B + delta2*wA*wB/W;
+        Real m3 = m3_ + m3B + delta*delta2*wA*wB*(wA-wB)/(W*W)
+            + 3.0*delta*(wA*m2B - wB*m2_)/W;
+        Real m4 = m4_ + m4B
+            + delta2*delta2*wA*wB*(wA*wA - wA*wB + wB*wB)/(W*W*W)
+            + 6.0*delta2*(wA*wA*m2B + wB*wB*m2_)/(W*W)
+            + 4.0*delta*(wA*m3B - wB*m3_)/W;
+        mean_ += delta*wB/W;
+        m2_ = m2;
+        m3_ = m3;
+        m4_ = m4;
+        weightSum_ = W;
+    }
+
+    void TDigestStatistics::addCentroid(const Centroid& c) {
+        buffer_.push_back(c);
+        if (buffer_.size() >= bufferSize_)
+            compress();
+    }
+
+    void TDigestStatistics::compress() const {
+        if (buffer_.empty())
+            return;
+
+        buffer_.insert(buffer_.end(), centroids_.begin(), centroids_.end());
+        std::sort(buffer_.begin(), buffer_.end(),
+                  [](const Centroid& a, const Centroid& b) {
+                      return a.mean < b.mean;
+                  });
+        centroids_.clear();
+
+        // The buffered centroids are merged from left to right as long
+        // as the merged centroid spans at most one unit of the k_1 scale
+        // function k(q) = delta/(2 pi) asin(2q-1), which keeps the
+        // centroids small in the tails.
+        Real total = 0.0;
+        for (const auto& c : buffer_)
+            total += c.weight;
+        Centroid current = buffer_[0];
+        Real integral = 0.0, limit = total * weightLimit(0.0);
+        for (Size i=1; i<buffer_.size(); ++i) {
+            const Centroid& next = buffer_[i];
+            if (integral + current.weight + next.weight <= limit) {
+                current.weight += next.weight;
+                current.mean += (next.mean - current.mean)
+                    * next.weight / current.weight;
+                current.count += next.count;
+            } else {
+                integral += current.weight;
+                centroids_.push_back(current);
+                limit = total * weightLimit(integral/total);
+                current = next;
+            }
+        }
+        centroids_.push_back(current);
+        buffer_.clear();
+    }
+
+    Real TDigestStatistics::weightLimit(Real q) const {
+        // q(k(q) + 1), i.e., the largest quantile that a centroid
+        // starting at q can reach
+        Real k = compression_/M_TWOPI * std::asin(2.0*q-1.0) + 1.0;
+        if (k >= compression_/4.0)
+            return 1.0;
+        return 0.5 * (1.0 + std::sin(M_TWOPI*k/compression_));
+    }
+
+    Real TDigestStatistics::quantile(Real target) const {
+        // Each centroid is located at the midpoint of its cumulative
+        // weight and the quantile is interpolated linearly between
+        // neighboring centroids, or between the outer centroids and
+        // the minimum and maximum; single samples are returned exactly.
+        Size n = centroids_.size();
+        Real integral = 0.0, previousMean = min_, previousCenter = 0.0;
+        for (Size i=0; i<n; ++i) {
+            const Centroid& c = centroids_[i];
+            if (c.count == 1 && target <= integral + c.weight)
+                return c.mean;
+            Real center = integral + 0.5*c.weight;
+            if (target <= center)
+                return previousMean + (c.mean - previousMean)
+                    * (target - previousCenter) / (center - previousCenter);
+            integral += c.weight;
+            previousMean = c.mean;
+            previousCenter = c.count == 1 ? integral : center;
+        }
+        if (integral <= previousCenter)
+            return max_;
+        return previousMean + (max_ - previousMean)
+            * (target - previousCenter) / (integral - previousCenter);
+    }
+
+}
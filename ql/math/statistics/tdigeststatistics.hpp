@@ -0,0 +1,239 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file tdigeststatistics.hpp
+    \brief streaming statistics tool with bounded memory
+*/
+
+#ifndef quantlib_tdigest_statistics_hpp
+#define quantlib_tdigest_statistics_hpp
+
+#include <ql/utilities/null.hpp>
+#include <ql/errors.hpp>
+#include <vector>
+#include <utility>
+
+namespace QuantLib {
+
+    //! Statistics tool with bounded memory
+    /*! This class accumulates a stream of data without storing it.
+        Mean, variance, skewness, kurtosis, minimum and maximum are
+        exact, as they are updated incrementally with numerically
+        stable formulas; percentiles and expectation values are
+        estimated from a merging t-digest (Dunning and Ertl, 2019),
+        i.e., a sorted set of weighted centroids whose size is kept
+        small in the center of the distribution and close to one
+        sample in the tails.
+
+        The compression parameter \f$ \delta \f$ bounds the number of
+        centroids (about \f$ \delta/2 \f$) and thus the memory used,
+        regardless of the number of samples; the error on the
+        \f$ q \f$-th quantile is roughly proportional to
+        \f$ \sqrt{q(1-q)}/\delta \f$, so that tail quantiles such as
+        those used for value-at-risk are estimated most accurately.
+
+        Two instances can be merged, e.g., after accumulating
+        separate batches of samples in different threads.
+    */
+    class TDigestStatistics {
+      public:
+        typedef Real value_type;
+
+        explicit TDigestStatistics(Real compression = 500.0);
+
+        //! \name Inspectors
+        //@{
+        //! number of samples collected
+        Size samples() const { return samples_; }
+
+        //! sum of data weights
+        Real weightSum() const { return weightSum_; }
+
+        /*! returns the mean, defined as
+            \f[ \langle x \rangle = \frac{\sum w_i x_i}{\sum w_i}. \f]
+        */
+        Real mean() const;
+
+        /*! returns the variance, defined as
+            \f[ \frac{N}{N-1} \left\langle \left(
+                x-\langle x \rangle \right)^2 \right\rangle. \f]
+        */
+        Real variance() const;
+
+        /*! returns the standard deviation \f$ \sigma \f$, defined as the
+            square root of the variance.
+        */
+        Real standardDeviation() const;
+
+        /*! returns the error estimate \f$ \epsilon \f$, defined as the
+            square root of the ratio of the variance to the number of
+            samples.
+        */
+        Real errorEstimate() const;
+
+        /*! returns the skewness, defined as
+            \f[ \frac{N^2}{(N-1)(N-2)} \frac{\left\langle \left(
+                x-\langle x \rangle \right)^3 \right\rangle}{\sigma^3}. \f]
+            The above evaluates to 0 for a Gaussian distribution.
+        */
+        Real skewness() const;
+
+        /*! returns the excess kurtosis, defined as
+            \f[ \frac{N^2(N+1)}{(N-1)(N-2)(N-3)}
+                \frac{\left\langle \left(x-\langle x \rangle \right)^4
+                \right\rangle}{\sigma^4} - \frac{3(N-1)^2}{(N-2)(N-3)}. \f]
+            The above evaluates to 0 for a Gaussian distribution.
+        */
+        Real kurtosis() const;
+
+        /*! returns the minimum sample value */
+        Real min() const;
+
+        /*! returns the maximum sample value */
+        Real max() const;
+
+        /*! estimate of the expectation value of a function \f$ f \f$
+            over R, obtained by evaluating it on the centroids.
+        */
+        template <class Func>
+        Real expectationValue(const Func& f) const;
+
+        /*! estimate of the expectation value of a function \f$ f \f$
+            on a given range \f$ \mathcal{R} \f$, obtained by
+            evaluating it on the centroids in the range.  The range
+            is passed as a boolean function returning <tt>true</tt>
+            if the argument belongs to the range or <tt>false</tt>
+            otherwise.
+
+            The function returns a pair made of the result and
+            the number of observations in the centroids in range.
+        */
+        template <class Func, class Predicate>
+        std::pair<Real, Size> expectationValue(const Func& f,
+                                               const Predicate& inRange) const;
+
+        /*! estimate of the \f$ y \f$-th percentile, defined as the
+            value \f$ \bar{x} \f$ such that
+            \f[ y = \frac{\sum_{x_i < \bar{x}} w_i}{
+                          \sum_i w_i} \f]
+
+            \pre \f$ y \f$ must be in the range \f$ (0-1]. \f$
+        */
+        Real percentile(Real y) const;
+
+        /*! estimate of the \f$ y \f$-th top percentile, defined as the
+            value \f$ \bar{x} \f$ such that
+            \f[ y = \frac{\sum_{x_i > \bar{x}} w_i}{
+                          \sum_i w_i} \f]
+
+            \pre \f$ y \f$ must be in the range \f$ (0-1]. \f$
+        */
+        Real topPercentile(Real y) const;
+
+        //! compression parameter of the digest
+        Real compression() const { return compression_; }
+
+        //! number of centroids currently used by the digest
+        Size centroids() const;
+        //@}
+
+        //! \name Modifiers
+        //@{
+        //! adds a datum to the set, possibly with a weight
+        void add(Real value, Real weight = 1.0);
+
+        //! adds a sequence of data to the set, with default weight
+        template <class DataIterator>
+        void addSequence(DataIterator begin, DataIterator end) {
+            for (;begin!=end;++begin)
+                add(*begin);
+        }
+
+        //! adds a sequence of data to the set, each with its weight
+        template <class DataIterator, class WeightIterator>
+        void addSequence(DataIterator begin, DataIterator end,
+                         WeightIterator wbegin) {
+            for (;begin!=end;++begin,++wbegin)
+                add(*begin, *wbegin);
+        }
+
+        /*! adds the data collected by another instance; the result
+            is the same, up to the accuracy of the digest, as if all
+            its samples had been added to this one.
+        */
+        void merge(const TDigestStatistics& other);
+
+        //! resets the data to a null set
+        void reset();
+        //@}
+
+      private:
+        struct Centroid {
+            Real mean, weight;
+            Size count;
+        };
+        void combine(Real weight, Real mean, Real m2, Real m3, Real m4);
+        void addCentroid(const Centroid& c);
+        void compress() const;
+        Real weightLimit(Real q) const;
+        Real quantile(Real target) const;
+
+        Real compression_;
+        Size bufferSize_;
+        mutable std::vector<Centroid> centroids_, buffer_;
+        Size samples_;
+        Real weightSum_, mean_, m2_, m3_, m4_;
+        Real min_, max_;
+    };
+
+
+    // template definitions
+
+    template <class Func>
+    Real TDigestStatistics::expectationValue(const Func& f) const {
+        QL_REQUIRE(weightSum_ > 0.0, "empty sample set");
+        compress();
+        Real num = 0.0;
+        for (const auto& c : centroids_)
+            num += f(c.mean) * c.weight;
+        return num / weightSum_;
+    }
+
+    template <class Func, class Predicate>
+    std::pair<Real, Size>
+    TDigestStatistics::expectationValue(const Func& f,
+                                        const Predicate& inRange) const {
+        compress();
+        Real num = 0.0, den = 0.0;
+        Size N = 0;
+        for (const auto& c : centroids_) {
+            if (inRange(c.mean)) {
+                num += f(c.mean) * c.weight;
+                den += c.weight;
+                N += c.count;
+            }
+        }
+        if (N == 0)
+            return std::make_pair<Real, Size>(Null<Real>(), 0);
+        else
+            return std::make_pair(num / den, N);
+    }
+
+}
+
+
+#endif
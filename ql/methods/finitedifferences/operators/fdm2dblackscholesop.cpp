@@ -151,6 +151,45 @@ namespace QuantLib {
         return solve_splitting(0, r, dt);
     }
 
+    void Fdm2dBlackScholesOp::apply_into(const Array& x, Array& out) const {
+        apply_mixed_into(x, out);
+        opX_.add_apply_into(x, out);
+        opY_.add_apply_into(x, out);
+    }
+
+    void Fdm2dBlackScholesOp::apply_mixed_into(
+                                        const Array& x, Array& out) const {
+        corrMapT_.apply_into(x, out);
+        for (Size i=0; i < x.size(); ++i)
+            out[i] += currentForwardRate_*x[i];
+    }
+
+    void Fdm2dBlackScholesOp::apply_direction_into(
+                           Size direction, const Array& x, Array& out) const {
+        if (direction == 0) {
+            opX_.apply_into(x, out);
+        }
+        else if (direction == 1) {
+            opY_.apply_into(x, out);
+        }
+        else {
+            QL_FAIL("direction is too large");
+        }
+    }
+
+    void Fdm2dBlackScholesOp::solve_splitting_into(
+                Size direction, const Array& x, Real s, Array& out,
+                Array& work) const {
+        if (direction == 0) {
+            opX_.solve_splitting_into(direction, x, s, out, work);
+        }
+        else if (direction == 1) {
+            opY_.solve_splitting_into(direction, x, s, out, work);
+        }
+        else
+            QL_FAIL("direction is too large");
+    }
+
     std::vector<SparseMatrix> 
     Fdm2dBlackScholesOp::toMatrixDecomp() const {
         std::vector<SparseMatrix> retVal(3);
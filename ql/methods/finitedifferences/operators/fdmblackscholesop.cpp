@@ -25,6 +25,7 @@
 #include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
 #include <ql/methods/finitedifferences/operators/fdmblackscholesop.hpp>
 #include <ql/methods/finitedifferences/operators/secondderivativeop.hpp>
+#include <algorithm>
 namespace QuantLib {
 
     FdmBlackScholesOp::FdmBlackScholesOp(
@@ -126,6 +127,41 @@ namespace QuantLib {
         return solve_splitting(direction_, r, dt);
     }
 
+    void FdmBlackScholesOp::apply_into(const Array& r, Array& out) const {
+        mapT_.apply_into(r, out);
+    }
+
+    void FdmBlackScholesOp::add_apply_into(const Array& r, Array& out) const {
+        mapT_.add_apply_into(r, out);
+    }
+
+    void FdmBlackScholesOp::apply_mixed_into(const Array& r, Array& out) const {
+        QL_REQUIRE(out.size() == r.size(), "inconsistent length of output");
+        std::fill(out.begin(), out.end(), 0.0);
+    }
+
+    void FdmBlackScholesOp::apply_direction_into(
+        Size direction, const Array& r, Array& out) const {
+        if (direction == direction_)
+            mapT_.apply_into(r, out);
+        else {
+            QL_REQUIRE(out.size() == r.size(),
+                       "inconsistent length of output");
+            std::fill(out.begin(), out.end(), 0.0);
+        }
+    }
+
+    void FdmBlackScholesOp::solve_splitting_into(
+        Size direction, const Array& r, Real a, Array& out, Array& work) const {
+        if (direction == direction_)
+            mapT_.solve_splitting_into(r, a, 1.0, out, work);
+        else {
+            QL_REQUIRE(out.size() == r.size(),
+                       "inconsistent length of output");
+            std::copy(r.begin(), r.end(), out.begin());
+        }
+    }
+
     std::vector<SparseMatrix> 
     FdmBlackScholesOp::toMatrixDecomp() const {
         std::vector<SparseMatrix> retVal(1, mapT_.toMatrix());
@@ -55,6 +55,14 @@ namespace QuantLib {
                                           const Array& r, Real s) const;
         Array preconditioner(const Array& r, Real s) const;
 
+        void apply_into(const Array& r, Array& out) const;
+        void add_apply_into(const Array& r, Array& out) const;
+        void apply_mixed_into(const Array& r, Array& out) const;
+        void apply_direction_into(Size direction,
+                                  const Array& r, Array& out) const;
+        void solve_splitting_into(Size direction, const Array& r,
+                                  Real s, Array& out, Array& work) const;
+
         std::vector<SparseMatrix>  toMatrixDecomp() const;
       private:
         const std::shared_ptr<FdmMesher> mesher_;
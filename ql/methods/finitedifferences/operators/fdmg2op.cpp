@@ -27,6 +27,7 @@
 #include <ql/methods/finitedifferences/operators/firstderivativeop.hpp>
 #include <ql/methods/finitedifferences/operators/secondderivativeop.hpp>
 #include <ql/methods/finitedifferences/operators/secondordermixedderivativeop.hpp>
+#include <algorithm>
 
 
 namespace QuantLib {
@@ -113,6 +114,46 @@ namespace QuantLib {
         return solve_splitting(direction1_, r, dt);
     }
 
+    void FdmG2Op::apply_into(const Array& r, Array& out) const {
+        apply_mixed_into(r, out);
+        mapX_.add_apply_into(r, out);
+        mapY_.add_apply_into(r, out);
+    }
+
+    void FdmG2Op::apply_mixed_into(const Array& r, Array& out) const {
+        corrMap_.apply_into(r, out);
+    }
+
+    void FdmG2Op::apply_direction_into(
+        Size direction, const Array& r, Array& out) const {
+        if (direction == direction1_) {
+            mapX_.apply_into(r, out);
+        }
+        else if (direction == direction2_) {
+            mapY_.apply_into(r, out);
+        }
+        else {
+            QL_REQUIRE(out.size() == r.size(),
+                       "inconsistent length of output");
+            std::fill(out.begin(), out.end(), 0.0);
+        }
+    }
+
+    void FdmG2Op::solve_splitting_into(
+        Size direction, const Array& r, Real a, Array& out, Array& work) const {
+        if (direction == direction1_) {
+            mapX_.solve_splitting_into(r, a, 1.0, out, work);
+        }
+        else if (direction == direction2_) {
+            mapY_.solve_splitting_into(r, a, 1.0, out, work);
+        }
+        else {
+            QL_REQUIRE(out.size() == r.size(),
+                       "inconsistent length of output");
+            std::fill(out.begin(), out.end(), 0.0);
+        }
+    }
+
     std::vector<SparseMatrix>  FdmG2Op::toMatrixDecomp() const {
         std::vector<SparseMatrix> retVal(3);
         retVal[0] = mapX_.toMatrix();
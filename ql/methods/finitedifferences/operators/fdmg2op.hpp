@@ -51,6 +51,13 @@ namespace QuantLib {
             solve_splitting(Size direction, const Array& r, Real s) const;
         Array preconditioner(const Array& r, Real s) const;
 
+        void apply_into(const Array& r, Array& out) const;
+        void apply_mixed_into(const Array& r, Array& out) const;
+        void apply_direction_into(Size direction,
+                                  const Array& r, Array& out) const;
+        void solve_splitting_into(Size direction, const Array& r,
+                                  Real s, Array& out, Array& work) const;
+
         std::vector<SparseMatrix>  toMatrixDecomp() const;
       private:
         const Size direction1_, direction2_;
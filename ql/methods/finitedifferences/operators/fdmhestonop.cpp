@@ -69,6 +69,19 @@ namespace QuantLib {
                 volatilityValues_, t1, t2),
                 dxMap_, dxxMap_, Array(1, -0.5*r));
         }
+        else if (!leverageFct_) {
+            // L is identically one, hence neither the drift nor the
+            // diffusion operator need to be rescaled
+            const Size n = varianceValues_.size();
+            if (L_.size() != n) {
+                L_ = Array(n, 1.0);
+                drift_ = Array(n);
+            }
+            for (Size i=0; i < n; ++i)
+                drift_[i] = r - q - varianceValues_[i];
+
+            mapT_.axpyb(drift_, dxMap_, dxxMap_, Array(1, -0.5*r));
+        }
         else {
             L_ = getLeverageFctSlice(t1, t2);
             const Array Lsquare = L_*L_;
@@ -201,6 +214,40 @@ namespace QuantLib {
         return solve_splitting(0, r, dt);
     }
 
+    void FdmHestonOp::apply_into(const Array& u, Array& out) const {
+        apply_mixed_into(u, out);
+        dyMap_.getMap().add_apply_into(u, out);
+        dxMap_.getMap().add_apply_into(u, out);
+    }
+
+    void FdmHestonOp::apply_direction_into(Size direction,
+                                           const Array& r, Array& out) const {
+        if (direction == 0)
+            dxMap_.getMap().apply_into(r, out);
+        else if (direction == 1)
+            dyMap_.getMap().apply_into(r, out);
+        else
+            QL_FAIL("direction too large");
+    }
+
+    void FdmHestonOp::apply_mixed_into(const Array& r, Array& out) const {
+        correlationMap_.apply_into(r, out);
+        out *= dxMap_.getL();
+    }
+
+    void FdmHestonOp::solve_splitting_into(Size direction, const Array& r,
+                                           Real a, Array& out,
+                                           Array& work) const {
+        if (direction == 0) {
+            dxMap_.getMap().solve_splitting_into(r, a, 1.0, out, work);
+        }
+        else if (direction == 1) {
+            dyMap_.getMap().solve_splitting_into(r, a, 1.0, out, work);
+        }
+        else
+            QL_FAIL("direction too large");
+    }
+
     std::vector<SparseMatrix> 
     FdmHestonOp::toMatrixDecomp() const {
         std::vector<SparseMatrix> retVal(3);
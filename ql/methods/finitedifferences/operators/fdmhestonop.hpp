@@ -54,7 +54,7 @@ namespace QuantLib {
       protected:
         Array getLeverageFctSlice(Time t1, Time t2) const;
 
-        Array varianceValues_, volatilityValues_, L_;
+        Array varianceValues_, volatilityValues_, L_, drift_;
         const FirstDerivativeOp  dxMap_;
         const TripleBandLinearOp dxxMap_;
         TripleBandLinearOp mapT_;
@@ -105,6 +105,13 @@ namespace QuantLib {
                                           const Array& r, Real s) const;
         Array preconditioner(const Array& r, Real s) const;
 
+        void apply_into(const Array& r, Array& out) const;
+        void apply_mixed_into(const Array& r, Array& out) const;
+        void apply_direction_into(Size direction,
+                                  const Array& r, Array& out) const;
+        void solve_splitting_into(Size direction, const Array& r,
+                                  Real s, Array& out, Array& work) const;
+
         std::vector<SparseMatrix>  toMatrixDecomp() const;
       private:
         NinePointLinearOp correlationMap_;
@@ -26,6 +26,7 @@
 #include <ql/methods/finitedifferences/operators/fdmhullwhiteop.hpp>
 #include <ql/methods/finitedifferences/operators/firstderivativeop.hpp>
 #include <ql/methods/finitedifferences/operators/secondderivativeop.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -94,6 +95,37 @@ namespace QuantLib {
         return solve_splitting(direction_, r, dt);
     }
 
+    void FdmHullWhiteOp::apply_into(const Array& r, Array& out) const {
+        mapT_.apply_into(r, out);
+    }
+
+    void FdmHullWhiteOp::apply_mixed_into(const Array& r, Array& out) const {
+        QL_REQUIRE(out.size() == r.size(), "inconsistent length of output");
+        std::fill(out.begin(), out.end(), 0.0);
+    }
+
+    void FdmHullWhiteOp::apply_direction_into(
+        Size direction, const Array& r, Array& out) const {
+        if (direction == direction_)
+            mapT_.apply_into(r, out);
+        else {
+            QL_REQUIRE(out.size() == r.size(),
+                       "inconsistent length of output");
+            std::fill(out.begin(), out.end(), 0.0);
+        }
+    }
+
+    void FdmHullWhiteOp::solve_splitting_into(
+        Size direction, const Array& r, Real a, Array& out, Array& work) const {
+        if (direction == direction_)
+            mapT_.solve_splitting_into(r, a, 1.0, out, work);
+        else {
+            QL_REQUIRE(out.size() == r.size(),
+                       "inconsistent length of output");
+            std::fill(out.begin(), out.end(), 0.0);
+        }
+    }
+
     std::vector<SparseMatrix> 
     FdmHullWhiteOp::toMatrixDecomp() const {
         std::vector<SparseMatrix> retVal(1, mapT_.toMatrix());
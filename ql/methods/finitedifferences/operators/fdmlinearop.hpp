@@ -36,6 +36,20 @@ namespace QuantLib {
         typedef Array array_type;
         virtual ~FdmLinearOp() { }
         virtual array_type apply(const array_type& r) const = 0;
+        //! writes the result of apply() into a caller-owned array
+        /*! Operators used within time-stepping loops override this
+            method in order to avoid heap allocations. \c r and
+            \c out must not refer to the same array.
+        */
+        virtual void apply_into(const array_type& r, array_type& out) const {
+            out = apply(r);
+        }
+        //! adds the result of apply() to a caller-owned array
+        /*! \c r and \c out must not refer to the same array. */
+        virtual void add_apply_into(const array_type& r,
+                                    array_type& out) const {
+            out += apply(r);
+        }
 
         virtual SparseMatrix toMatrix() const = 0;
     };
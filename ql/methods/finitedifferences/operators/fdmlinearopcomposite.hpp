@@ -49,6 +49,30 @@ namespace QuantLib {
         virtual Array 
             preconditioner(const Array& r, Real s) const = 0;
 
+        /*! \name in-place variants
+
+            These methods write their result into a caller-owned
+            array; \c r and \c out must not refer to the same array,
+            except for solve_splitting_into(), which also takes a
+            caller-owned workspace \c work of the same size, distinct
+            from both.  The default implementations forward to the
+            allocating methods.
+        */
+        //@{
+        virtual void apply_mixed_into(const Array& r, Array& out) const {
+            out = apply_mixed(r);
+        }
+        virtual void apply_direction_into(Size direction,
+                                          const Array& r, Array& out) const {
+            out = apply_direction(direction, r);
+        }
+        virtual void solve_splitting_into(Size direction, const Array& r,
+                                          Real s, Array& out,
+                                          Array& /*work*/) const {
+            out = solve_splitting(direction, r, s);
+        }
+        //@}
+
         virtual std::vector<SparseMatrix>  toMatrixDecomp() const {
             QL_FAIL("FdmLinearOpComposite::toMatrixDecomp not implemented");
         }
@@ -27,6 +27,7 @@
 #include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
 #include <ql/methods/finitedifferences/operators/fdmornsteinuhlenbeckop.hpp>
 #include <ql/methods/finitedifferences/operators/secondderivativeop.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -111,6 +112,37 @@ namespace QuantLib {
         return solve_splitting(direction_, r, dt);
     }
 
+    void FdmOrnsteinUhlenbackOp::apply_into(const Array& r, Array& out) const {
+        mapX_.apply_into(r, out);
+    }
+
+    void FdmOrnsteinUhlenbackOp::apply_mixed_into(const Array& r, Array& out) const {
+        QL_REQUIRE(out.size() == r.size(), "inconsistent length of output");
+        std::fill(out.begin(), out.end(), 0.0);
+    }
+
+    void FdmOrnsteinUhlenbackOp::apply_direction_into(
+        Size direction, const Array& r, Array& out) const {
+        if (direction == direction_)
+            mapX_.apply_into(r, out);
+        else {
+            QL_REQUIRE(out.size() == r.size(),
+                       "inconsistent length of output");
+            std::fill(out.begin(), out.end(), 0.0);
+        }
+    }
+
+    void FdmOrnsteinUhlenbackOp::solve_splitting_into(
+        Size direction, const Array& r, Real a, Array& out, Array& work) const {
+        if (direction == direction_)
+            mapX_.solve_splitting_into(r, a, 1.0, out, work);
+        else {
+            QL_REQUIRE(out.size() == r.size(),
+                       "inconsistent length of output");
+            std::copy(r.begin(), r.end(), out.begin());
+        }
+    }
+
     std::vector<SparseMatrix> 
     FdmOrnsteinUhlenbackOp::toMatrixDecomp() const {
         std::vector<SparseMatrix> retVal(1, mapX_.toMatrix());
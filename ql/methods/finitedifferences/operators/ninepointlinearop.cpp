@@ -73,11 +73,21 @@ namespace QuantLib {
     Array NinePointLinearOp::apply(const Array& u)
         const {
 
+        Array retVal(u.size());
+        apply_into(u, retVal);
+        return retVal;
+    }
+
+    void NinePointLinearOp::apply_into(const Array& u, Array& retVal)
+        const {
+
         const std::shared_ptr<FdmLinearOpLayout> index=mesher_->layout();
         QL_REQUIRE(u.size() == index->size(),"inconsistent length of r "
                     << u.size() << " vs " << index->size());
+        QL_REQUIRE(retVal.size() == u.size(), "inconsistent length of output");
+        QL_REQUIRE(&retVal != &u,
+                   "input and output must not be the same array");
 
-        Array retVal(u.size());
         // #pragma omp parallel for
         for (Size i=0; i < retVal.size(); ++i) {
             retVal[i] =   a00_[i]*u[i00_[i]]
@@ -90,7 +100,6 @@ namespace QuantLib {
                         + a21_[i]*u[i21_[i]]
                         + a22_[i]*u[i22_[i]];
         }
-        return retVal;
     }
 
     SparseMatrix NinePointLinearOp::toMatrix() const {
@@ -39,6 +39,7 @@ namespace QuantLib {
                 const std::shared_ptr<FdmMesher>& mesher);
 
         Array apply(const Array& r) const;
+        void apply_into(const Array& r, Array& out) const;
         NinePointLinearOp mult(const Array& u) const;
 
         void swap(NinePointLinearOp& m);
@@ -237,18 +237,35 @@ namespace QuantLib {
     }
 
     Array TripleBandLinearOp::apply(const Array &r) const {
+        array_type retVal(r.size());
+        apply_into(r, retVal);
+
+        return retVal;
+    }
+
+    void TripleBandLinearOp::apply_into(const Array &r, Array &out) const {
         const std::shared_ptr<FdmLinearOpLayout> index = mesher_->layout();
 
         QL_REQUIRE(r.size() == index->size(), "inconsistent length of r");
+        QL_REQUIRE(out.size() == r.size(), "inconsistent length of output");
+        QL_REQUIRE(&out != &r, "input and output must not be the same array");
 
-
-        array_type retVal(r.size());
         // #pragma omp parallel for
         for (Size i = 0; i < index->size(); ++i) {
-            retVal[i] = r[i0_[i]] * lower_[i] + r[i] * diag_[i] + r[i2_[i]] * upper_[i];
+            out[i] = r[i0_[i]] * lower_[i] + r[i] * diag_[i] + r[i2_[i]] * upper_[i];
         }
+    }
 
-        return retVal;
+    void TripleBandLinearOp::add_apply_into(const Array &r, Array &out) const {
+        const std::shared_ptr<FdmLinearOpLayout> index = mesher_->layout();
+
+        QL_REQUIRE(r.size() == index->size(), "inconsistent length of r");
+        QL_REQUIRE(out.size() == r.size(), "inconsistent length of output");
+        QL_REQUIRE(&out != &r, "input and output must not be the same array");
+
+        for (Size i = 0; i < index->size(); ++i) {
+            out[i] += r[i0_[i]] * lower_[i] + r[i] * diag_[i] + r[i2_[i]] * upper_[i];
+        }
     }
 
     SparseMatrix TripleBandLinearOp::toMatrix() const {
@@ -268,6 +285,25 @@ namespace QuantLib {
 
     Array
     TripleBandLinearOp::solve_splitting(const Array &r, Real a, Real b) const {
+        Array retVal(r.size()), tmp(r.size());
+        solve_splitting(r, a, b, retVal, tmp);
+
+        return retVal;
+    }
+
+    void TripleBandLinearOp::solve_splitting_into(const Array &r, Real a,
+                                                  Real b, Array &out,
+                                                  Array &work) const {
+        QL_REQUIRE(out.size() == r.size(), "inconsistent length of output");
+        QL_REQUIRE(work.size() == r.size(), "inconsistent length of workspace");
+        QL_REQUIRE(&work != &r && &work != &out,
+                   "workspace must not be the input or output array");
+
+        solve_splitting(r, a, b, out, work);
+    }
+
+    void TripleBandLinearOp::solve_splitting(const Array &r, Real a, Real b,
+                                             Array &retVal, Array &tmp) const {
         const std::shared_ptr<FdmLinearOpLayout> layout = mesher_->layout();
         QL_REQUIRE(r.size() == layout->size(), "inconsistent size of rhs");
 
@@ -282,12 +318,11 @@ namespace QuantLib {
         }
 #endif
 
-        Array retVal(r.size()), tmp(r.size());
-
-
         // Thomson algorithm to solve a tridiagonal system.
         // Example code taken from Tridiagonalopertor and
         // changed to fit for the triple band operator.
+        // Each element of r is read before the element of retVal with
+        // the same index is written, hence r and retVal can coincide.
         Size rim1 = reverseIndex_[0];
         Real bet = 1.0 / (a * diag_[rim1] + b);
         QL_REQUIRE(bet != 0.0, "division by zero");
@@ -308,7 +343,5 @@ namespace QuantLib {
         for (Size j = layout->size() - 2; j > 0; --j)
             retVal[reverseIndex_[j]] -= tmp[j + 1] * retVal[reverseIndex_[j + 1]];
         retVal[reverseIndex_[0]] -= tmp[1] * retVal[reverseIndex_[1]];
-
-        return retVal;
     }
 }
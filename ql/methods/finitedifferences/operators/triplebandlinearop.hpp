@@ -42,6 +42,16 @@ namespace QuantLib {
         Array solve_splitting(const Array& r, Real a,
                                           Real b = 1.0) const;
 
+        //! \c r and \c out must not refer to the same array
+        void apply_into(const Array& r, Array& out) const;
+        //! \c r and \c out must not refer to the same array
+        void add_apply_into(const Array& r, Array& out) const;
+        /*! \c r and \c out can refer to the same array; \c work is a
+            caller-owned workspace of the same size, distinct from both.
+        */
+        void solve_splitting_into(const Array& r, Real a, Real b,
+                                  Array& out, Array& work) const;
+
         TripleBandLinearOp mult(const Array& u) const;
         // interpret u as the diagonal of a diagonal matrix, multiplied on LHS
         TripleBandLinearOp multR(const Array& u) const;
@@ -60,6 +70,9 @@ namespace QuantLib {
       protected:
         TripleBandLinearOp() {}
 
+        void solve_splitting(const Array& r, Real a, Real b,
+                             Array& out, Array& tmp) const;
+
         Size direction_;
         std::vector<Size> i0_, i2_;
         std::vector<Size> reverseIndex_;
@@ -55,6 +55,9 @@ namespace QuantLib {
         const Real mu_;
         const std::shared_ptr<FdmLinearOpComposite> map_;
         const BoundaryConditionSchemeHelper bcSet_;
+
+        // workspace reused by step() in order to avoid allocations
+        Array y_, y0_, yt_, diff_, work_, tmp_;
     };
 }
 
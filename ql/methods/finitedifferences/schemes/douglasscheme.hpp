@@ -54,6 +54,9 @@ namespace QuantLib {
         const Real theta_;
         const std::shared_ptr<FdmLinearOpComposite> map_;
         const BoundaryConditionSchemeHelper bcSet_;
+
+        // workspace reused by step() in order to avoid allocations
+        Array y_, work_, tmp_;
     };
 }
 
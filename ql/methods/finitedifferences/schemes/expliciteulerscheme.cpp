@@ -30,11 +30,16 @@ namespace QuantLib {
 
     void ExplicitEulerScheme::step(array_type& a, Time t) {
         QL_REQUIRE(t-dt_ > -1e-8, "a step towards negative time given");
-        map_->setTime(std::max(0.0, t - dt_), t);
+        map_->setTime(std::max(0.0, t-dt_), t);
         bcSet_.setTime(std::max(0.0, t-dt_));
 
+        if (work_.size() != a.size())
+            work_ = Array(a.size());
+
         bcSet_.applyBeforeApplying(*map_);
-        a += dt_ * map_->apply(a);
+        map_->apply_into(a, work_);
+        for (Size j=0; j < a.size(); ++j)
+            a[j] += dt_*work_[j];
         bcSet_.applyAfterApplying(a);
     }
 
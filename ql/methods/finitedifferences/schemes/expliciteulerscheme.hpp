@@ -53,6 +53,9 @@ namespace QuantLib {
         Time dt_;
         const std::shared_ptr<FdmLinearOpComposite> map_;
         const BoundaryConditionSchemeHelper bcSet_;
+
+        // workspace reused by step() in order to avoid allocations
+        Array work_;
     };
 }
 
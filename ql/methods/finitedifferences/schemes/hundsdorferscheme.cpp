@@ -40,28 +40,45 @@ namespace QuantLib {
         map_->setTime(std::max(0.0, t-dt_), t);
         bcSet_.setTime(std::max(0.0, t-dt_));
 
+        const Size n = a.size();
+        if (y_.size() != n) {
+            y_ = y0_ = yt_ = Array(n);
+            diff_ = work_ = tmp_ = Array(n);
+        }
+
         bcSet_.applyBeforeApplying(*map_);
-        Array y = a + dt_*map_->apply(a);
-        bcSet_.applyAfterApplying(y);
+        map_->apply_into(a, work_);
+        for (Size j=0; j < n; ++j)
+            y_[j] = a[j] + dt_*work_[j];
+        bcSet_.applyAfterApplying(y_);
 
-        Array y0 = y;
+        y0_ = y_;
 
         for (Size i=0; i < map_->size(); ++i) {
-            Array rhs = y - theta_*dt_*map_->apply_direction(i, a);
-            y = map_->solve_splitting(i, rhs, -theta_*dt_);
+            map_->apply_direction_into(i, a, work_);
+            for (Size j=0; j < n; ++j)
+                work_[j] = y_[j] - theta_*dt_*work_[j];
+            map_->solve_splitting_into(i, work_, -theta_*dt_, y_, tmp_);
         }
 
+        for (Size j=0; j < n; ++j)
+            diff_[j] = y_[j] - a[j];
+
         bcSet_.applyBeforeApplying(*map_);
-        Array yt = y0 + mu_*dt_*map_->apply(y-a);
-        bcSet_.applyAfterApplying(yt);
+        map_->apply_into(diff_, work_);
+        for (Size j=0; j < n; ++j)
+            yt_[j] = y0_[j] + mu_*dt_*work_[j];
+        bcSet_.applyAfterApplying(yt_);
 
         for (Size i=0; i < map_->size(); ++i) {
-            Array rhs = yt - theta_*dt_*map_->apply_direction(i, y);
-            yt = map_->solve_splitting(i, rhs, -theta_*dt_);
+            map_->apply_direction_into(i, y_, work_);
+            for (Size j=0; j < n; ++j)
+                work_[j] = yt_[j] - theta_*dt_*work_[j];
+            map_->solve_splitting_into(i, work_, -theta_*dt_, yt_, tmp_);
         }
-        bcSet_.applyAfterSolving(yt);
+        bcSet_.applyAfterSolving(yt_);
 
-        a = yt;
+        a.swap(yt_);
     }
 
     void HundsdorferScheme::setStep(Time dt) {
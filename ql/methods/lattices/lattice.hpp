@@ -28,6 +28,7 @@
 #include <ql/numericalmethod.hpp>
 #include <ql/discretizedasset.hpp>
 #include <ql/patterns/curiouslyrecurring.hpp>
+#include <vector>
 
 namespace QuantLib {
 
@@ -51,6 +52,22 @@ namespace QuantLib {
                         Array& newValues) const;
         \endcode
 
+        The branching of each time step, i.e., the descendants and
+        probabilities of its nodes together with their discounts, is
+        read from the derived class the first time the step is used
+        and is stored in contiguous arrays; rolling back and computing
+        state prices then run over these arrays without calling the
+        derived class for each node.  The discount, descendants and
+        probabilities at a time step must therefore not change after
+        the step was used.
+
+        The tables of all the steps are kept, which takes about
+        \f$ 16 n + 8 \f$ bytes per node, \f$ n \f$ being the number
+        of branches.  For lattices with many nodes per step, such as
+        two-dimensional ones, derived classes can disable the tables;
+        the derived class is then called for each node and branch, as
+        in the original implementation.
+
         \ingroup lattices
     */
     template <class Impl>
@@ -58,8 +75,9 @@ namespace QuantLib {
                         public CuriouslyRecurringTemplate<Impl> {
       public:
         TreeLattice(const TimeGrid& timeGrid,
-                    Size n)
-        : Lattice(timeGrid), n_(n) {
+                    Size n,
+                    bool cacheBranchings = true)
+        : Lattice(timeGrid), n_(n), cacheBranchings_(cacheBranchings) {
             QL_REQUIRE(n>0, "there is no zeronomial lattice!");
             statePrices_ = std::vector<Array>(1, Array(1, 1.0));
             statePricesLimit_ = 0;
@@ -87,24 +105,82 @@ namespace QuantLib {
         mutable std::vector<Array> statePrices_;
 
       private:
+        // branching of the nodes at a time step; descendants and
+        // probabilities are stored by branch, so that the entries
+        // for the l-th branch of node j are at l*size+j
+        struct Branching {
+            std::vector<Size> descendants;
+            std::vector<Real> probabilities;
+            std::vector<DiscountFactor> discounts;
+        };
+        const Branching& branching(Size i) const;
+
         Size n_;
         mutable Size statePricesLimit_;
+        bool cacheBranchings_;
+        mutable std::vector<Branching> branchings_;
+        // buffer reused across rollback steps
+        mutable Array buffer_;
     };
 
 
     // template definitions
 
+    template <class Impl>
+    const typename TreeLattice<Impl>::Branching&
+    TreeLattice<Impl>::branching(Size i) const {
+        if (i >= branchings_.size())
+            branchings_.resize(i+1);
+        Branching& b = branchings_[i];
+        if (b.discounts.empty()) {
+            Size size = this->impl().size(i);
+            b.descendants.resize(n_*size);
+            b.probabilities.resize(n_*size);
+            b.discounts.resize(size);
+            for (Size j=0; j<size; j++) {
+                b.discounts[j] = this->impl().discount(i,j);
+                for (Size l=0; l<n_; l++) {
+                    b.descendants[l*size+j] = this->impl().descendant(i,j,l);
+                    b.probabilities[l*size+j] =
+                        this->impl().probability(i,j,l);
+                }
+            }
+        }
+        return b;
+    }
+
     template <class Impl>
     void TreeLattice<Impl>::computeStatePrices(Size until) const {
+        if (!cacheBranchings_) {
+            for (Size i=statePricesLimit_; i<until; i++) {
+                statePrices_.emplace_back(
+                                  Array(this->impl().size(i+1), 0.0));
+                for (Size j=0; j<this->impl().size(i); j++) {
+                    DiscountFactor disc = this->impl().discount(i,j);
+                    Real statePrice = statePrices_[i][j];
+                    for (Size l=0; l<n_; l++) {
+                        statePrices_[i+1][this->impl().descendant(i,j,l)] +=
+                            statePrice*disc*this->impl().probability(i,j,l);
+                    }
+                }
+            }
+            statePricesLimit_ = until;
+            return;
+        }
         for (Size i=statePricesLimit_; i<until; i++) {
+            const Branching& b = branching(i);
+            const Size size = b.discounts.size();
             statePrices_.emplace_back(Array(this->impl().size(i+1), 0.0));
-            for (Size j=0; j<this->impl().size(i); j++) {
-                DiscountFactor disc = this->impl().discount(i,j);
-                Real statePrice = statePrices_[i][j];
-                for (Size l=0; l<n_; l++) {
-                    statePrices_[i+1][this->impl().descendant(i,j,l)] +=
-                        statePrice*disc*this->impl().probability(i,j,l);
-                }
+            const Array& current = statePrices_[i];
+            Array& next = statePrices_[i+1];
+            // nodes are visited in the outer loop, so that the
+            // contributions to each state price are summed in the
+            // same order as when reading the derived class per node
+            for (Size j=0; j<size; j++) {
+                Real weight = current[j]*b.discounts[j];
+                for (Size l=0; l<n_; l++)
+                    next[b.descendants[l*size+j]] +=
+                        weight*b.probabilities[l*size+j];
             }
         }
         statePricesLimit_ = until;
@@ -153,10 +229,11 @@ namespace QuantLib {
         Integer iTo = Integer(t_.index(to));
 
         for (Integer i=iFrom-1; i>=iTo; --i) {
-            Array newValues(this->impl().size(i));
-            this->impl().stepback(i, asset.values(), newValues);
+            if (buffer_.size() != this->impl().size(i))
+                buffer_ = Array(this->impl().size(i));
+            this->impl().stepback(i, asset.values(), buffer_);
             asset.time() = t_[i];
-            asset.values() = newValues;
+            asset.values().swap(buffer_);
             // skip the very last adjustment
             if (i != iTo)
                 asset.adjustValues();
@@ -166,16 +243,34 @@ namespace QuantLib {
     template <class Impl>
     void TreeLattice<Impl>::stepback(Size i, const Array& values,
                                      Array& newValues) const {
-        // #pragma omp parallel for
-        for (Size j=0; j<this->impl().size(i); j++) {
-            Real value = 0.0;
-            for (Size l=0; l<n_; l++) {
-                value += this->impl().probability(i,j,l) *
-                         values[this->impl().descendant(i,j,l)];
+        if (!cacheBranchings_) {
+            for (Size j=0; j<this->impl().size(i); j++) {
+                Real value = 0.0;
+                for (Size l=0; l<n_; l++) {
+                    value += this->impl().probability(i,j,l) *
+                             values[this->impl().descendant(i,j,l)];
+                }
+                value *= this->impl().discount(i,j);
+                newValues[j] = value;
             }
-            value *= this->impl().discount(i,j);
-            newValues[j] = value;
+            return;
+        }
+        const Branching& b = branching(i);
+        const Size size = b.discounts.size();
+        Array::const_iterator v = values.begin();
+        Array::iterator result = newValues.begin();
+        // branches are accumulated in turn, so that each pass is a
+        // contiguous gather-multiply-add over the nodes
+        for (Size j=0; j<size; j++)
+            result[j] = 0.0;
+        for (Size l=0; l<n_; l++) {
+            const Size* d = &b.descendants[l*size];
+            const Real* p = &b.probabilities[l*size];
+            for (Size j=0; j<size; j++)
+                result[j] += p[j]*v[d[j]];
         }
+        for (Size j=0; j<size; j++)
+            result[j] *= b.discounts[j];
     }
 
 }
@@ -33,7 +33,8 @@ namespace QuantLib {
 
     //! Two-dimensional tree-based lattice.
     /*! This lattice is based on two trinomial trees and primarily used
-        for the G2 short-rate model.
+        for the G2 short-rate model.  Its steps have many nodes, so the
+        branching tables of TreeLattice are not used.
 
         \ingroup lattices
     */
@@ -71,7 +72,8 @@ namespace QuantLib {
     TreeLattice2D<Impl,T>::TreeLattice2D(const std::shared_ptr<T>& tree1,
                                          const std::shared_ptr<T>& tree2,
                                          Real correlation)
-    : TreeLattice<Impl>(tree1->timeGrid(), T::branches*T::branches),
+    : TreeLattice<Impl>(tree1->timeGrid(), T::branches*T::branches,
+                        false),
       tree1_(tree1), tree2_(tree2), m_(T::branches,T::branches),
       rho_(std::fabs(correlation)) {
 
@@ -0,0 +1,244 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file compactlongstaffschwartzpathpricer.hpp
+    \brief Longstaff-Schwarz path pricer with compact calibration storage
+*/
+
+#ifndef quantlib_compact_longstaff_schwartz_path_pricer_hpp
+#define quantlib_compact_longstaff_schwartz_path_pricer_hpp
+
+#include <ql/methods/montecarlo/longstaffschwartzpathpricer.hpp>
+#include <ql/math/matrixutilities/svd.hpp>
+#include <algorithm>
+#include <numeric>
+
+namespace QuantLib {
+
+    //! Longstaff-Schwarz path pricer with compact calibration storage
+    /*! Instead of copying the calibration paths, only the exercise
+        values and the regression states at each exercise time are
+        stored, contiguously in a single buffer.  During the
+        calibration, the basis functions are evaluated on blocks of
+        in-the-money paths and the normal equations of the regression
+        are accumulated block by block, so that no design matrix is
+        built; the memory used is thus independent of the number of
+        in-the-money paths.  The normal equations are solved by
+        singular-value decomposition.
+
+        The pricing phase is the same as for the base class.
+
+        \warning the post_processing hook of the base class is not
+                 called during calibration.
+
+        \ingroup mcarlo
+    */
+    template <class PathType>
+    class CompactLongstaffSchwartzPathPricer
+        : public LongstaffSchwartzPathPricer<PathType> {
+      public:
+        typedef typename LongstaffSchwartzPathPricer<PathType>::StateType
+            StateType;
+
+        CompactLongstaffSchwartzPathPricer(
+            const TimeGrid& times,
+            const std::shared_ptr<EarlyExercisePathPricer<PathType> >&,
+            const std::shared_ptr<YieldTermStructure>& termStructure);
+
+        Real operator()(const PathType& path) const;
+        void calibrate();
+
+      private:
+        static Size stateSize(Real) { return 1; }
+        static Size stateSize(const Array& x) { return x.size(); }
+        static void storeState(Real x, Real* out) { *out = x; }
+        static void storeState(const Array& x, Real* out) {
+            std::copy(x.begin(), x.end(), out);
+        }
+        static void resizeState(Real&, Size) {}
+        static void resizeState(Array& x, Size n) { x = Array(n); }
+        static void loadState(const Real* in, Real& x) { x = *in; }
+        static void loadState(const Real* in, Array& x) {
+            std::copy(in, in + x.size(), x.begin());
+        }
+        Real continuationValue(const Array& coeff,
+                               const StateType& state) const;
+
+        // for each calibration path and exercise time, the exercise
+        // value followed by the regression state
+        mutable std::vector<Real> states_;
+        mutable Size stateSize_ = 0;
+        mutable Size calibrationPaths_ = 0;
+
+        static constexpr Size blockSize_ = 128;
+    };
+
+
+    template <class PathType> inline
+    CompactLongstaffSchwartzPathPricer<PathType>::
+    CompactLongstaffSchwartzPathPricer(
+        const TimeGrid& times,
+        const std::shared_ptr<EarlyExercisePathPricer<PathType> >&
+            pathPricer,
+        const std::shared_ptr<YieldTermStructure>& termStructure)
+    : LongstaffSchwartzPathPricer<PathType>(times, pathPricer,
+                                            termStructure) {}
+
+    template <class PathType> inline
+    Real CompactLongstaffSchwartzPathPricer<PathType>::operator()
+        (const PathType& path) const {
+        if (!this->calibrationPhase_)
+            return LongstaffSchwartzPathPricer<PathType>::operator()(path);
+
+        const Size len = this->len_;
+        for (Size i=1; i<len; ++i) {
+            const StateType state = this->pathPricer_->state(path, i);
+            if (calibrationPaths_ == 0 && i == 1)
+                stateSize_ = stateSize(state);
+            QL_REQUIRE(stateSize(state) == stateSize_,
+                       "inconsistent state size: " << stateSize_
+                       << " expected, " << stateSize(state) << " given");
+            const Size offset = states_.size();
+            states_.resize(offset + stateSize_ + 1);
+            states_[offset] = (*this->pathPricer_)(path, i);
+            storeState(state, &states_[offset+1]);
+        }
+        ++calibrationPaths_;
+
+        // result doesn't matter
+        return 0.0;
+    }
+
+    template <class PathType> inline
+    Real CompactLongstaffSchwartzPathPricer<PathType>::continuationValue(
+                        const Array& coeff, const StateType& state) const {
+        Real result = 0.0;
+        for (Size l=0; l<this->v_.size(); ++l)
+            result += coeff[l] * this->v_[l](state);
+        return result;
+    }
+
+    template <class PathType> inline
+    void CompactLongstaffSchwartzPathPricer<PathType>::calibrate() {
+        const Size n = calibrationPaths_;
+        const Size m = this->v_.size();
+        const Size len = this->len_;
+        const Size record = stateSize_ + 1;
+        const Size pathRecord = (len-1)*record;
+
+        // the exercise value at time i for path j is stored at
+        // j*pathRecord + (i-1)*record, followed by the state
+        std::vector<Real> prices(n);
+        for (Size j=0; j<n; ++j)
+            prices[j] = states_[j*pathRecord + (len-2)*record];
+
+        StateType state;
+        resizeState(state, stateSize_);
+        std::vector<StateType> blockStates(blockSize_, state);
+        std::vector<Real> basis(blockSize_*m), y(blockSize_);
+        Matrix normalMatrix(m, m);
+        Array rhs(m);
+
+        for (Size i=len-2; i>0; --i) {
+            const Real dF = this->dF_[i];
+            std::fill(normalMatrix.begin(), normalMatrix.end(), 0.0);
+            std::fill(rhs.begin(), rhs.end(), 0.0);
+            Size itmPaths = 0;
+
+            // accumulate the normal equations over blocks of
+            // in-the-money paths
+            for (Size first=0; first<n; first+=blockSize_) {
+                const Size last = std::min(first+blockSize_, n);
+                Size rows = 0;
+                for (Size j=first; j<last; ++j) {
+                    const Real* r = &states_[j*pathRecord + (i-1)*record];
+                    if (r[0] > 0.0) {
+                        loadState(r+1, blockStates[rows]);
+                        y[rows] = dF*prices[j];
+                        ++rows;
+                    }
+                }
+                for (Size l=0; l<m; ++l)
+                    for (Size k=0; k<rows; ++k)
+                        basis[l*blockSize_+k] = this->v_[l](blockStates[k]);
+                for (Size l=0; l<m; ++l) {
+                    const Real* bl = &basis[l*blockSize_];
+                    for (Size l2=l; l2<m; ++l2) {
+                        const Real* bl2 = &basis[l2*blockSize_];
+                        Real sum = 0.0;
+                        for (Size k=0; k<rows; ++k)
+                            sum += bl[k]*bl2[k];
+                        normalMatrix[l][l2] += sum;
+                    }
+                    Real sum = 0.0;
+                    for (Size k=0; k<rows; ++k)
+                        sum += bl[k]*y[k];
+                    rhs[l] += sum;
+                }
+                itmPaths += rows;
+            }
+
+            Array& coeff = this->coeff_[i-1];
+            coeff = Array(m, 0.0);
+            // if number of itm paths is smaller then the number of
+            // calibration functions then early exercise if
+            // exerciseValue > 0
+            if (m <= itmPaths) {
+                for (Size l=0; l<m; ++l)
+                    for (Size l2=0; l2<l; ++l2)
+                        normalMatrix[l][l2] = normalMatrix[l2][l];
+                const SVD svd(normalMatrix);
+                const Matrix& U = svd.U();
+                const Matrix& V = svd.V();
+                const Array& w = svd.singularValues();
+                const Real threshold = m * QL_EPSILON * w[0];
+                for (Size l=0; l<m; ++l) {
+                    if (w[l] > threshold) {
+                        const Real u = std::inner_product(U.column_begin(l),
+                                                          U.column_end(l),
+                                                          rhs.begin(), 0.0)
+                            / w[l];
+                        for (Size l2=0; l2<m; ++l2)
+                            coeff[l2] += u*V[l2][l];
+                    }
+                }
+            }
+
+            // roll back step
+            for (Size j=0; j<n; ++j) {
+                prices[j] *= dF;
+                const Real* r = &states_[j*pathRecord + (i-1)*record];
+                if (r[0] > 0.0) {
+                    loadState(r+1, state);
+                    if (continuationValue(coeff, state) < r[0])
+                        prices[j] = r[0];
+                }
+            }
+        }
+
+        // remove calibration data and release memory
+        std::vector<Real> empty;
+        states_.swap(empty);
+        calibrationPaths_ = 0;
+        // entering the calculation phase
+        this->calibrationPhase_ = false;
+    }
+
+}
+
+
+#endif
@@ -29,6 +29,9 @@
 #include <ql/math/statistics/statistics.hpp>
 #include <memory>
 #include <algorithm>
+#include <exception>
+#include <thread>
+#include <vector>
 
 namespace QuantLib {
 
@@ -46,6 +49,20 @@ namespace QuantLib {
         provide the additional control option, namely the option path
         pricer and the option value.
 
+        A multi-threaded model can be built by passing one path
+        generator and one path pricer per worker; samples are then
+        split deterministically among the workers, each running on
+        its own thread, and are added to the sample accumulator in
+        worker order.  Provided that each generator draws from a
+        reproducible stream, results only depend on the seeds and
+        on the number of workers.
+
+        \warning in multi-threaded mode, path generators and pricers
+                 are used concurrently; the underlying processes and
+                 term structures must therefore be safe for concurrent
+                 read access, i.e., any lazy calculation must have
+                 been performed before samples are added.
+
         \ingroup mcarlo
     */
     template <template <class> class MC, class RNG, class S = Statistics>
@@ -69,62 +86,169 @@ namespace QuantLib {
                   result_type cvOptionValue = result_type(),
                   const std::shared_ptr<path_generator_type>& cvPathGenerator
                         = std::shared_ptr<path_generator_type>())
-        : pathGenerator_(pathGenerator), pathPricer_(pathPricer),
+        : pathGenerators_(1, pathGenerator), pathPricers_(1, pathPricer),
           sampleAccumulator_(sampleAccumulator),
           isAntitheticVariate_(antitheticVariate),
-          cvPathPricer_(cvPathPricer), cvOptionValue_(cvOptionValue),
-          cvPathGenerator_(cvPathGenerator) {
-            if (!cvPathPricer_)
+          cvPathPricers_(1, cvPathPricer), cvOptionValue_(cvOptionValue),
+          cvPathGenerators_(1, cvPathGenerator) {
+            if (!cvPathPricer)
                 isControlVariate_ = false;
             else
                 isControlVariate_ = true;
         }
+        //! multi-threaded constructor, one generator and pricer per worker
+        MonteCarloModel(
+            const std::vector<std::shared_ptr<path_generator_type> >&
+                                                             pathGenerators,
+            const std::vector<std::shared_ptr<path_pricer_type> >& pathPricers,
+            const stats_type& sampleAccumulator,
+            bool antitheticVariate,
+            const std::vector<std::shared_ptr<path_pricer_type> >&
+                cvPathPricers = std::vector<std::shared_ptr<path_pricer_type> >(),
+            result_type cvOptionValue = result_type(),
+            const std::vector<std::shared_ptr<path_generator_type> >&
+                cvPathGenerators =
+                    std::vector<std::shared_ptr<path_generator_type> >())
+        : pathGenerators_(pathGenerators), pathPricers_(pathPricers),
+          sampleAccumulator_(sampleAccumulator),
+          isAntitheticVariate_(antitheticVariate),
+          cvPathPricers_(cvPathPricers), cvOptionValue_(cvOptionValue),
+          cvPathGenerators_(cvPathGenerators) {
+            Size workers = pathGenerators_.size();
+            QL_REQUIRE(workers > 0, "no path generator given");
+            QL_REQUIRE(pathPricers_.size() == workers,
+                       "mismatch between number of path generators ("
+                       << workers << ") and path pricers ("
+                       << pathPricers_.size() << ")");
+            isControlVariate_ = !cvPathPricers_.empty();
+            if (isControlVariate_) {
+                QL_REQUIRE(cvPathPricers_.size() == workers,
+                           "mismatch between number of path generators ("
+                           << workers << ") and control-variate pricers ("
+                           << cvPathPricers_.size() << ")");
+            }
+            if (cvPathGenerators_.empty()) {
+                cvPathGenerators_.resize(workers);
+            } else {
+                QL_REQUIRE(cvPathGenerators_.size() == workers,
+                           "mismatch between number of path generators ("
+                           << workers << ") and control-variate generators ("
+                           << cvPathGenerators_.size() << ")");
+            }
+        }
         void addSamples(Size samples);
         const stats_type& sampleAccumulator(void) const;
+        //! number of workers among which samples are split
+        Size workers() const { return pathGenerators_.size(); }
       private:
-        std::shared_ptr<path_generator_type> pathGenerator_;
-        std::shared_ptr<path_pricer_type> pathPricer_;
+        // samples drawn by a worker, stored until they are merged
+        class SampleBuffer {
+          public:
+            void add(const result_type& value, Real weight) {
+                samples_.emplace_back(value, weight);
+            }
+            void flushInto(stats_type& accumulator) const {
+                for (Size i=0; i<samples_.size(); ++i)
+                    accumulator.add(samples_[i].first, samples_[i].second);
+            }
+            void reserve(Size n) { samples_.reserve(n); }
+          private:
+            std::vector<std::pair<result_type,Real> > samples_;
+        };
+        template <class Accumulator>
+        void addSamples(Size samples, Size worker, Accumulator& accumulator);
+        std::vector<std::shared_ptr<path_generator_type> > pathGenerators_;
+        std::vector<std::shared_ptr<path_pricer_type> > pathPricers_;
         stats_type sampleAccumulator_;
         bool isAntitheticVariate_;
-        std::shared_ptr<path_pricer_type> cvPathPricer_;
+        std::vector<std::shared_ptr<path_pricer_type> > cvPathPricers_;
         result_type cvOptionValue_;
         bool isControlVariate_;
-        std::shared_ptr<path_generator_type> cvPathGenerator_;
+        std::vector<std::shared_ptr<path_generator_type> > cvPathGenerators_;
     };
 
     // inline definitions
     template <template <class> class MC, class RNG, class S>
     inline void MonteCarloModel<MC,RNG,S>::addSamples(Size samples) {
+        Size workers = pathGenerators_.size();
+        if (workers == 1) {
+            addSamples(samples, 0, sampleAccumulator_);
+            return;
+        }
+
+        std::vector<SampleBuffer> buffers(workers);
+        std::vector<std::exception_ptr> errors(workers);
+        std::vector<std::thread> threads;
+        threads.reserve(workers-1);
+
+        for (Size i=0; i<workers; ++i) {
+            // the first (samples % workers) workers take one more sample
+            Size n = samples/workers + (i < samples%workers ? 1 : 0);
+            buffers[i].reserve(n);
+            auto task = [this, n, i, &buffers, &errors]() {
+                try {
+                    this->addSamples(n, i, buffers[i]);
+                } catch (...) {
+                    errors[i] = std::current_exception();
+                }
+            };
+            // the calling thread takes care of the last worker
+            if (i+1 < workers)
+                threads.emplace_back(task);
+            else
+                task();
+        }
+        for (Size i=0; i<threads.size(); ++i)
+            threads[i].join();
+        for (Size i=0; i<workers; ++i)
+            if (errors[i])
+                std::rethrow_exception(errors[i]);
+
+        for (Size i=0; i<workers; ++i)
+            buffers[i].flushInto(sampleAccumulator_);
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    template <class Accumulator>
+    inline void MonteCarloModel<MC,RNG,S>::addSamples(
+                      Size samples, Size worker, Accumulator& accumulator) {
+        path_generator_type& pathGenerator = *pathGenerators_[worker];
+        const path_pricer_type& pathPricer = *pathPricers_[worker];
+        const std::shared_ptr<path_pricer_type>& cvPathPricer =
+            cvPathPricers_[worker];
+        const std::shared_ptr<path_generator_type>& cvPathGenerator =
+            cvPathGenerators_[worker];
+
         for(Size j = 1; j <= samples; j++) {
 
-            const sample_type& path = pathGenerator_->next();
-            result_type price = (*pathPricer_)(path.value);
+            const sample_type& path = pathGenerator.next();
+            result_type price = pathPricer(path.value);
 
             if (isControlVariate_) {
-                if (!cvPathGenerator_) {
-                    price += cvOptionValue_-(*cvPathPricer_)(path.value);
+                if (!cvPathGenerator) {
+                    price += cvOptionValue_-(*cvPathPricer)(path.value);
                 }
                 else {
-                    const sample_type& cvPath = cvPathGenerator_->next();
-                    price += cvOptionValue_-(*cvPathPricer_)(cvPath.value);
+                    const sample_type& cvPath = cvPathGenerator->next();
+                    price += cvOptionValue_-(*cvPathPricer)(cvPath.value);
                 }
             }
 
             if (isAntitheticVariate_) {
-                const sample_type& atPath = pathGenerator_->antithetic();
-                result_type price2 = (*pathPricer_)(atPath.value);
+                const sample_type& atPath = pathGenerator.antithetic();
+                result_type price2 = pathPricer(atPath.value);
                 if (isControlVariate_) {
-                    if (!cvPathGenerator_)
-                        price2 += cvOptionValue_-(*cvPathPricer_)(atPath.value);
+                    if (!cvPathGenerator)
+                        price2 += cvOptionValue_-(*cvPathPricer)(atPath.value);
                     else {
-                        const sample_type& cvPath = cvPathGenerator_->antithetic();
-                        price2 += cvOptionValue_-(*cvPathPricer_)(cvPath.value);
+                        const sample_type& cvPath = cvPathGenerator->antithetic();
+                        price2 += cvOptionValue_-(*cvPathPricer)(cvPath.value);
                     }
                 }
 
-                sampleAccumulator_.add((price+price2)/2.0, path.weight);
+                accumulator.add((price+price2)/2.0, path.weight);
             } else {
-                sampleAccumulator_.add(price, path.weight);
+                accumulator.add(price, path.weight);
             }
         }
     }
@@ -84,4 +84,47 @@ namespace QuantLib {
         
         return error;
     }
+
+    Real CalibrationHelper::modelValueAndGradient(Array&) const {
+        QL_FAIL("model-value gradient not available");
+    }
+
+    Array CalibrationHelper::calibrationErrorGradient() {
+        Array gradient;
+        const Real modelPrice = modelValueAndGradient(gradient);
+
+        switch (calibrationErrorType_) {
+          case RelativePriceError:
+            gradient *= (marketValue() >= modelPrice ? -1.0 : 1.0)
+                / marketValue();
+            break;
+          case PriceError:
+            gradient *= -1.0;
+            break;
+          case ImpliedVolError:
+            {
+              Real minVol = volatilityType_ == ShiftedLognormal ? 0.0010 : 0.00005;
+              Real maxVol = volatilityType_ == ShiftedLognormal ? 10.0 : 0.50;
+              if (modelPrice <= blackPrice(minVol)
+                  || modelPrice >= blackPrice(maxVol)) {
+                  // the implied volatility is floored or capped
+                  gradient = Array(gradient.size(), 0.0);
+              } else {
+                  Volatility implied = this->impliedVolatility(
+                                      modelPrice, 1e-12, 5000, minVol, maxVol);
+                  // the gradient of the implied volatility is the one
+                  // of the price divided by the vega
+                  Real h = std::min(1.0e-5, 0.5*(implied - minVol));
+                  Real vega = (blackPrice(implied+h) - blackPrice(implied-h))
+                      / (2.0*h);
+                  gradient /= vega;
+              }
+            }
+            break;
+          default:
+            QL_FAIL("unknown Calibration Error Type");
+        }
+
+        return gradient;
+    }
 }
@@ -26,6 +26,7 @@
 #define quantlib_interest_rate_modelling_calibration_helper_h
 
 #include <ql/quote.hpp>
+#include <ql/math/array.hpp>
 #include <ql/termstructures/yieldtermstructure.hpp>
 #include <ql/termstructures/volatility/volatilitytype.hpp>
 #include <ql/patterns/lazyobject.hpp>
@@ -72,6 +73,20 @@ namespace QuantLib {
         //! returns the error resulting from the model valuation
         virtual Real calibrationError();
 
+        //! whether the model value can be differentiated analytically
+        virtual bool providesGradient() const { return false; }
+
+        /*! returns the model value and stores in \c gradient its
+            derivatives with respect to the model parameters, in the
+            order of CalibratedModel::params()
+        */
+        virtual Real modelValueAndGradient(Array& gradient) const;
+
+        /*! returns the derivatives of the calibration error with
+            respect to the model parameters
+        */
+        virtual Array calibrationErrorGradient();
+
         virtual void addTimesTo(std::list<Time>& times) const = 0;
 
         //! Black volatility implied by the model
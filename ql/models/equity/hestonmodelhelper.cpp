@@ -20,6 +20,7 @@
 */
 
 #include <ql/models/equity/hestonmodelhelper.hpp>
+#include <ql/pricingengines/vanilla/analytichestonengine.hpp>
 #include <ql/pricingengines/blackformula.hpp>
 #include <ql/processes/hestonprocess.hpp>
 #include <ql/instruments/payoffs.hpp>
@@ -85,6 +86,24 @@ namespace QuantLib {
         return option_->NPV();
     }
 
+    bool HestonModelHelper::providesGradient() const {
+        std::shared_ptr<AnalyticHestonEngine> engine =
+            std::dynamic_pointer_cast<AnalyticHestonEngine>(engine_);
+        return engine && engine->providesGradient();
+    }
+
+    Real HestonModelHelper::modelValueAndGradient(Array& gradient) const {
+        calculate();
+        std::shared_ptr<AnalyticHestonEngine> engine =
+            std::dynamic_pointer_cast<AnalyticHestonEngine>(engine_);
+        QL_REQUIRE(engine, "model-value gradient requires "
+                           "an analytic Heston engine");
+        VanillaOption::arguments arguments;
+        option_->setupArguments(&arguments);
+        arguments.validate();
+        return engine->valueAndGradient(arguments, gradient);
+    }
+
     Real HestonModelHelper::blackPrice(Real volatility) const {
         calculate();
         const Real stdDev = volatility * std::sqrt(maturity());
@@ -56,6 +56,11 @@ namespace QuantLib {
         void addTimesTo(std::list<Time>&) const {}
         void performCalculations() const;
         Real modelValue() const;
+        /*! returns true if the pricing engine is an
+            AnalyticHestonEngine providing parameter gradients
+        */
+        bool providesGradient() const;
+        Real modelValueAndGradient(Array& gradient) const;
         Real blackPrice(Real volatility) const;
         Time maturity() const  { calculate(); return tau_; }
       private:
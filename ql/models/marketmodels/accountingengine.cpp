@@ -22,6 +22,7 @@
 #include <ql/models/marketmodels/evolver.hpp>
 #include <ql/models/marketmodels/evolutiondescription.hpp>
 #include <ql/models/marketmodels/curvestate.hpp>
+#include <ql/utilities/parallelfor.hpp>
 #include <algorithm>
 
 namespace QuantLib {
@@ -50,6 +51,68 @@ namespace QuantLib {
 
     }
 
+    AccountingEngine::AccountingEngine(
+                    const std::shared_ptr<MarketModelBatchEvolver>& evolver,
+                    const Clone<MarketModelMultiProduct>& product,
+                    Real initialNumeraireValue)
+    : AccountingEngine(std::shared_ptr<MarketModelEvolver>(), product,
+                       initialNumeraireValue) {
+        batchEvolver_ = evolver;
+        products_.resize(evolver->batchSize(), product);
+    }
+
+    AccountingEngine::AccountingEngine(
+             const std::vector<std::shared_ptr<MarketModelEvolver> >& evolvers,
+             const Clone<MarketModelMultiProduct>& product,
+             Real initialNumeraireValue)
+    : AccountingEngine(std::shared_ptr<MarketModelEvolver>(), product,
+                       initialNumeraireValue) {
+        QL_REQUIRE(!evolvers.empty(), "no evolvers given");
+        workers_.reserve(evolvers.size());
+        for (const auto& evolver : evolvers)
+            workers_.push_back(std::make_shared<AccountingEngine>(
+                                  evolver, product, initialNumeraireValue));
+    }
+
+    AccountingEngine::AccountingEngine(
+        const std::vector<std::shared_ptr<MarketModelBatchEvolver> >& evolvers,
+        const Clone<MarketModelMultiProduct>& product,
+        Real initialNumeraireValue)
+    : AccountingEngine(std::shared_ptr<MarketModelEvolver>(), product,
+                       initialNumeraireValue) {
+        QL_REQUIRE(!evolvers.empty(), "no evolvers given");
+        workers_.reserve(evolvers.size());
+        for (const auto& evolver : evolvers)
+            workers_.push_back(std::make_shared<AccountingEngine>(
+                                  evolver, product, initialNumeraireValue));
+    }
+
+    void AccountingEngine::addCashFlows(const CurveState& currentState,
+                                        Size numeraire,
+                                        Real principalInNumerairePortfolio,
+                                        Real* numerairesHeld) const {
+        // for each product...
+        for (Size i=0; i<numberProducts_; ++i) {
+            // ...and each cash flow...
+            const std::vector<MarketModelMultiProduct::CashFlow>& cashflows =
+                cashFlowsGenerated_[i];
+            for (Size j=0; j<numberCashFlowsThisStep_[i]; ++j) {
+                // ...convert the cash flow to numeraires.
+                // This is done by calculating the number of
+                // numeraire bonds corresponding to such cash flow...
+                const MarketModelDiscounter& discounter =
+                    discounters_[cashflows[j].timeIndex];
+
+                Real bonds = cashflows[j].amount *
+                    discounter.numeraireBonds(currentState, numeraire);
+
+                // ...and adding the newly bought bonds to the number
+                // of numeraires held.
+                numerairesHeld[i] += bonds/principalInNumerairePortfolio;
+            }
+        }
+    }
+
     Real AccountingEngine::singlePathValues(std::vector<Real>& values) {
         std::fill(numerairesHeld_.begin(), numerairesHeld_.end(), 0.0);
         Real weight = evolver_->startNewPath();
@@ -66,27 +129,8 @@ namespace QuantLib {
             Size numeraire =
                 evolver_->numeraires()[thisStep];
 
-            // for each product...
-            for (Size i=0; i<numberProducts_; ++i) {
-                // ...and each cash flow...
-                const std::vector<MarketModelMultiProduct::CashFlow>& cashflows =
-                    cashFlowsGenerated_[i];
-                for (Size j=0; j<numberCashFlowsThisStep_[i]; ++j) {
-                    // ...convert the cash flow to numeraires.
-                    // This is done by calculating the number of
-                    // numeraire bonds corresponding to such cash flow...
-                    const MarketModelDiscounter& discounter =
-                        discounters_[cashflows[j].timeIndex];
-
-                    Real bonds = cashflows[j].amount *
-                        discounter.numeraireBonds(evolver_->currentState(),
-                                                  numeraire);
-
-                    // ...and adding the newly bought bonds to the number
-                    // of numeraires held.
-                    numerairesHeld_[i] += bonds/principalInNumerairePortfolio;
-                }
-            }
+            addCashFlows(evolver_->currentState(), numeraire,
+                         principalInNumerairePortfolio, &numerairesHeld_[0]);
 
             if (!done) {
 
@@ -112,9 +156,81 @@ namespace QuantLib {
         return weight;
     }
 
+    void AccountingEngine::batchPathValues(Size paths,
+                                           SequenceStatisticsInc& stats) {
+        std::vector<Real> numerairesHeld(paths*numberProducts_, 0.0);
+        std::vector<Real> principalsInNumerairePortfolio(paths, 1.0);
+        std::vector<bool> done(paths, false);
+        batchEvolver_->startNewBatch(paths);
+        std::vector<Real> weights(batchEvolver_->weights(),
+                                  batchEvolver_->weights() + paths);
+        for (Size p=0; p<paths; ++p)
+            products_[p]->reset();
+
+        Size running = paths;
+        while (running > 0) {
+            Size thisStep = batchEvolver_->currentStep();
+            batchEvolver_->advanceStep();
+            const Real* stepWeights = batchEvolver_->weights();
+            Size numeraire = batchEvolver_->numeraires()[thisStep];
+
+            // paths are evolved together, but each product is
+            // accounted for as in singlePathValues
+            for (Size p=0; p<paths; ++p) {
+                if (done[p])
+                    continue;
+                weights[p] *= stepWeights[p];
+                const CurveState& currentState =
+                    batchEvolver_->currentState(p);
+                done[p] = products_[p]->nextTimeStep(currentState,
+                                                     numberCashFlowsThisStep_,
+                                                     cashFlowsGenerated_);
+                addCashFlows(currentState, numeraire,
+                             principalsInNumerairePortfolio[p],
+                             &numerairesHeld[p*numberProducts_]);
+                if (!done[p]) {
+                    Size nextNumeraire =
+                        batchEvolver_->numeraires()[thisStep+1];
+                    principalsInNumerairePortfolio[p] *=
+                        currentState.discountRatio(numeraire, nextNumeraire);
+                } else {
+                    --running;
+                }
+            }
+        }
+
+        std::vector<Real> values(numberProducts_);
+        for (Size p=0; p<paths; ++p) {
+            for (Size i=0; i<numberProducts_; ++i)
+                values[i] = numerairesHeld[p*numberProducts_+i] *
+                    initialNumeraireValue_;
+            stats.add(values, weights[p]);
+        }
+    }
+
     void AccountingEngine::multiplePathValues(SequenceStatisticsInc& stats,
                                               Size numberOfPaths)
     {
+        if (!workers_.empty()) {
+            Size workers = workers_.size();
+            std::vector<SequenceStatisticsInc> workerStats(workers);
+            parallelFor(workers, workers, [&](Size w) {
+                workers_[w]->multiplePathValues(
+                    workerStats[w],
+                    (w+1)*numberOfPaths/workers - w*numberOfPaths/workers);
+            });
+            for (Size w=0; w<workers; ++w)
+                stats.merge(workerStats[w]);
+            return;
+        }
+
+        if (batchEvolver_ != nullptr) {
+            Size batchSize = batchEvolver_->batchSize();
+            for (Size i=0; i<numberOfPaths; i+=batchSize)
+                batchPathValues(std::min(batchSize, numberOfPaths-i), stats);
+            return;
+        }
+
         std::vector<Real> values(product_->numberOfProducts());
         for (Size i=0; i<numberOfPaths; ++i) {
             Real weight = singlePathValues(values);
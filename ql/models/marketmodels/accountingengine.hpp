@@ -34,6 +34,8 @@
 namespace QuantLib {
 
     class MarketModelEvolver;
+    class MarketModelBatchEvolver;
+    class CurveState;
 
     //class MarketModelDiscounter;
     //class SequenceStatistics;
@@ -41,18 +43,56 @@ namespace QuantLib {
     //struct MarketModelMultiProduct::CashFlow;
 
     //! Engine collecting cash flows along a market-model simulation
+    /*! When built with a batch evolver, paths are evolved a batch at
+        a time; a copy of the product is kept for each path in the
+        batch, and values are added to the statistics in path order.
+
+        When built with one evolver per worker, paths are split into
+        contiguous chunks, one per worker, and simulated on multiple
+        threads; each worker uses its own evolver and its own copy of
+        the product.  The statistics collected by each worker are
+        merged in worker order, so that results only depend on the
+        evolvers passed and not on thread scheduling.
+
+        \warning the evolvers passed to the multi-threaded
+                 constructors must not share their Brownian
+                 generators; to avoid overlapping paths, they should
+                 also draw from different random streams.
+    */
     class AccountingEngine {
       public:
         AccountingEngine(const std::shared_ptr<MarketModelEvolver>& evolver,
                          const Clone<MarketModelMultiProduct>& product,
                          Real initialNumeraireValue);
+        AccountingEngine(
+                    const std::shared_ptr<MarketModelBatchEvolver>& evolver,
+                    const Clone<MarketModelMultiProduct>& product,
+                    Real initialNumeraireValue);
+        AccountingEngine(
+             const std::vector<std::shared_ptr<MarketModelEvolver> >& evolvers,
+             const Clone<MarketModelMultiProduct>& product,
+             Real initialNumeraireValue);
+        AccountingEngine(
+        const std::vector<std::shared_ptr<MarketModelBatchEvolver> >& evolvers,
+        const Clone<MarketModelMultiProduct>& product,
+        Real initialNumeraireValue);
         void multiplePathValues(SequenceStatisticsInc& stats,
                                 Size numberOfPaths);
       private:
         Real singlePathValues(std::vector<Real>& values);
+        void batchPathValues(Size paths, SequenceStatisticsInc& stats);
+        void addCashFlows(const CurveState& currentState,
+                          Size numeraire,
+                          Real principalInNumerairePortfolio,
+                          Real* numerairesHeld) const;
 
         std::shared_ptr<MarketModelEvolver> evolver_;
+        std::shared_ptr<MarketModelBatchEvolver> batchEvolver_;
         Clone<MarketModelMultiProduct> product_;
+        // one per path in the batch
+        std::vector<Clone<MarketModelMultiProduct> > products_;
+        // one per worker
+        std::vector<std::shared_ptr<AccountingEngine> > workers_;
 
         Real initialNumeraireValue_;
         Size numberProducts_;
@@ -0,0 +1,60 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/models/marketmodels/browniangenerators/batchbrowniangenerator.hpp>
+#include <ql/errors.hpp>
+
+namespace QuantLib {
+
+    BatchBrownianGenerator::BatchBrownianGenerator(
+                   const std::shared_ptr<BrownianGenerator>& generator,
+                   Size batchSize)
+    : generator_(generator), batchSize_(batchSize),
+      factors_(generator->numberOfFactors()),
+      steps_(generator->numberOfSteps()),
+      paths_(0), lastStep_(0),
+      variates_(steps_*factors_*batchSize_),
+      weights_((steps_+1)*batchSize_), step_(factors_) {
+        QL_REQUIRE(batchSize_ > 0, "null batch size");
+    }
+
+    void BatchBrownianGenerator::nextBatch(Size paths) {
+        QL_REQUIRE(paths <= batchSize_,
+                   "too many paths (" << paths << ") for batch size "
+                   << batchSize_);
+        Size stride = factors_*batchSize_;
+        for (Size p=0; p<paths; ++p) {
+            weights_[p] = generator_->nextPath();
+            for (Size s=0; s<steps_; ++s) {
+                weights_[(s+1)*batchSize_ + p] = generator_->nextStep(step_);
+                Real* variates = &variates_[s*stride + p];
+                for (Size f=0; f<factors_; ++f)
+                    variates[f*batchSize_] = step_[f];
+            }
+        }
+        paths_ = paths;
+        lastStep_ = 0;
+    }
+
+    const Real* BatchBrownianGenerator::nextStep() {
+        #if defined(QL_EXTRA_SAFETY_CHECKS)
+        QL_REQUIRE(lastStep_<steps_, "variates exhausted");
+        #endif
+        return &variates_[(lastStep_++)*factors_*batchSize_];
+    }
+
+}
@@ -0,0 +1,69 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file batchbrowniangenerator.hpp
+    \brief Brownian generator for batches of market-model paths
+*/
+
+#ifndef quantlib_batch_brownian_generator_hpp
+#define quantlib_batch_brownian_generator_hpp
+
+#include <ql/models/marketmodels/browniangenerator.hpp>
+
+namespace QuantLib {
+
+    //! Brownian generator for batches of market-model paths
+    /*! Paths are drawn one after the other from an underlying
+        generator, so that the variates are the same as when the paths
+        are evolved one at a time; they are then returned step by step
+        in structure-of-arrays layout, i.e., the variate for factor
+        \f$ f \f$ of path \f$ p \f$ is stored at index
+        \f$ f b + p \f$, \f$ b \f$ being the batch size.
+    */
+    class BatchBrownianGenerator {
+      public:
+        BatchBrownianGenerator(
+                   const std::shared_ptr<BrownianGenerator>& generator,
+                   Size batchSize);
+        //! draws the given number of paths, at most batchSize()
+        void nextBatch(Size paths);
+        //! variates for the next step of the current paths
+        const Real* nextStep();
+        //! weights of the current paths for the last step drawn
+        /*! Before the first step, these are the weights returned by
+            BrownianGenerator::nextPath(); afterwards, those returned
+            by BrownianGenerator::nextStep() for the last step.
+        */
+        const Real* weights() const {
+            return &weights_[lastStep_*batchSize_];
+        }
+
+        Size batchSize() const { return batchSize_; }
+        Size paths() const { return paths_; }
+        Size numberOfFactors() const { return factors_; }
+        Size numberOfSteps() const { return steps_; }
+      private:
+        std::shared_ptr<BrownianGenerator> generator_;
+        Size batchSize_, factors_, steps_;
+        Size paths_, lastStep_;
+        std::vector<Real> variates_, weights_, step_;
+    };
+
+}
+
+
+#endif
@@ -181,4 +181,87 @@ namespace QuantLib {
         }
     }
 
+    void LMMDriftCalculator::computeBatch(const std::vector<Rate>& forwards,
+                                          Size batchSize,
+                                          Size paths,
+                                          std::vector<Real>& drifts) const {
+        #if defined(QL_EXTRA_SAFETY_CHECKS)
+            QL_REQUIRE(forwards.size()==numberOfRates_*batchSize,
+                       "forwards.size() <> dim*batchSize");
+            QL_REQUIRE(drifts.size()==numberOfRates_*batchSize,
+                       "drifts.size() <> dim*batchSize");
+            QL_REQUIRE(paths<=batchSize, "paths > batchSize");
+        #endif
+
+        // The loops below mirror the ones in computePlain and
+        // computeReduced, with an innermost loop over the paths.
+
+        // Precompute forwards factor
+        tmpBatch_.resize(numberOfRates_*batchSize);
+        for (Size i=alive_; i<numberOfRates_; ++i) {
+            const Real* f = &forwards[i*batchSize];
+            Real* t = &tmpBatch_[i*batchSize];
+            for (Size p=0; p<paths; ++p)
+                t[p] = (f[p]+displacements_[i]) / (oneOverTaus_[i]+f[p]);
+        }
+
+        if (isFullFactor_) {
+            for (Size i=alive_; i<numberOfRates_; ++i) {
+                Real* d = &drifts[i*batchSize];
+                std::fill(d, d+paths, 0.0);
+                for (Size k=downs_[i]; k<ups_[i]; ++k) {
+                    const Real* t = &tmpBatch_[k*batchSize];
+                    Real c = C_[i][k];
+                    for (Size p=0; p<paths; ++p)
+                        d[p] += t[p]*c;
+                }
+                if (numeraire_>i+1) {
+                    for (Size p=0; p<paths; ++p)
+                        d[p] = -d[p];
+                }
+            }
+            return;
+        }
+
+        // e_[r][i] for the current i, for each path
+        eBatch_.resize(numberOfFactors_*batchSize);
+
+        if (numeraire_>0)
+            std::fill(&drifts[(numeraire_-1)*batchSize],
+                      &drifts[(numeraire_-1)*batchSize]+paths, 0.0);
+
+        // move backward from N-2 to alive, starting from e = 0
+        std::fill(eBatch_.begin(), eBatch_.end(), 0.0);
+        for (Integer i=static_cast<Integer>(numeraire_)-2;
+             i>=static_cast<Integer>(alive_); --i) {
+            Real* d = &drifts[i*batchSize];
+            const Real* t = &tmpBatch_[(i+1)*batchSize];
+            std::fill(d, d+paths, 0.0);
+            for (Size r=0; r<numberOfFactors_; ++r) {
+                Real* e = &eBatch_[r*batchSize];
+                Real a = pseudo_[i+1][r], b = pseudo_[i][r];
+                for (Size p=0; p<paths; ++p) {
+                    e[p] += t[p] * a;
+                    d[p] -= e[p]*b;
+                }
+            }
+        }
+
+        // move forward from N up to n, again starting from e = 0
+        std::fill(eBatch_.begin(), eBatch_.end(), 0.0);
+        for (Size i=numeraire_; i<numberOfRates_; ++i) {
+            Real* d = &drifts[i*batchSize];
+            const Real* t = &tmpBatch_[i*batchSize];
+            std::fill(d, d+paths, 0.0);
+            for (Size r=0; r<numberOfFactors_; ++r) {
+                Real* e = &eBatch_[r*batchSize];
+                Real a = pseudo_[i][r];
+                for (Size p=0; p<paths; ++p) {
+                    e[p] += t[p] * a;
+                    d[p] += e[p]*a;
+                }
+            }
+        }
+    }
+
 }
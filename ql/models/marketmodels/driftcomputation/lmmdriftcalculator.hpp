@@ -64,6 +64,17 @@ namespace QuantLib {
         void computeReduced(const std::vector<Rate>& fwds,
                             std::vector<Real>& drifts) const;
 
+        /*! Computes the drifts for a batch of paths stored in
+            structure-of-arrays layout: forward \f$ i \f$ of path
+            \f$ p \f$ is at index \f$ i b + p \f$, \f$ b \f$ being
+            the batch size, and only the first \f$ n \f$ paths are
+            used.  Drifts are returned in the same layout and are the
+            same as those computed path by path. */
+        void computeBatch(const std::vector<Rate>& fwds,
+                          Size batchSize,
+                          Size paths,
+                          std::vector<Real>& drifts) const;
+
       private:
         Size numberOfRates_, numberOfFactors_;
         bool isFullFactor_;
@@ -74,6 +85,7 @@ namespace QuantLib {
         // temporary variables to be added later
         mutable std::vector<Real> tmp_;
         mutable Matrix e_;
+        mutable std::vector<Real> tmpBatch_, eBatch_;
         std::vector<Size> downs_, ups_;
     };
 
@@ -44,6 +44,37 @@ namespace QuantLib {
         virtual void setInitialState(const CurveState&) = 0;
     };
 
+    //! Market-model evolver advancing a batch of paths at once
+    /*! Abstract base class. Paths are evolved together, step by
+        step, so that the evolver can store their state in
+        structure-of-arrays layout and run its computations over the
+        whole batch in tight loops.
+    */
+    class MarketModelBatchEvolver {
+      public:
+        virtual ~MarketModelBatchEvolver() {}
+
+        virtual const std::vector<Size>& numeraires() const = 0;
+        //! maximum number of paths in a batch
+        virtual Size batchSize() const = 0;
+        //! starts the given number of paths, at most batchSize()
+        virtual void startNewBatch(Size paths) = 0;
+        virtual void advanceStep() = 0;
+        virtual Size currentStep() const = 0;
+        //! number of paths in the current batch
+        virtual Size paths() const = 0;
+        //! weights of the current paths for the last step taken
+        /*! Right after startNewBatch(), these are the weights of the
+            start of the paths.  As for MarketModelEvolver, the weight
+            of a path is the product of those of its start and of the
+            steps taken until its product is done.
+        */
+        virtual const Real* weights() const = 0;
+        //! curve state of the given path in the current batch
+        virtual const CurveState& currentState(Size path) const = 0;
+        virtual void setInitialState(const CurveState&) = 0;
+    };
+
 }
 
 #endif
@@ -0,0 +1,197 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/models/marketmodels/evolvers/batchlognormalfwdratepc.hpp>
+#include <ql/models/marketmodels/marketmodel.hpp>
+#include <ql/models/marketmodels/evolutiondescription.hpp>
+
+namespace QuantLib {
+
+    BatchLogNormalFwdRatePc::BatchLogNormalFwdRatePc(
+                           const std::shared_ptr<MarketModel>& marketModel,
+                           const BrownianGeneratorFactory& factory,
+                           const std::vector<Size>& numeraires,
+                           Size batchSize,
+                           Size initialStep)
+    : marketModel_(marketModel),
+      numeraires_(numeraires),
+      initialStep_(initialStep),
+      generator_(factory.create(marketModel->numberOfFactors(),
+                                marketModel->evolution().numberOfSteps()
+                                - initialStep),
+                 batchSize),
+      numberOfRates_(marketModel->numberOfRates()),
+      numberOfFactors_(marketModel_->numberOfFactors()),
+      batchSize_(batchSize),
+      curveStates_(batchSize,
+                   LMMCurveState(marketModel->evolution().rateTimes())),
+      currentStep_(initialStep),
+      displacements_(marketModel->displacements()),
+      initialLogForwards_(numberOfRates_), initialDrifts_(numberOfRates_),
+      forwards_(numberOfRates_*batchSize), logForwards_(numberOfRates_*batchSize),
+      drifts1_(numberOfRates_*batchSize), drifts2_(numberOfRates_*batchSize),
+      pathForwards_(numberOfRates_),
+      alive_(marketModel->evolution().firstAliveRate())
+    {
+        checkCompatibility(marketModel->evolution(), numeraires);
+
+        Size steps = marketModel->evolution().numberOfSteps();
+
+        calculators_.reserve(steps);
+        fixedDrifts_.reserve(steps);
+        for (Size j=0; j<steps; ++j) {
+            const Matrix& A = marketModel_->pseudoRoot(j);
+            calculators_.emplace_back(
+                LMMDriftCalculator(A,
+                                   displacements_,
+                                   marketModel->evolution().rateTaus(),
+                                   numeraires[j],
+                                   alive_[j]));
+            std::vector<Real> fixed(numberOfRates_);
+            for (Size k=0; k<numberOfRates_; ++k) {
+                Real variance =
+                    std::inner_product(A.row_begin(k), A.row_end(k),
+                                       A.row_begin(k), 0.0);
+                fixed[k] = -0.5*variance;
+            }
+            fixedDrifts_.emplace_back(fixed);
+        }
+
+        setForwards(marketModel_->initialRates());
+    }
+
+    const std::vector<Size>& BatchLogNormalFwdRatePc::numeraires() const {
+        return numeraires_;
+    }
+
+    Size BatchLogNormalFwdRatePc::batchSize() const {
+        return batchSize_;
+    }
+
+    void BatchLogNormalFwdRatePc::setForwards(
+                                         const std::vector<Real>& forwards) {
+        QL_REQUIRE(forwards.size()==numberOfRates_,
+                   "mismatch between forwards and rateTimes");
+        initialForwards_ = forwards;
+        for (Size i=0; i<numberOfRates_; ++i)
+             initialLogForwards_[i] = std::log(forwards[i] +
+                                               displacements_[i]);
+        calculators_[initialStep_].compute(forwards, initialDrifts_);
+    }
+
+    void BatchLogNormalFwdRatePc::setInitialState(const CurveState& cs) {
+        setForwards(cs.forwardRates());
+    }
+
+    void BatchLogNormalFwdRatePc::startNewBatch(Size paths) {
+        generator_.nextBatch(paths);
+        currentStep_ = initialStep_;
+        for (Size i=0; i<numberOfRates_; ++i) {
+            std::fill(&logForwards_[i*batchSize_],
+                      &logForwards_[i*batchSize_]+paths,
+                      initialLogForwards_[i]);
+            std::fill(&forwards_[i*batchSize_],
+                      &forwards_[i*batchSize_]+paths,
+                      initialForwards_[i]);
+        }
+    }
+
+    void BatchLogNormalFwdRatePc::advanceStep()
+    {
+        // we're going from T1 to T2
+        Size paths = generator_.paths();
+        Size i, alive = alive_[currentStep_];
+
+        // a) compute drifts D1 at T1;
+        if (currentStep_ > initialStep_) {
+            calculators_[currentStep_].computeBatch(forwards_, batchSize_,
+                                                    paths, drifts1_);
+        } else {
+            for (i=alive; i<numberOfRates_; ++i)
+                std::fill(&drifts1_[i*batchSize_],
+                          &drifts1_[i*batchSize_]+paths,
+                          initialDrifts_[i]);
+        }
+
+        // b) evolve forwards up to T2 using D1;
+        const Real* brownians = generator_.nextStep();
+        const Matrix& A = marketModel_->pseudoRoot(currentStep_);
+        const std::vector<Real>& fixedDrift = fixedDrifts_[currentStep_];
+
+        for (i=alive; i<numberOfRates_; ++i) {
+            Real* logForwards = &logForwards_[i*batchSize_];
+            Real* forwards = &forwards_[i*batchSize_];
+            const Real* drifts = &drifts1_[i*batchSize_];
+            for (Size p=0; p<paths; ++p)
+                logForwards[p] += drifts[p] + fixedDrift[i];
+            // the diffusion is accumulated as in an inner product
+            std::fill(forwards, forwards+paths, 0.0);
+            for (Size f=0; f<numberOfFactors_; ++f) {
+                Real a = A[i][f];
+                const Real* w = brownians + f*batchSize_;
+                for (Size p=0; p<paths; ++p)
+                    forwards[p] += a*w[p];
+            }
+            for (Size p=0; p<paths; ++p) {
+                logForwards[p] += forwards[p];
+                forwards[p] = std::exp(logForwards[p]) - displacements_[i];
+            }
+        }
+
+        // c) recompute drifts D2 using the predicted forwards;
+        calculators_[currentStep_].computeBatch(forwards_, batchSize_,
+                                                paths, drifts2_);
+
+        // d) correct forwards using both drifts
+        for (i=alive; i<numberOfRates_; ++i) {
+            Real* logForwards = &logForwards_[i*batchSize_];
+            Real* forwards = &forwards_[i*batchSize_];
+            const Real* d1 = &drifts1_[i*batchSize_];
+            const Real* d2 = &drifts2_[i*batchSize_];
+            for (Size p=0; p<paths; ++p) {
+                logForwards[p] += (d2[p]-d1[p])/2.0;
+                forwards[p] = std::exp(logForwards[p]) - displacements_[i];
+            }
+        }
+
+        // e) update curve states
+        for (Size p=0; p<paths; ++p) {
+            for (i=0; i<numberOfRates_; ++i)
+                pathForwards_[i] = forwards_[i*batchSize_+p];
+            curveStates_[p].setOnForwardRates(pathForwards_);
+        }
+
+        ++currentStep_;
+    }
+
+    Size BatchLogNormalFwdRatePc::currentStep() const {
+        return currentStep_;
+    }
+
+    Size BatchLogNormalFwdRatePc::paths() const {
+        return generator_.paths();
+    }
+
+    const Real* BatchLogNormalFwdRatePc::weights() const {
+        return generator_.weights();
+    }
+
+    const CurveState& BatchLogNormalFwdRatePc::currentState(Size path) const {
+        return curveStates_[path];
+    }
+
+}
@@ -0,0 +1,91 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file batchlognormalfwdratepc.hpp
+    \brief Predictor-corrector evolver for batches of paths
+*/
+
+#ifndef quantlib_batch_forward_rate_pc_evolver_hpp
+#define quantlib_batch_forward_rate_pc_evolver_hpp
+
+#include <ql/models/marketmodels/evolver.hpp>
+#include <ql/models/marketmodels/curvestates/lmmcurvestate.hpp>
+#include <ql/models/marketmodels/driftcomputation/lmmdriftcalculator.hpp>
+#include <ql/models/marketmodels/browniangenerators/batchbrowniangenerator.hpp>
+
+namespace QuantLib {
+
+    class MarketModel;
+
+    //! Predictor-Corrector for batches of paths
+    /*! Same evolution as LogNormalFwdRatePc, applied to a batch of
+        paths at once.  Log-forwards, forwards and drifts are stored
+        in structure-of-arrays layout, so that the drift computation,
+        the multiplication by the pseudo-root and the exponentiation
+        run over contiguous arrays of paths.
+
+        Given the same Brownian generator, paths are the same as those
+        obtained from LogNormalFwdRatePc, except for the forwards
+        already reset, which are set to their initial values instead
+        of being left to those of the previous path.
+    */
+    class BatchLogNormalFwdRatePc : public MarketModelBatchEvolver {
+      public:
+        BatchLogNormalFwdRatePc(const std::shared_ptr<MarketModel>&,
+                                const BrownianGeneratorFactory&,
+                                const std::vector<Size>& numeraires,
+                                Size batchSize,
+                                Size initialStep = 0);
+        //! \name MarketModelBatchEvolver interface
+        //@{
+        const std::vector<Size>& numeraires() const;
+        Size batchSize() const;
+        void startNewBatch(Size paths);
+        void advanceStep();
+        Size currentStep() const;
+        Size paths() const;
+        const Real* weights() const;
+        const CurveState& currentState(Size path) const;
+        void setInitialState(const CurveState&);
+        //@}
+      private:
+        void setForwards(const std::vector<Real>& forwards);
+        // inputs
+        std::shared_ptr<MarketModel> marketModel_;
+        std::vector<Size> numeraires_;
+        Size initialStep_;
+        BatchBrownianGenerator generator_;
+        // fixed variables
+        std::vector<std::vector<Real> > fixedDrifts_;
+        // working variables
+        Size numberOfRates_, numberOfFactors_, batchSize_;
+        std::vector<LMMCurveState> curveStates_;
+        Size currentStep_;
+        std::vector<Rate> displacements_, initialForwards_;
+        std::vector<Rate> initialLogForwards_, initialDrifts_;
+        // in structure-of-arrays layout
+        std::vector<Rate> forwards_, logForwards_;
+        std::vector<Real> drifts1_, drifts2_;
+        std::vector<Rate> pathForwards_;
+        std::vector<Size> alive_;
+        // helper classes
+        std::vector<LMMDriftCalculator> calculators_;
+    };
+
+}
+
+#endif
@@ -23,6 +23,7 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #include <ql/models/marketmodels/evolutiondescription.hpp>
 #include <ql/models/marketmodels/curvestate.hpp>
 #include <ql/models/marketmodels/marketmodel.hpp>
+#include <ql/utilities/parallelfor.hpp>
 #include <algorithm>
 
 namespace QuantLib {
@@ -117,6 +118,20 @@ namespace QuantLib {
         partials_ = Matrix(pseudoRootStructure_->numberOfFactors(),numberRates_);
     }
 
+    PathwiseAccountingEngine::PathwiseAccountingEngine(const std::vector<std::shared_ptr<LogNormalFwdRateEuler> >& evolvers,
+        const Clone<MarketModelPathwiseMultiProduct>& product,
+        const std::shared_ptr<MarketModel>& pseudoRootStructure,
+        Real initialNumeraireValue)
+        : PathwiseAccountingEngine(std::shared_ptr<LogNormalFwdRateEuler>(), product,
+                                   pseudoRootStructure, initialNumeraireValue)
+    {
+        QL_REQUIRE(!evolvers.empty(), "no evolvers given");
+        workers_.reserve(evolvers.size());
+        for (const auto& evolver : evolvers)
+            workers_.push_back(std::make_shared<PathwiseAccountingEngine>(evolver, product,
+                                                                          pseudoRootStructure, initialNumeraireValue));
+    }
+
     Real PathwiseAccountingEngine::singlePathValues(std::vector<Real>& values)
     {
 
@@ -312,6 +327,19 @@ namespace QuantLib {
     void PathwiseAccountingEngine::multiplePathValues(SequenceStatisticsInc& stats,
         Size numberOfPaths)
     {
+        if (!workers_.empty())
+        {
+            Size workers = workers_.size();
+            std::vector<SequenceStatisticsInc> workerStats(workers);
+            parallelFor(workers, workers, [&](Size w) {
+                workers_[w]->multiplePathValues(workerStats[w],
+                                                (w+1)*numberOfPaths/workers - w*numberOfPaths/workers);
+            });
+            for (Size w=0; w < workers; ++w)
+                stats.merge(workerStats[w]);
+            return;
+        }
+
         std::vector<Real> values(product_->numberOfProducts()*(numberRates_+1));
         for (Size i=0; i<numberOfPaths; ++i)
         {
@@ -445,6 +473,22 @@ namespace QuantLib {
         partials_ = Matrix(pseudoRootStructure_->numberOfFactors(),numberRates_);
     }
 
+    PathwiseVegasAccountingEngine::PathwiseVegasAccountingEngine(const std::vector<std::shared_ptr<LogNormalFwdRateEuler> >& evolvers,
+        const Clone<MarketModelPathwiseMultiProduct>& product,
+        const std::shared_ptr<MarketModel>& pseudoRootStructure,
+        const std::vector<std::vector<Matrix> >& vegaBumps,
+        Real initialNumeraireValue)
+        : PathwiseVegasAccountingEngine(std::shared_ptr<LogNormalFwdRateEuler>(), product,
+                                        pseudoRootStructure, vegaBumps, initialNumeraireValue)
+    {
+        QL_REQUIRE(!evolvers.empty(), "no evolvers given");
+        workers_.reserve(evolvers.size());
+        for (const auto& evolver : evolvers)
+            workers_.push_back(std::make_shared<PathwiseVegasAccountingEngine>(evolver, product,
+                                                                               pseudoRootStructure, vegaBumps,
+                                                                               initialNumeraireValue));
+    }
+
     Real PathwiseVegasAccountingEngine::singlePathValues(std::vector<Real>& values)
     {
 
@@ -681,13 +725,44 @@ namespace QuantLib {
     void PathwiseVegasAccountingEngine::multiplePathValues(std::vector<Real>& means, std::vector<Real>& errors,
         Size numberOfPaths)
     {
-        std::vector<Real> values(product_->numberOfProducts()*(1+numberRates_+numberBumps_));
-        means.resize(values.size());
-        errors.resize(values.size());
-        std::vector<Real> sums(values.size(),0.0);
-        std::vector<Real> sumsqs(values.size(),0.0);
+        Size numberOfValues = product_->numberOfProducts()*(1+numberRates_+numberBumps_);
+        means.resize(numberOfValues);
+        errors.resize(numberOfValues);
+        std::vector<Real> sums(numberOfValues,0.0);
+        std::vector<Real> sumsqs(numberOfValues,0.0);
 
+        if (!workers_.empty())
+        {
+            Size workers = workers_.size();
+            std::vector<std::vector<Real> > workerSums(workers, sums), workerSumsqs(workers, sumsqs);
+            parallelFor(workers, workers, [&](Size w) {
+                workers_[w]->accumulatePathValues(workerSums[w], workerSumsqs[w],
+                                                  (w+1)*numberOfPaths/workers - w*numberOfPaths/workers);
+            });
+            for (Size w=0; w < workers; ++w)
+                for (Size j=0; j < numberOfValues; ++j)
+                {
+                    sums[j] += workerSums[w][j];
+                    sumsqs[j] += workerSumsqs[w][j];
+                }
+        }
+        else
+            accumulatePathValues(sums, sumsqs, numberOfPaths);
+
+        for (Size j=0; j < numberOfValues; ++j)
+            {
+                means[j] = sums[j]/numberOfPaths;
+                Real meanSq = sumsqs[j]/numberOfPaths;
+                Real variance = meanSq - means[j]*means[j];
+                errors[j] = std::sqrt(variance/numberOfPaths);
+
+            }
+    }
 
+    void PathwiseVegasAccountingEngine::accumulatePathValues(std::vector<Real>& sums, std::vector<Real>& sumsqs,
+        Size numberOfPaths)
+    {
+        std::vector<Real> values(sums.size());
 
         for (Size i=0; i<numberOfPaths; ++i)
         {
@@ -700,15 +775,6 @@ namespace QuantLib {
 
             }
         }
-
-        for (Size j=0; j < values.size(); ++j)
-            {
-                means[j] = sums[j]/numberOfPaths;
-                Real meanSq = sumsqs[j]/numberOfPaths;
-                Real variance = meanSq - means[j]*means[j];
-                errors[j] = std::sqrt(variance/numberOfPaths);
-
-            }
     }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -868,6 +934,22 @@ namespace QuantLib {
 */
     }
 
+    PathwiseVegasOuterAccountingEngine::PathwiseVegasOuterAccountingEngine(const std::vector<std::shared_ptr<LogNormalFwdRateEuler> >& evolvers,
+        const Clone<MarketModelPathwiseMultiProduct>& product,
+        const std::shared_ptr<MarketModel>& pseudoRootStructure,
+        const std::vector<std::vector<Matrix> >& vegaBumps,
+        Real initialNumeraireValue)
+        : PathwiseVegasOuterAccountingEngine(std::shared_ptr<LogNormalFwdRateEuler>(), product,
+                                             pseudoRootStructure, vegaBumps, initialNumeraireValue)
+    {
+        QL_REQUIRE(!evolvers.empty(), "no evolvers given");
+        workers_.reserve(evolvers.size());
+        for (const auto& evolver : evolvers)
+            workers_.push_back(std::make_shared<PathwiseVegasOuterAccountingEngine>(evolver, product,
+                                                                                    pseudoRootStructure, vegaBumps,
+                                                                                    initialNumeraireValue));
+    }
+
     Real PathwiseVegasOuterAccountingEngine::singlePathValues(std::vector<Real>& values)
     {
 
@@ -1123,13 +1205,44 @@ namespace QuantLib {
     {
         Size numberOfElementaryVegas = numberRates_*numberSteps_*factors_;
 
-        std::vector<Real> values(product_->numberOfProducts()*(1+numberRates_+numberOfElementaryVegas));
-        means.resize(values.size());
-        errors.resize(values.size());
-        std::vector<Real> sums(values.size(),0.0);
-        std::vector<Real> sumsqs(values.size(),0.0);
+        Size numberOfValues = product_->numberOfProducts()*(1+numberRates_+numberOfElementaryVegas);
+        means.resize(numberOfValues);
+        errors.resize(numberOfValues);
+        std::vector<Real> sums(numberOfValues,0.0);
+        std::vector<Real> sumsqs(numberOfValues,0.0);
 
+        if (!workers_.empty())
+        {
+            Size workers = workers_.size();
+            std::vector<std::vector<Real> > workerSums(workers, sums), workerSumsqs(workers, sumsqs);
+            parallelFor(workers, workers, [&](Size w) {
+                workers_[w]->accumulatePathValues(workerSums[w], workerSumsqs[w],
+                                                  (w+1)*numberOfPaths/workers - w*numberOfPaths/workers);
+            });
+            for (Size w=0; w < workers; ++w)
+                for (Size j=0; j < numberOfValues; ++j)
+                {
+                    sums[j] += workerSums[w][j];
+                    sumsqs[j] += workerSumsqs[w][j];
+                }
+        }
+        else
+            accumulatePathValues(sums, sumsqs, numberOfPaths);
 
+        for (Size j=0; j < numberOfValues; ++j)
+            {
+                means[j] = sums[j]/numberOfPaths;
+                Real meanSq = sumsqs[j]/numberOfPaths;
+                Real variance = meanSq - means[j]*means[j];
+                errors[j] = std::sqrt(variance/numberOfPaths);
+
+            }
+    }
+
+    void PathwiseVegasOuterAccountingEngine::accumulatePathValues(std::vector<Real>& sums, std::vector<Real>& sumsqs,
+        Size numberOfPaths)
+    {
+        std::vector<Real> values(sums.size());
 
         for (Size i=0; i<numberOfPaths; ++i)
         {
@@ -1142,15 +1255,6 @@ namespace QuantLib {
 
             }
         }
-
-        for (Size j=0; j < values.size(); ++j)
-            {
-                means[j] = sums[j]/numberOfPaths;
-                Real meanSq = sumsqs[j]/numberOfPaths;
-                Real variance = meanSq - means[j]*means[j];
-                errors[j] = std::sqrt(variance/numberOfPaths);
-
-            }
     }
 
         void PathwiseVegasOuterAccountingEngine::multiplePathValues(std::vector<Real>& means, std::vector<Real>& errors,Size numberOfPaths)
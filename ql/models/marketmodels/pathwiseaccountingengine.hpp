@@ -41,6 +41,9 @@ namespace QuantLib {
     // using Giles--Glasserman smoking adjoints method
     // note only works with displaced LMM, and requires knowledge of pseudo-roots and displacements 
     // This is tested in MarketModelTest::testPathwiseGreeks
+    // When built with one evolver per worker, paths are split in contiguous chunks and
+    // simulated on multiple threads, each worker using its own evolver and copy of the product;
+    // statistics are merged in worker order. The evolvers must not share their Brownian generators.
     class PathwiseAccountingEngine 
     {
       public:
@@ -48,6 +51,10 @@ namespace QuantLib {
                          const Clone<MarketModelPathwiseMultiProduct>& product,
                          const std::shared_ptr<MarketModel>& pseudoRootStructure, // we need pseudo-roots and displacements
                          Real initialNumeraireValue);
+        PathwiseAccountingEngine(const std::vector<std::shared_ptr<LogNormalFwdRateEuler> >& evolvers, // one per worker
+                         const Clone<MarketModelPathwiseMultiProduct>& product,
+                         const std::shared_ptr<MarketModel>& pseudoRootStructure,
+                         Real initialNumeraireValue);
 
         void multiplePathValues(SequenceStatisticsInc& stats,
                                 Size numberOfPaths);
@@ -57,6 +64,7 @@ namespace QuantLib {
         std::shared_ptr<LogNormalFwdRateEuler> evolver_;
         Clone<MarketModelPathwiseMultiProduct> product_;
         std::shared_ptr<MarketModel> pseudoRootStructure_;
+        std::vector<std::shared_ptr<PathwiseAccountingEngine> > workers_; // one per worker
 
         Real initialNumeraireValue_;
         Size numberProducts_;
@@ -109,6 +117,8 @@ namespace QuantLib {
     // So for each vega, we have a vector of matrices. So we need a vector of vectors of matrices to compute all the vegas.
     // We do the outermost vector by time step and inner one by which vega.
     // This is tested in MarketModelTest::testPathwiseVegas
+    // Like PathwiseAccountingEngine, it can be built with one evolver per worker;
+    // the sums of the values and of their squares are then merged in worker order.
 
     class PathwiseVegasAccountingEngine 
     {
@@ -118,16 +128,25 @@ namespace QuantLib {
                          const std::shared_ptr<MarketModel>& pseudoRootStructure, // we need pseudo-roots and displacements
                          const std::vector<std::vector<Matrix> >& VegaBumps, 
                          Real initialNumeraireValue);
+        PathwiseVegasAccountingEngine(const std::vector<std::shared_ptr<LogNormalFwdRateEuler> >& evolvers, // one per worker
+                         const Clone<MarketModelPathwiseMultiProduct>& product,
+                         const std::shared_ptr<MarketModel>& pseudoRootStructure,
+                         const std::vector<std::vector<Matrix> >& VegaBumps, 
+                         Real initialNumeraireValue);
 
         void multiplePathValues(std::vector<Real>& means,
                                 std::vector<Real>& errors,
                                 Size numberOfPaths);
       private:
           Real singlePathValues(std::vector<Real>& values);
+          void accumulatePathValues(std::vector<Real>& sums,
+                                    std::vector<Real>& sumsqs,
+                                    Size numberOfPaths);
 
         std::shared_ptr<LogNormalFwdRateEuler> evolver_;
         Clone<MarketModelPathwiseMultiProduct> product_;
         std::shared_ptr<MarketModel> pseudoRootStructure_;
+        std::vector<std::shared_ptr<PathwiseVegasAccountingEngine> > workers_; // one per worker
         std::vector<Size> numeraires_;
 
         Real initialNumeraireValue_;
@@ -188,6 +207,8 @@ namespace QuantLib {
     // This implementation is different in that all the linear combinations by the bumps are done as late as possible,
     // whereas PathwiseVegasAccountingEngine does them as early as possible. 
     // This is tested in MarketModelTest::testPathwiseVegas
+    // Like PathwiseAccountingEngine, it can be built with one evolver per worker;
+    // the sums of the values and of their squares are then merged in worker order.
 
     class PathwiseVegasOuterAccountingEngine 
     {
@@ -197,6 +218,11 @@ namespace QuantLib {
                          const std::shared_ptr<MarketModel>& pseudoRootStructure, // we need pseudo-roots and displacements
                          const std::vector<std::vector<Matrix> >& VegaBumps, 
                          Real initialNumeraireValue);
+        PathwiseVegasOuterAccountingEngine(const std::vector<std::shared_ptr<LogNormalFwdRateEuler> >& evolvers, // one per worker
+                         const Clone<MarketModelPathwiseMultiProduct>& product,
+                         const std::shared_ptr<MarketModel>& pseudoRootStructure,
+                         const std::vector<std::vector<Matrix> >& VegaBumps, 
+                         Real initialNumeraireValue);
 
         //! Use to get vegas with respect to VegaBumps
         void multiplePathValues(std::vector<Real>& means,
@@ -210,10 +236,14 @@ namespace QuantLib {
 
       private:
           Real singlePathValues(std::vector<Real>& values);
+          void accumulatePathValues(std::vector<Real>& sums,
+                                    std::vector<Real>& sumsqs,
+                                    Size numberOfPaths);
 
         std::shared_ptr<LogNormalFwdRateEuler> evolver_;
         Clone<MarketModelPathwiseMultiProduct> product_;
         std::shared_ptr<MarketModel> pseudoRootStructure_;
+        std::vector<std::shared_ptr<PathwiseVegasOuterAccountingEngine> > workers_; // one per worker
         std::vector<std::vector<Matrix> > vegaBumps_; 
         std::vector<Size> numeraires_;
 
@@ -24,6 +24,8 @@
 #include <ql/math/optimization/projectedconstraint.hpp>
 
 #include <ql/utilities/null_deleter.hpp>
+#include <ql/utilities/parallelfor.hpp>
+#include <algorithm>
 
 using std::vector;
 using std::shared_ptr;
@@ -33,20 +35,35 @@ namespace QuantLib {
     CalibratedModel::CalibratedModel(Size nArguments)
     : arguments_(nArguments),
       constraint_(new PrivateConstraint(arguments_)),
-      shortRateEndCriteria_(EndCriteria::None) {}
+      shortRateEndCriteria_(EndCriteria::None), calibrationThreads_(1) {}
 
     class CalibratedModel::CalibrationFunction : public CostFunction {
       public:
         CalibrationFunction(CalibratedModel* model,
                             const vector<shared_ptr<CalibrationHelper> >& h,
                             const vector<Real>& weights,
-                            const Projection& projection)
+                            const Projection& projection,
+                            const vector<Replica>& replicas = vector<Replica>(),
+                            const vector<Size>& freeParameters = vector<Size>())
             : model_(model, null_deleter), instruments_(h),
-              weights_(weights), projection_(projection) { }
+              weights_(weights), projection_(projection),
+              replicas_(replicas), freeParameters_(freeParameters) { }
 
         virtual ~CalibrationFunction() {}
 
         virtual Real value(const Array& params) const {
+            if (!replicas_.empty()) {
+                Size n = instruments_.size(), workers = replicas_.size()+1;
+                Array errors(n);
+                parallelFor(workers, workers, [&](Size w) {
+                    calibrationErrors(w, params, w*n/workers,
+                                      (w+1)*n/workers, errors);
+                });
+                Real value = 0.0;
+                for (Size i=0; i<instruments_.size(); i++)
+                    value += errors[i]*errors[i]*weights_[i];
+                return std::sqrt(value);
+            }
             model_->setParams(projection_.include(params));
             Real value = 0.0;
             for (Size i=0; i<instruments_.size(); i++) {
@@ -57,6 +74,17 @@ namespace QuantLib {
         }
 
         virtual Array values(const Array& params) const {
+            if (!replicas_.empty()) {
+                Size n = instruments_.size(), workers = replicas_.size()+1;
+                Array values(n);
+                parallelFor(workers, workers, [&](Size w) {
+                    calibrationErrors(w, params, w*n/workers,
+                                      (w+1)*n/workers, values);
+                });
+                for (Size i=0; i<instruments_.size(); i++)
+                    values[i] *= std::sqrt(weights_[i]);
+                return values;
+            }
             model_->setParams(projection_.include(params));
             Array values(instruments_.size());
             for (Size i=0; i<instruments_.size(); i++) {
@@ -66,13 +94,102 @@ namespace QuantLib {
             return values;
         }
 
+        virtual void jacobian(Matrix& jac, const Array& x) const {
+            if (hasAnalyticJacobian()) {
+                Size n = instruments_.size(), workers = replicas_.size()+1;
+                parallelFor(workers, workers, [&](Size w) {
+                    calibrationErrorGradients(w, x, w*n/workers,
+                                              (w+1)*n/workers, jac);
+                });
+                return;
+            }
+            if (replicas_.empty()) {
+                CostFunction::jacobian(jac, x);
+                return;
+            }
+            // Same finite differences as the base class, but each
+            // worker evaluates all the helpers for a subset of the
+            // bumped parameters.
+            Real eps = finiteDifferenceEpsilon();
+            Size n = instruments_.size(), tasks = 2*x.size();
+            Size workers = std::min(replicas_.size()+1, tasks);
+            vector<Array> bumped(tasks, Array(n));
+            parallelFor(workers, workers, [&](Size w) {
+                Array xx(x);
+                for (Size k=w; k<tasks; k+=workers) {
+                    Size i = k/2;
+                    xx[i] += eps;
+                    if (k % 2 == 1)
+                        xx[i] -= 2.0*eps;
+                    calibrationErrors(w, xx, 0, n, bumped[k]);
+                    for (Size j=0; j<n; ++j)
+                        bumped[k][j] *= std::sqrt(weights_[j]);
+                    xx[i] = x[i];
+                }
+            });
+            for (Size i=0; i<x.size(); ++i) {
+                const Array& fp = bumped[2*i];
+                const Array& fm = bumped[2*i+1];
+                for (Size j=0; j<n; ++j)
+                    jac[j][i] = 0.5*(fp[j]-fm[j])/eps;
+            }
+        }
+
         virtual Real finiteDifferenceEpsilon() const { return 1e-6; }
 
+        // the helpers' gradients are used if they are all available
+        virtual bool hasAnalyticJacobian() const {
+            return !freeParameters_.empty();
+        }
+
       private:
+        // errors of the helpers in [begin,end) as calculated by the
+        // given worker; the first one uses the calibrated model
+        void calibrationErrors(Size worker, const Array& params,
+                               Size begin, Size end, Array& errors) const {
+            CalibratedModel* model = model_.get();
+            const vector<shared_ptr<CalibrationHelper> >* helpers =
+                &instruments_;
+            if (worker > 0) {
+                model = replicas_[worker-1].model.get();
+                helpers = &replicas_[worker-1].helpers;
+            }
+            model->setParams(projection_.include(params));
+            for (Size i=begin; i<end; i++)
+                errors[i] = (*helpers)[i]->calibrationError();
+        }
+
+        // rows [begin,end) of the Jacobian, calculated analytically
+        void calibrationErrorGradients(Size worker, const Array& params,
+                                       Size begin, Size end,
+                                       Matrix& jac) const {
+            CalibratedModel* model = model_.get();
+            const vector<shared_ptr<CalibrationHelper> >* helpers =
+                &instruments_;
+            if (worker > 0) {
+                model = replicas_[worker-1].model.get();
+                helpers = &replicas_[worker-1].helpers;
+            }
+            Array p = projection_.include(params);
+            model->setParams(p);
+            for (Size i=begin; i<end; i++) {
+                Array gradient = (*helpers)[i]->calibrationErrorGradient();
+                QL_REQUIRE(gradient.size() == p.size(),
+                           "mismatch between number of parameters ("
+                           << p.size() << ") and size of gradient ("
+                           << gradient.size() << ") of helper #" << i);
+                for (Size k=0; k<freeParameters_.size(); ++k)
+                    jac[i][k] = gradient[freeParameters_[k]]
+                        * std::sqrt(weights_[i]);
+            }
+        }
+
         shared_ptr<CalibratedModel> model_;
         const vector<shared_ptr<CalibrationHelper> >& instruments_;
         vector<Real> weights_;
         const Projection projection_;
+        vector<Replica> replicas_;
+        vector<Size> freeParameters_;
     };
 
     void CalibratedModel::calibrate(
@@ -97,9 +214,48 @@ namespace QuantLib {
             weights.empty() ? vector<Real>(instruments.size(), 1.0): weights;
 
         Array prms = params();
+        vector<Replica> replicas;
+        if (calibrationThreads_ > 1) {
+            replicas.reserve(calibrationThreads_-1);
+            for (Size i=1; i<calibrationThreads_; ++i) {
+                Replica r = replicaFactory_();
+                QL_REQUIRE(r.model, "null model in calibration replica");
+                QL_REQUIRE(r.model.get() != this,
+                           "calibration replica sharing the calibrated model");
+                QL_REQUIRE(r.model->params().size() == prms.size(),
+                           "mismatch between number of parameters ("
+                           << prms.size() << ") and parameters of replica ("
+                           << r.model->params().size() << ")");
+                QL_REQUIRE(r.helpers.size() == instruments.size(),
+                           "mismatch between number of instruments ("
+                           << instruments.size() << ") and helpers of replica ("
+                           << r.helpers.size() << ")");
+                replicas.push_back(r);
+            }
+            // trigger lazy calculations of shared market data
+            // before it is accessed concurrently
+            for (Size i=0; i<instruments.size(); ++i)
+                instruments[i]->marketValue();
+            for (Size k=0; k<replicas.size(); ++k)
+                for (Size i=0; i<instruments.size(); ++i)
+                    replicas[k].helpers[i]->marketValue();
+        }
         vector<bool> all(prms.size(), false);
-        Projection proj(prms,fixParameters.size()>0 ? fixParameters : all);
-        CalibrationFunction f(this,instruments,w,proj);
+        const vector<bool>& fixed =
+            fixParameters.size()>0 ? fixParameters : all;
+        Projection proj(prms,fixed);
+        // analytic Jacobian, if all helpers can provide their gradient
+        vector<Size> freeParameters;
+        bool analytic = !instruments.empty();
+        for (Size i=0; i<instruments.size() && analytic; ++i)
+            analytic = instruments[i]->providesGradient();
+        if (analytic) {
+            for (Size i=0; i<fixed.size(); ++i)
+                if (!fixed[i])
+                    freeParameters.push_back(i);
+        }
+        CalibrationFunction f(this,instruments,w,proj,replicas,
+                              freeParameters);
         ProjectedConstraint pc(c,proj);
         Problem prob(f, pc, proj.project(prms));
         shortRateEndCriteria_ = method.minimize(prob, endCriteria);
@@ -120,6 +276,16 @@ namespace QuantLib {
         return f.value(params);
     }
 
+    void CalibratedModel::setCalibrationThreads(
+                             Size threads,
+                             const std::function<Replica()>& replicaFactory) {
+        QL_REQUIRE(threads > 0, "at least one thread required");
+        QL_REQUIRE(threads == 1 || replicaFactory,
+                   "replica factory required for multi-threaded calibration");
+        calibrationThreads_ = threads;
+        replicaFactory_ = replicaFactory;
+    }
+
     Array CalibratedModel::params() const {
         Size size = 0, i;
         for (i=0; i<arguments_.size(); i++)
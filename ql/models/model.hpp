@@ -31,6 +31,7 @@
 #include <ql/models/parameter.hpp>
 #include <ql/models/calibrationhelper.hpp>
 #include <ql/math/optimization/endcriteria.hpp>
+#include <functional>
 
 namespace QuantLib {
 
@@ -83,8 +84,36 @@ namespace QuantLib {
 
 
     //! Calibrated model class
+    /*! Calibration can be made to evaluate the helpers concurrently
+        on a number of threads (see setCalibrationThreads()).  Since
+        models, engines and helpers keep mutable state, each
+        additional thread works on its own replica, i.e., a copy of
+        the model together with copies of the calibration helpers
+        whose engines price on the copied model; the helpers are
+        split among the threads, and if the optimization method asks
+        the cost function for its Jacobian (as LevenbergMarquardt
+        does when so configured) the finite-difference columns are
+        also computed concurrently.  As each helper is evaluated with
+        the same parameters as in the serial calibration, results
+        match it exactly.
+
+        \warning during a multi-threaded calibration, market data
+                 and term structures are accessed concurrently by
+                 the replicas.  They are calculated up front by
+                 asking each helper for its market value, but must
+                 not be modified until the calibration is over.
+    */
     class CalibratedModel : public virtual Observer, public virtual Observable {
       public:
+        //! copy of a model and of the helpers used for its calibration
+        /*! The helpers must be in the same order as the ones passed to
+            calibrate(), and their engines must price on the copied model.
+        */
+        struct Replica {
+            std::shared_ptr<CalibratedModel> model;
+            std::vector<std::shared_ptr<CalibrationHelper> > helpers;
+        };
+
         CalibratedModel(Size nArguments);
 
         void update() {
@@ -107,6 +136,19 @@ namespace QuantLib {
         Real value(const Array& params,
                    const std::vector<std::shared_ptr<CalibrationHelper> >&);
 
+        /*! Sets the number of threads used by calibrate().  When more
+            than one thread is used, the factory is called at the
+            start of each calibration to build a replica for each
+            thread besides the calling one, which works on this model
+            and the passed helpers.
+        */
+        void setCalibrationThreads(
+                         Size threads,
+                         const std::function<Replica()>& replicaFactory =
+                                                  std::function<Replica()>());
+        //! number of threads used by calibrate()
+        Size calibrationThreads() const { return calibrationThreads_; }
+
         const std::shared_ptr<Constraint>& constraint() const;
 
         //! Returns end criteria result
@@ -130,6 +172,8 @@ namespace QuantLib {
         Integer functionEvaluation_;
 
       private:
+        Size calibrationThreads_;
+        std::function<Replica()> replicaFactory_;
         //! Constraint imposed on arguments
         class PrivateConstraint;
         //! Calibration cost function class
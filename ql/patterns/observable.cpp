@@ -63,9 +63,9 @@ namespace QuantLib {
         else if (observers_.size()) {
             bool successful = true;
             std::string errMsg;
-            for (iterator i=observers_.begin(); i!=observers_.end(); ++i) {
+            observers_.forEach([&](Observer* o) {
                 try {
-                    (*i)->update();
+                    o->update();
                 } catch (std::exception& e) {
                     // quite a dilemma. If we don't catch the exception,
                     // other observers will not receive the notification
@@ -79,7 +79,7 @@ namespace QuantLib {
                 } catch (...) {
                     successful = false;
                 }
-            }
+            });
             QL_ENSURE(successful,
                   "could not notify one or more observers: " << errMsg);
         }
@@ -114,7 +114,8 @@ namespace QuantLib {
     void Observable::notifyObservers() {
         if (settings_.updatesEnabled()) {
             std::scoped_lock<std::recursive_mutex> lock(mutex_);
-            set_type observers_copy_(observers_);
+            const std::vector<std::shared_ptr<Observer::Proxy> >
+                observers_copy_(observers_.begin(), observers_.end());
             for (auto const &o : observers_copy_) {
                 if (o) {
                     o->update();
@@ -126,7 +127,8 @@ namespace QuantLib {
         std::scoped_lock<std::mutex> sLock(settings_.mutex_);
         if (settings_.updatesEnabled()) {
             std::scoped_lock<std::recursive_mutex> lock(mutex_);
-            set_type observers_copy_(observers_);
+            const std::vector<std::shared_ptr<Observer::Proxy> >
+                observers_copy_(observers_.begin(), observers_.end());
             for (auto const &o : observers_copy_) {
                 if (o) {
                     o->update();
@@ -142,7 +144,7 @@ namespace QuantLib {
     }
 
     Observable::Observable()
-            : settings_(ObservableSettings::instance()), observers_(1000) {}
+            : settings_(ObservableSettings::instance()) {}
 
     Observable::Observable(const Observable &)
             : settings_(ObservableSettings::instance()) {
@@ -32,6 +32,7 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #include <ql/errors.hpp>
 #include <ql/types.hpp>
 #include <ql/patterns/singleton.hpp>
+#include <ql/patterns/observerset.hpp>
 
 #include <memory>
 #include <algorithm>
@@ -70,7 +71,7 @@ namespace QuantLib {
                   updatesDeferred_(false) {}
 
         void registerDeferredObservers(
-                const std::unordered_set<Observer *> &observers);
+                const detail::ObserverSet<Observer *> &observers);
 
         void unregisterDeferredObserver(Observer *);
 
@@ -88,9 +89,7 @@ namespace QuantLib {
 
     public:
         // constructors, assignment, destructor
-        // set the bucket size to prevent unordered_set rehashing, which invalidates iterators if inserting into
-        // unordered_set while iterating!!
-        Observable() : settings_(ObservableSettings::instance()), observers_(1000) {}
+        Observable() : settings_(ObservableSettings::instance()) {}
 
         Observable(const Observable &);
 
@@ -104,13 +103,12 @@ namespace QuantLib {
         void notifyObservers();
 
     private:
-        typedef std::unordered_set<Observer *>::iterator iterator;
-
-        std::pair<iterator, bool> registerObserver(Observer *);
+        bool registerObserver(Observer *);
 
         Size unregisterObserver(Observer *);
 
-        std::unordered_set<Observer *> observers_;
+        // observers can register or unregister during notification
+        detail::ObserverSet<Observer *> observers_;
         ObservableSettings &settings_;
     };
 
@@ -158,9 +156,14 @@ namespace QuantLib {
     // inline definitions
 
     inline void ObservableSettings::registerDeferredObservers(
-            const std::unordered_set<Observer *> &observers) {
+            const detail::ObserverSet<Observer *> &observers) {
         if (updatesDeferred()) {
-            deferredObservers_.insert(observers.begin(), observers.end());
+            typedef detail::ObserverSet<Observer *>::const_iterator iter;
+            for (iter i = observers.begin(); i != observers.end(); ++i) {
+                // skip observers removed during an ongoing notification
+                if (*i)
+                    deferredObservers_.insert(*i);
+            }
         }
     }
 
@@ -190,8 +193,7 @@ namespace QuantLib {
         return *this;
     }
 
-    inline std::pair<std::unordered_set<Observer *>::iterator, bool>
-    Observable::registerObserver(Observer *o) {
+    inline bool Observable::registerObserver(Observer *o) {
         return observers_.insert(o);
     }
 
@@ -345,9 +347,9 @@ namespace QuantLib {
     class Observable {
         friend class Observer;
       public:
-        typedef std::unordered_set<std::shared_ptr<Observer::Proxy> >
+        typedef detail::ObserverSet<std::shared_ptr<Observer::Proxy> >
             set_type;
-        typedef set_type::iterator iterator;
+        typedef set_type::const_iterator iterator;
 
         // constructors, assignment, destructor
         Observable();
@@ -405,7 +407,11 @@ namespace QuantLib {
 
     inline void ObservableSettings::registerDeferredObservers(
         const Observable::set_type& observers) {
-        deferredObservers_.insert(observers.begin(), observers.end());
+        for (Observable::iterator i = observers.begin();
+             i != observers.end(); ++i) {
+            if (*i)
+                deferredObservers_.insert(*i);
+        }
     }
 
     inline void ObservableSettings::unregisterDeferredObserver(
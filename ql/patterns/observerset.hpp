@@ -0,0 +1,240 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file observerset.hpp
+    \brief compact set of observers used by Observable
+*/
+
+#ifndef quantlib_observer_set_hpp
+#define quantlib_observer_set_hpp
+
+#include <ql/types.hpp>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace QuantLib {
+
+    namespace detail {
+
+        //! unordered set of observers with inline storage
+        /*! The first \c N elements are stored inline; the set only
+            allocates when it grows beyond that, which is rare since
+            most observables are watched by a handful of observers.
+            Lookups are linear until the set holds more than
+            \c IndexThreshold elements, after which a hash index is
+            built to keep registration and removal in constant time.
+
+            Elements can be added or removed while the set is being
+            traversed by forEach(): new elements are not visited by
+            the ongoing traversal, and removed ones are replaced by
+            null placeholders which are compacted away when the
+            outermost traversal ends.  Placeholders can also be seen
+            through begin() and end() during a traversal and must be
+            skipped by the caller.
+
+            \pre \c T must be default-constructible into a null value
+                 and contextually convertible to \c bool.
+        */
+        template <class T, Size N = 4>
+        class ObserverSet {
+          public:
+            typedef const T* const_iterator;
+            enum { IndexThreshold = 32 };
+
+            ObserverSet() : slots_(0), size_(0), traversals_(0) {}
+            ObserverSet(const ObserverSet& other)
+            : slots_(0), size_(0), traversals_(0) {
+                for (const_iterator i=other.begin(); i!=other.end(); ++i)
+                    if (*i)
+                        insert(*i);
+            }
+            ObserverSet& operator=(const ObserverSet& other) {
+                if (&other != this) {
+                    clear();
+                    for (const_iterator i=other.begin(); i!=other.end(); ++i)
+                        if (*i)
+                            insert(*i);
+                }
+                return *this;
+            }
+
+            //! returns false if the element was already in the set
+            bool insert(const T& x) {
+                if (find(x) != slots_)
+                    return false;
+                if (heap_.empty() && slots_ < N) {
+                    inline_[slots_] = x;
+                } else {
+                    if (heap_.empty())
+                        moveToHeap();
+                    heap_.push_back(x);
+                }
+                if (index_)
+                    (*index_)[x] = slots_;
+                ++slots_;
+                ++size_;
+                if (!index_ && slots_ > IndexThreshold)
+                    buildIndex();
+                return true;
+            }
+
+            //! returns the number of removed elements, i.e., 0 or 1
+            Size erase(const T& x) {
+                Size i = find(x);
+                if (i == slots_)
+                    return 0;
+                if (index_)
+                    index_->erase(x);
+                --size_;
+                T* d = data();
+                if (traversals_ > 0) {
+                    // keep the positions stable for the ongoing traversal
+                    d[i] = T();
+                    return 1;
+                }
+                Size last = slots_-1;
+                if (i != last) {
+                    d[i] = std::move(d[last]);
+                    if (index_)
+                        (*index_)[d[i]] = i;
+                }
+                popBack();
+                return 1;
+            }
+
+            void clear() {
+                for (Size i=0; i<N; ++i)
+                    inline_[i] = T();
+                std::vector<T>().swap(heap_);
+                index_.reset();
+                slots_ = size_ = 0;
+            }
+
+            Size size() const { return size_; }
+            bool empty() const { return size_ == 0; }
+
+            const_iterator begin() const { return data(); }
+            const_iterator end() const { return data() + slots_; }
+
+            //! calls f on each element, allowing changes to the set
+            template <class F>
+            void forEach(F f) {
+                TraversalGuard guard(*this);
+                Size n = slots_;
+                for (Size i=0; i<n; ++i) {
+                    // storage might be moved by insertions made by f
+                    T x = data()[i];
+                    if (x)
+                        f(x);
+                }
+            }
+
+          private:
+            class TraversalGuard {
+              public:
+                explicit TraversalGuard(ObserverSet& s) : s_(s) {
+                    ++s_.traversals_;
+                }
+                ~TraversalGuard() {
+                    if (--s_.traversals_ == 0 && s_.size_ != s_.slots_)
+                        s_.compact();
+                }
+              private:
+                ObserverSet& s_;
+            };
+
+            T* data() { return heap_.empty() ? inline_ : &heap_[0]; }
+            const T* data() const {
+                return heap_.empty() ? inline_ : &heap_[0];
+            }
+
+            Size find(const T& x) const {
+                if (index_) {
+                    typename index_type::const_iterator i = index_->find(x);
+                    return i != index_->end() ? i->second : slots_;
+                }
+                const T* d = data();
+                for (Size i=0; i<slots_; ++i)
+                    if (d[i] == x)
+                        return i;
+                return slots_;
+            }
+
+            void moveToHeap() {
+                heap_.reserve(2*N);
+                for (Size i=0; i<slots_; ++i) {
+                    heap_.push_back(std::move(inline_[i]));
+                    inline_[i] = T();
+                }
+            }
+
+            void popBack() {
+                if (heap_.empty())
+                    inline_[slots_-1] = T();
+                else
+                    heap_.pop_back();
+                --slots_;
+                // the heap is empty once the last element is removed;
+                // release its memory and the index as well
+                if (slots_ == 0) {
+                    std::vector<T>().swap(heap_);
+                    index_.reset();
+                }
+            }
+
+            void compact() {
+                T* d = data();
+                Size j = 0;
+                for (Size i=0; i<slots_; ++i) {
+                    if (d[i]) {
+                        if (i != j) {
+                            d[j] = std::move(d[i]);
+                            d[i] = T();
+                            if (index_)
+                                (*index_)[d[j]] = j;
+                        }
+                        ++j;
+                    }
+                }
+                while (slots_ > j)
+                    popBack();
+            }
+
+            void buildIndex() {
+                index_.reset(new index_type);
+                const T* d = data();
+                for (Size i=0; i<slots_; ++i)
+                    if (d[i])
+                        (*index_)[d[i]] = i;
+            }
+
+            typedef std::unordered_map<T, Size> index_type;
+
+            T inline_[N];
+            std::vector<T> heap_;
+            std::unique_ptr<index_type> index_;
+            Size slots_, size_, traversals_;
+        };
+
+    }
+
+}
+
+
+#endif
@@ -58,7 +58,8 @@ namespace QuantLib {
              Size requiredSamples,
              Real requiredTolerance,
              Size maxSamples,
-             BigNatural seed);
+             BigNatural seed,
+             Size nThreads = 1);
         void calculate() const {
             McSimulation<SingleVariate,RNG,S>::calculate(requiredTolerance_,
                                                          requiredSamples_,
@@ -87,6 +88,19 @@ namespace QuantLib {
                          new path_generator_type(process_, grid,
                                                  gen, brownianBridge_));
         }
+        std::shared_ptr<path_generator_type>
+        workerPathGenerator(Size worker) const {
+
+            TimeGrid grid = this->timeGrid();
+            typename RNG::rsg_type gen =
+                RNG::make_sequence_generator(
+                    grid.size()-1,
+                    McSimulation<SingleVariate,RNG,S>::workerSeed(seed_,
+                                                                  worker));
+            return std::shared_ptr<path_generator_type>(
+                         new path_generator_type(process_, grid,
+                                                 gen, brownianBridge_));
+        }
         Real controlVariateValue() const;
         // data members
         std::shared_ptr<GeneralizedBlackScholesProcess> process_;
@@ -109,8 +123,10 @@ namespace QuantLib {
              Size requiredSamples,
              Real requiredTolerance,
              Size maxSamples,
-             BigNatural seed)
-    : McSimulation<SingleVariate,RNG,S>(antitheticVariate, controlVariate),
+             BigNatural seed,
+             Size nThreads)
+    : McSimulation<SingleVariate,RNG,S>(antitheticVariate, controlVariate,
+                                        nThreads),
       process_(process), requiredSamples_(requiredSamples),
       maxSamples_(maxSamples), requiredTolerance_(requiredTolerance),
       brownianBridge_(brownianBridge), seed_(seed) {
@@ -74,7 +74,8 @@ namespace QuantLib {
              Real requiredTolerance,
              Size maxSamples,
              bool isBiased,
-             BigNatural seed);
+             BigNatural seed,
+             Size nThreads = 1);
         void calculate() const {
             Real spot = process_->x0();
             QL_REQUIRE(spot >= 0.0, "negative or null underlying given");
@@ -98,7 +99,22 @@ namespace QuantLib {
                          new path_generator_type(process_,
                                                  grid, gen, brownianBridge_));
         }
-        std::shared_ptr<path_pricer_type> pathPricer() const;
+        std::shared_ptr<path_pricer_type> pathPricer() const {
+            return workerPathPricer(0);
+        }
+        std::shared_ptr<path_generator_type>
+        workerPathGenerator(Size worker) const {
+            TimeGrid grid = timeGrid();
+            typename RNG::rsg_type gen =
+                RNG::make_sequence_generator(
+                    grid.size()-1,
+                    McSimulation<SingleVariate,RNG,S>::workerSeed(seed_,
+                                                                  worker));
+            return std::shared_ptr<path_generator_type>(
+                         new path_generator_type(process_,
+                                                 grid, gen, brownianBridge_));
+        }
+        std::shared_ptr<path_pricer_type> workerPathPricer(Size worker) const;
         // data members
         std::shared_ptr<GeneralizedBlackScholesProcess> process_;
         Size timeSteps_, timeStepsPerYear_;
@@ -126,6 +142,7 @@ namespace QuantLib {
         MakeMCBarrierEngine& withMaxSamples(Size samples);
         MakeMCBarrierEngine& withBias(bool b = true);
         MakeMCBarrierEngine& withSeed(BigNatural seed);
+        MakeMCBarrierEngine& withThreads(Size threads);
         // conversion to pricing engine
         operator std::shared_ptr<PricingEngine>() const;
       private:
@@ -134,6 +151,7 @@ namespace QuantLib {
         Size steps_, stepsPerYear_, samples_, maxSamples_;
         Real tolerance_;
         BigNatural seed_;
+        Size threads_;
     };
 
 
@@ -192,8 +210,9 @@ namespace QuantLib {
              Real requiredTolerance,
              Size maxSamples,
              bool isBiased,
-             BigNatural seed)
-    : McSimulation<SingleVariate,RNG,S>(antitheticVariate, false),
+             BigNatural seed,
+             Size nThreads)
+    : McSimulation<SingleVariate,RNG,S>(antitheticVariate, false, nThreads),
       process_(process), timeSteps_(timeSteps),
       timeStepsPerYear_(timeStepsPerYear),
       requiredSamples_(requiredSamples), maxSamples_(maxSamples),
@@ -233,7 +252,7 @@ namespace QuantLib {
     template <class RNG, class S>
     inline
     std::shared_ptr<typename MCBarrierEngine<RNG,S>::path_pricer_type>
-    MCBarrierEngine<RNG,S>::pathPricer() const {
+    MCBarrierEngine<RNG,S>::workerPathPricer(Size worker) const {
         std::shared_ptr<PlainVanillaPayoff> payoff =
             std::dynamic_pointer_cast<PlainVanillaPayoff>(arguments_.payoff);
         QL_REQUIRE(payoff, "non-plain payoff given");
@@ -255,8 +274,10 @@ namespace QuantLib {
                        payoff->strike(),
                        discounts));
         } else {
-            PseudoRandom::ursg_type sequenceGen(grid.size()-1,
-                                                PseudoRandom::urng_type(5));
+            // each worker samples barrier crossings from its own stream
+            PseudoRandom::ursg_type sequenceGen(
+                               grid.size()-1,
+                               PseudoRandom::urng_type(5+worker));
             return std::shared_ptr<
                         typename MCBarrierEngine<RNG,S>::path_pricer_type>(
                 new BarrierPathPricer(
@@ -278,7 +299,7 @@ namespace QuantLib {
     : process_(process), brownianBridge_(false), antithetic_(false),
       biased_(false), steps_(Null<Size>()), stepsPerYear_(Null<Size>()),
       samples_(Null<Size>()), maxSamples_(Null<Size>()),
-      tolerance_(Null<Real>()), seed_(0) {}
+      tolerance_(Null<Real>()), seed_(0), threads_(1) {}
 
     template <class RNG, class S>
     inline MakeMCBarrierEngine<RNG,S>&
@@ -350,6 +371,13 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCBarrierEngine<RNG,S>&
+    MakeMCBarrierEngine<RNG,S>::withThreads(Size threads) {
+        threads_ = threads;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline
     MakeMCBarrierEngine<RNG,S>::operator std::shared_ptr<PricingEngine>()
@@ -367,7 +395,8 @@ namespace QuantLib {
                                    samples_, tolerance_,
                                    maxSamples_,
                                    biased_,
-                                   seed_));
+                                   seed_,
+                                   threads_));
     }
 
 }
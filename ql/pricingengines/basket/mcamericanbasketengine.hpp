@@ -32,6 +32,7 @@
 #include <ql/processes/stochasticprocessarray.hpp>
 #include <ql/methods/montecarlo/lsmbasissystem.hpp>
 #include <ql/pricingengines/mclongstaffschwartzengine.hpp>
+#include <ql/methods/montecarlo/compactlongstaffschwartzpathpricer.hpp>
 #include <ql/exercise.hpp>
 #include <functional>
 
@@ -167,7 +168,7 @@ namespace QuantLib {
                                          this->arguments_.payoff));
 
         return std::shared_ptr<LongstaffSchwartzPathPricer<MultiPath> > (
-             new LongstaffSchwartzPathPricer<MultiPath>(
+             new CompactLongstaffSchwartzPathPricer<MultiPath>(
                      this->timeGrid(),
                      earlyExercisePathPricer,
                      *(process->riskFreeRate())));
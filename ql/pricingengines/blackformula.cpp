@@ -52,6 +52,43 @@ namespace {
                                                      << displacement
                                                      << ") must be positive");
     }
+
+    // kernels for the batch formulas; unlike the distribution
+    // classes, they can be inlined in vectorized loops
+    inline QuantLib::Real normalCdf(QuantLib::Real x) {
+        return 0.5*std::erfc(-x*M_SQRT1_2);
+    }
+
+    inline QuantLib::Real normalDensity(QuantLib::Real x) {
+        return 0.5*M_2_SQRTPI*M_SQRT1_2*std::exp(-0.5*x*x);
+    }
+
+    // batch input, either with one value per option or a single
+    // value broadcast to all of them
+    class BatchInput {
+      public:
+        BatchInput(const std::vector<QuantLib::Real>& values,
+                   QuantLib::Size n, const char* name)
+        : data_(values.data()), stride_(values.size() == 1 ? 0 : 1) {
+            QL_REQUIRE(values.size() == n || values.size() == 1,
+                       "wrong number of " << name << " (" << values.size()
+                       << ") for " << n << " options");
+        }
+        QuantLib::Real operator[](QuantLib::Size i) const {
+            return data_[i*stride_];
+        }
+      private:
+        const QuantLib::Real* data_;
+        QuantLib::Size stride_;
+    };
+
+    // results are written while inputs are still being read
+    template <class... Inputs>
+    void checkNotAliased(const std::vector<QuantLib::Real>& results,
+                         const Inputs&... inputs) {
+        QL_REQUIRE(((&results != &inputs) && ...),
+                   "results must not be stored into an input vector");
+    }
 }
 
 namespace QuantLib {
@@ -587,4 +624,349 @@ namespace QuantLib {
     }
 
 
+    void blackFormula(Option::Type optionType,
+                      const std::vector<Real>& strikes,
+                      const std::vector<Real>& forwards,
+                      const std::vector<Real>& stdDevs,
+                      const std::vector<Real>& discounts,
+                      std::vector<Real>& results,
+                      Real displacement) {
+        const Size n = strikes.size();
+        const BatchInput forward(forwards, n, "forwards"),
+                         stdDev(stdDevs, n, "standard deviations"),
+                         discount(discounts, n, "discounts");
+        checkNotAliased(results, strikes, forwards, stdDevs, discounts);
+
+        for (Size i=0; i<n; ++i) {
+            checkParameters(strikes[i], forward[i], displacement);
+            QL_REQUIRE(stdDev[i]>=0.0,
+                       "stdDev (" << stdDev[i] << ") must be non-negative");
+            QL_REQUIRE(discount[i]>0.0,
+                       "discount (" << discount[i] << ") must be positive");
+        }
+
+        results.resize(n);
+        const Real w = optionType;
+        for (Size i=0; i<n; ++i) {
+            const Real f = forward[i] + displacement;
+            const Real k = strikes[i] + displacement;
+            const Real d1 = std::log(f/k)/stdDev[i] + 0.5*stdDev[i];
+            const Real d2 = d1 - stdDev[i];
+            const Real result =
+                discount[i]*w*(f*normalCdf(w*d1) - k*normalCdf(w*d2));
+            results[i] = std::max(result, Real(0.0));
+        }
+
+        // degenerate cases are rare and left to the scalar formula
+        for (Size i=0; i<n; ++i) {
+            if (stdDev[i]==0.0 || strikes[i]+displacement==0.0)
+                results[i] = blackFormula(optionType, strikes[i], forward[i],
+                                          stdDev[i], discount[i],
+                                          displacement);
+        }
+    }
+
+    void blackFormulaStdDevDerivative(const std::vector<Real>& strikes,
+                                      const std::vector<Real>& forwards,
+                                      const std::vector<Real>& stdDevs,
+                                      const std::vector<Real>& discounts,
+                                      std::vector<Real>& results,
+                                      Real displacement) {
+        const Size n = strikes.size();
+        const BatchInput forward(forwards, n, "forwards"),
+                         stdDev(stdDevs, n, "standard deviations"),
+                         discount(discounts, n, "discounts");
+        checkNotAliased(results, strikes, forwards, stdDevs, discounts);
+
+        for (Size i=0; i<n; ++i) {
+            checkParameters(strikes[i], forward[i], displacement);
+            QL_REQUIRE(stdDev[i]>=0.0,
+                       "stdDev (" << stdDev[i] << ") must be non-negative");
+            QL_REQUIRE(discount[i]>0.0,
+                       "discount (" << discount[i] << ") must be positive");
+        }
+
+        results.resize(n);
+        for (Size i=0; i<n; ++i) {
+            const Real f = forward[i] + displacement;
+            const Real k = strikes[i] + displacement;
+            const Real d1 = std::log(f/k)/stdDev[i] + 0.5*stdDev[i];
+            results[i] = discount[i]*f*normalDensity(d1);
+        }
+
+        for (Size i=0; i<n; ++i) {
+            if (stdDev[i]==0.0 || strikes[i]+displacement==0.0)
+                results[i] = 0.0;
+        }
+    }
+
+    void blackFormulaForwardDerivative(Option::Type optionType,
+                                       const std::vector<Real>& strikes,
+                                       const std::vector<Real>& forwards,
+                                       const std::vector<Real>& stdDevs,
+                                       const std::vector<Real>& discounts,
+                                       std::vector<Real>& results,
+                                       Real displacement) {
+        const Size n = strikes.size();
+        const BatchInput forward(forwards, n, "forwards"),
+                         stdDev(stdDevs, n, "standard deviations"),
+                         discount(discounts, n, "discounts");
+        checkNotAliased(results, strikes, forwards, stdDevs, discounts);
+
+        for (Size i=0; i<n; ++i) {
+            checkParameters(strikes[i], forward[i], displacement);
+            QL_REQUIRE(stdDev[i]>=0.0,
+                       "stdDev (" << stdDev[i] << ") must be non-negative");
+            QL_REQUIRE(discount[i]>0.0,
+                       "discount (" << discount[i] << ") must be positive");
+        }
+
+        results.resize(n);
+        const Real w = optionType;
+        for (Size i=0; i<n; ++i) {
+            const Real f = forward[i] + displacement;
+            const Real k = strikes[i] + displacement;
+            const Real d1 = std::log(f/k)/stdDev[i] + 0.5*stdDev[i];
+            results[i] = discount[i]*w*normalCdf(w*d1);
+        }
+
+        // degenerate cases: the payoff is linear in the forward when
+        // in the money and flat when out of the money
+        for (Size i=0; i<n; ++i) {
+            const Real k = strikes[i] + displacement;
+            if (k==0.0) {
+                results[i] = (optionType==Option::Call ? discount[i] : 0.0);
+            } else if (stdDev[i]==0.0) {
+                const Real moneyness = w*(forward[i] - strikes[i]);
+                results[i] = moneyness > 0.0 ? discount[i]*w :
+                             (moneyness < 0.0 ? 0.0 : 0.5*discount[i]*w);
+            }
+        }
+    }
+
+    void blackFormulaForwardSecondDerivative(
+                                       const std::vector<Real>& strikes,
+                                       const std::vector<Real>& forwards,
+                                       const std::vector<Real>& stdDevs,
+                                       const std::vector<Real>& discounts,
+                                       std::vector<Real>& results,
+                                       Real displacement) {
+        const Size n = strikes.size();
+        const BatchInput forward(forwards, n, "forwards"),
+                         stdDev(stdDevs, n, "standard deviations"),
+                         discount(discounts, n, "discounts");
+        checkNotAliased(results, strikes, forwards, stdDevs, discounts);
+
+        for (Size i=0; i<n; ++i) {
+            checkParameters(strikes[i], forward[i], displacement);
+            QL_REQUIRE(stdDev[i]>=0.0,
+                       "stdDev (" << stdDev[i] << ") must be non-negative");
+            QL_REQUIRE(discount[i]>0.0,
+                       "discount (" << discount[i] << ") must be positive");
+        }
+
+        results.resize(n);
+        for (Size i=0; i<n; ++i) {
+            const Real f = forward[i] + displacement;
+            const Real k = strikes[i] + displacement;
+            const Real d1 = std::log(f/k)/stdDev[i] + 0.5*stdDev[i];
+            results[i] = discount[i]*normalDensity(d1)/(f*stdDev[i]);
+        }
+
+        for (Size i=0; i<n; ++i) {
+            if (stdDev[i]==0.0 || strikes[i]+displacement==0.0)
+                results[i] = 0.0;
+        }
+    }
+
+    void blackFormulaImpliedStdDev(Option::Type optionType,
+                                   const std::vector<Real>& strikes,
+                                   const std::vector<Real>& forwards,
+                                   const std::vector<Real>& blackPrices,
+                                   const std::vector<Real>& discounts,
+                                   std::vector<Real>& results,
+                                   Real displacement,
+                                   Real accuracy,
+                                   Natural maxIterations) {
+        const Size n = strikes.size();
+        const BatchInput forward(forwards, n, "forwards"),
+                         blackPrice(blackPrices, n, "prices"),
+                         discount(discounts, n, "discounts");
+        checkNotAliased(results, strikes, forwards, blackPrices, discounts);
+
+        // out-of-the-money undiscounted prices, which have a greater
+        // vega/price ratio, and the corresponding option types
+        std::vector<Real> w(n), f(n), k(n), price(n);
+        std::vector<Real> lower(n, 0.0), upper(n, 24.0);
+        std::vector<char> converged(n, 0);
+        results.resize(n);
+
+        for (Size i=0; i<n; ++i) {
+            checkParameters(strikes[i], forward[i], displacement);
+            QL_REQUIRE(discount[i]>0.0,
+                       "discount (" << discount[i] << ") must be positive");
+            QL_REQUIRE(blackPrice[i]>=0.0,
+                       "option price (" << blackPrice[i]
+                       << ") must be non-negative");
+            const Real otherOptionPrice =
+                blackPrice[i] - optionType*(forward[i]-strikes[i])*discount[i];
+            QL_REQUIRE(otherOptionPrice>=0.0,
+                       "negative " << Option::Type(-1*optionType) <<
+                       " price (" << otherOptionPrice <<
+                       ") implied by put-call parity. No solution exists for " <<
+                       optionType << " strike " << strikes[i] <<
+                       ", forward " << forward[i] <<
+                       ", price " << blackPrice[i] <<
+                       ", deflator " << discount[i]);
+
+            Option::Type type = optionType;
+            Real otmPrice = blackPrice[i];
+            if ((optionType==Option::Put && strikes[i]>forward[i])
+                || (optionType==Option::Call && strikes[i]<forward[i])) {
+                type = Option::Type(-1*optionType);
+                otmPrice = otherOptionPrice;
+            }
+
+            w[i] = type;
+            f[i] = forward[i] + displacement;
+            k[i] = strikes[i] + displacement;
+            price[i] = otmPrice/discount[i];
+
+            const Real guess = blackFormulaImpliedStdDevApproximation(
+                type, strikes[i], forward[i], otmPrice,
+                discount[i], displacement);
+            results[i] = std::min(std::max(guess, Real(1.0e-4)), Real(23.0));
+
+            if (price[i]==0.0 || k[i]==0.0) {
+                // no time value left, or nothing to solve for
+                results[i] = 0.0;
+                converged[i] = 1;
+            }
+        }
+
+        Size pending = n;
+        for (Natural iteration=0;
+             iteration<maxIterations && pending>0; ++iteration) {
+            pending = 0;
+            for (Size i=0; i<n; ++i) {
+                if (converged[i])
+                    continue;
+                const Real x = results[i];
+                const Real d1 = std::log(f[i]/k[i])/x + 0.5*x;
+                const Real d2 = d1 - x;
+                const Real error =
+                    w[i]*(f[i]*normalCdf(w[i]*d1) - k[i]*normalCdf(w[i]*d2))
+                    - price[i];
+                const Real vega = f[i]*normalDensity(d1);
+
+                // the price is increasing in the standard deviation
+                if (error > 0.0)
+                    upper[i] = x;
+                else
+                    lower[i] = x;
+
+                Real next = x - error/vega;
+                // bisect whenever Newton leaves the bracket
+                if (!(next > lower[i] && next < upper[i]))
+                    next = 0.5*(lower[i] + upper[i]);
+
+                results[i] = next;
+                if (std::fabs(next - x) < accuracy)
+                    converged[i] = 1;
+                else
+                    ++pending;
+            }
+        }
+
+        for (Size i=0; i<n; ++i) {
+            if (!converged[i])
+                results[i] = blackFormulaImpliedStdDev(
+                    optionType, strikes[i], forward[i], blackPrice[i],
+                    discount[i], displacement, Null<Real>(),
+                    accuracy, maxIterations);
+        }
+    }
+
+    void bachelierBlackFormula(Option::Type optionType,
+                               const std::vector<Real>& strikes,
+                               const std::vector<Real>& forwards,
+                               const std::vector<Real>& stdDevs,
+                               const std::vector<Real>& discounts,
+                               std::vector<Real>& results) {
+        const Size n = strikes.size();
+        const BatchInput forward(forwards, n, "forwards"),
+                         stdDev(stdDevs, n, "standard deviations"),
+                         discount(discounts, n, "discounts");
+        checkNotAliased(results, strikes, forwards, stdDevs, discounts);
+
+        for (Size i=0; i<n; ++i) {
+            QL_REQUIRE(stdDev[i]>=0.0,
+                       "stdDev (" << stdDev[i] << ") must be non-negative");
+            QL_REQUIRE(discount[i]>0.0,
+                       "discount (" << discount[i] << ") must be positive");
+        }
+
+        results.resize(n);
+        const Real w = optionType;
+        for (Size i=0; i<n; ++i) {
+            const Real d = (forward[i]-strikes[i])*w, h = d/stdDev[i];
+            const Real result =
+                discount[i]*(stdDev[i]*normalDensity(h) + d*normalCdf(h));
+            results[i] = std::max(result, Real(0.0));
+        }
+
+        for (Size i=0; i<n; ++i) {
+            if (stdDev[i]==0.0)
+                results[i] = discount[i]
+                    * std::max((forward[i]-strikes[i])*w, Real(0.0));
+        }
+    }
+
+    void bachelierBlackFormulaImpliedVol(
+                                 Option::Type optionType,
+                                 const std::vector<Real>& strikes,
+                                 const std::vector<Real>& forwards,
+                                 const std::vector<Real>& ttes,
+                                 const std::vector<Real>& bachelierPrices,
+                                 const std::vector<Real>& discounts,
+                                 std::vector<Real>& results) {
+        const Size n = strikes.size();
+        const BatchInput forward(forwards, n, "forwards"),
+                         tte(ttes, n, "times to expiry"),
+                         bachelierPrice(bachelierPrices, n, "prices"),
+                         discount(discounts, n, "discounts");
+        checkNotAliased(results, strikes, forwards, ttes, bachelierPrices,
+                        discounts);
+
+        const static Real SQRT_QL_EPSILON = std::sqrt(QL_EPSILON);
+
+        // straddle premiums are kept in the results until the end
+        results.resize(n);
+        const Real w = (optionType==Option::Call ? 1.0 : -1.0);
+        for (Size i=0; i<n; ++i) {
+            QL_REQUIRE(tte[i]>0.0,
+                       "tte (" << tte[i] << ") must be positive");
+            const Real straddlePremium =
+                2.0*(bachelierPrice[i]/discount[i]) - w*(forward[i]-strikes[i]);
+            const Real nu = (forward[i]-strikes[i]) / straddlePremium;
+            QL_REQUIRE(nu<1.0 || close_enough(nu,1.0),
+                       "nu (" << nu << ") must be <= 1.0");
+            QL_REQUIRE(nu>-1.0 || close_enough(nu,-1.0),
+                       "nu (" << nu << ") must be >= -1.0");
+            results[i] = straddlePremium;
+        }
+
+        for (Size i=0; i<n; ++i) {
+            const Real straddlePremium = results[i];
+            const Real nu = std::max(-1.0 + QL_EPSILON,
+                std::min((forward[i]-strikes[i])/straddlePremium,
+                         1.0 - QL_EPSILON));
+            // nu / arctanh(nu) -> 1 as nu -> 0
+            const Real eta =
+                (std::fabs(nu) < SQRT_QL_EPSILON) ? 1.0 : nu/std::atanh(nu);
+            results[i] =
+                std::sqrt(M_PI/(2*tte[i])) * straddlePremium * h(eta);
+        }
+    }
+
 }
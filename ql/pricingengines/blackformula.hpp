@@ -33,6 +33,7 @@
 
 #include <ql/option.hpp>
 #include <ql/instruments/payoffs.hpp>
+#include <vector>
 
 namespace QuantLib {
 
@@ -287,6 +288,94 @@ namespace QuantLib {
                                                 Real stdDev,
                                                 Real discount = 1.0);
 
+
+    /*! \name Batch formulas
+
+        The following functions evaluate the corresponding formula
+        above, or the corresponding BlackCalculator greek for the
+        forward derivatives, for a whole batch of options at once,
+        writing the results into \c results (which is resized as
+        needed and must not be one of the input vectors).  Apart from the
+        strikes, each input can either have one element per option
+        or a single element which is then used for the whole batch.
+
+        Inputs are validated upfront, so that the evaluation runs in
+        tight loops over the batch; degenerate cases, such as a null
+        standard deviation, are handled in a separate pass.  Results
+        agree with the scalar versions within numerical precision,
+        except that tiny negative prices due to rounding are floored
+        at zero instead of raising an error.
+    */
+    //@{
+    void blackFormula(Option::Type optionType,
+                      const std::vector<Real>& strikes,
+                      const std::vector<Real>& forwards,
+                      const std::vector<Real>& stdDevs,
+                      const std::vector<Real>& discounts,
+                      std::vector<Real>& results,
+                      Real displacement = 0.0);
+
+    void blackFormulaStdDevDerivative(const std::vector<Real>& strikes,
+                                      const std::vector<Real>& forwards,
+                                      const std::vector<Real>& stdDevs,
+                                      const std::vector<Real>& discounts,
+                                      std::vector<Real>& results,
+                                      Real displacement = 0.0);
+
+    /*! Derivative of the price with respect to the forward, i.e.,
+        the forward delta of BlackCalculator::deltaForward().
+    */
+    void blackFormulaForwardDerivative(Option::Type optionType,
+                                       const std::vector<Real>& strikes,
+                                       const std::vector<Real>& forwards,
+                                       const std::vector<Real>& stdDevs,
+                                       const std::vector<Real>& discounts,
+                                       std::vector<Real>& results,
+                                       Real displacement = 0.0);
+
+    /*! Second derivative of the price with respect to the forward,
+        i.e., the forward gamma of BlackCalculator::gammaForward();
+        it does not depend on the option type.
+    */
+    void blackFormulaForwardSecondDerivative(
+                                       const std::vector<Real>& strikes,
+                                       const std::vector<Real>& forwards,
+                                       const std::vector<Real>& stdDevs,
+                                       const std::vector<Real>& discounts,
+                                       std::vector<Real>& results,
+                                       Real displacement = 0.0);
+
+    /*! All options are solved for simultaneously by safeguarded
+        Newton iterations; the few options not converged after
+        \c maxIterations are handed over to the scalar solver.
+    */
+    void blackFormulaImpliedStdDev(Option::Type optionType,
+                                   const std::vector<Real>& strikes,
+                                   const std::vector<Real>& forwards,
+                                   const std::vector<Real>& blackPrices,
+                                   const std::vector<Real>& discounts,
+                                   std::vector<Real>& results,
+                                   Real displacement = 0.0,
+                                   Real accuracy = 1.0e-6,
+                                   Natural maxIterations = 100);
+
+    void bachelierBlackFormula(Option::Type optionType,
+                               const std::vector<Real>& strikes,
+                               const std::vector<Real>& forwards,
+                               const std::vector<Real>& stdDevs,
+                               const std::vector<Real>& discounts,
+                               std::vector<Real>& results);
+
+    void bachelierBlackFormulaImpliedVol(
+                                 Option::Type optionType,
+                                 const std::vector<Real>& strikes,
+                                 const std::vector<Real>& forwards,
+                                 const std::vector<Real>& ttes,
+                                 const std::vector<Real>& bachelierPrices,
+                                 const std::vector<Real>& discounts,
+                                 std::vector<Real>& results);
+    //@}
+
 }
 
 #endif
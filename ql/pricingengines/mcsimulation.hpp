@@ -28,6 +28,7 @@
 
 #include <ql/grid.hpp>
 #include <ql/methods/montecarlo/montecarlomodel.hpp>
+#include <ql/math/randomnumbers/mt19937uniformrng.hpp>
 
 namespace QuantLib {
 
@@ -37,6 +38,13 @@ namespace QuantLib {
         Carlo engine.
 
         See McVanillaEngine as an example.
+
+        When more than one thread is required, samples are drawn
+        concurrently by as many workers, each one using the path
+        generator returned by workerPathGenerator() and its own path
+        pricer; engines must override the former in order to support
+        multi-threaded simulation.  For a given seed and number of
+        threads, results are reproducible.
     */
 
     template <template <class> class MC, class RNG, class S = Statistics>
@@ -67,12 +75,46 @@ namespace QuantLib {
                        Size maxSamples) const;
       protected:
         McSimulation(bool antitheticVariate,
-                     bool controlVariate)
+                     bool controlVariate,
+                     Size nThreads = 1)
         : antitheticVariate_(antitheticVariate),
-          controlVariate_(controlVariate) {}
+          controlVariate_(controlVariate), nThreads_(nThreads) {
+            QL_REQUIRE(nThreads > 0, "at least one thread required");
+        }
         virtual std::shared_ptr<path_pricer_type> pathPricer() const = 0;
         virtual std::shared_ptr<path_generator_type> pathGenerator()
                                                                    const = 0;
+        //! path generator used by the given worker
+        /*! The returned generator must draw from a random stream
+            independent of those used by the other workers.
+        */
+        virtual std::shared_ptr<path_generator_type>
+        workerPathGenerator(Size) const {
+            QL_FAIL("engine does not support multi-threaded simulation");
+        }
+        //! path pricer used by the given worker
+        virtual std::shared_ptr<path_pricer_type>
+        workerPathPricer(Size) const {
+            return this->pathPricer();
+        }
+        //! seed for the random stream of the given worker
+        /*! The first worker uses the given seed; the others use
+            seeds drawn from a Mersenne-Twister generator initialized
+            with it.  A null seed is passed through unchanged, so that
+            each worker is seeded from the clock as usual.
+        */
+        static BigNatural workerSeed(BigNatural seed, Size worker) {
+            if (seed == 0 || worker == 0)
+                return seed;
+            MersenneTwisterUniformRng rng(seed);
+            BigNatural s = 0;
+            for (Size i=0; i<worker; ++i) {
+                do {
+                    s = rng.nextInt32();
+                } while (s == 0);
+            }
+            return s;
+        }
         virtual TimeGrid timeGrid() const = 0;
         virtual std::shared_ptr<path_pricer_type> controlPathPricer() const {
             return std::shared_ptr<path_pricer_type>();
@@ -97,6 +139,9 @@ namespace QuantLib {
         
         mutable std::shared_ptr<MonteCarloModel<MC,RNG,S> > mcModel_;
         bool antitheticVariate_, controlVariate_;
+        Size nThreads_;
+      private:
+        void buildParallelModel(result_type controlVariateValue) const;
     };
 
 
@@ -172,21 +217,27 @@ namespace QuantLib {
                        "engine does not provide "
                        "control-variation price");
 
-            std::shared_ptr<path_pricer_type> controlPP =
-                this->controlPathPricer();
-            QL_REQUIRE(controlPP,
-                       "engine does not provide "
-                       "control-variation path pricer");
-
-            std::shared_ptr<path_generator_type> controlPG =
-                this->controlPathGenerator();
-
-            this->mcModel_ =
-                std::shared_ptr<MonteCarloModel<MC,RNG,S> >(
-                    new MonteCarloModel<MC,RNG,S>(
-                           pathGenerator(), this->pathPricer(), stats_type(),
-                           this->antitheticVariate_, controlPP,
-                           controlVariateValue, controlPG));
+            if (nThreads_ > 1) {
+                buildParallelModel(controlVariateValue);
+            } else {
+                std::shared_ptr<path_pricer_type> controlPP =
+                    this->controlPathPricer();
+                QL_REQUIRE(controlPP,
+                           "engine does not provide "
+                           "control-variation path pricer");
+
+                std::shared_ptr<path_generator_type> controlPG =
+                    this->controlPathGenerator();
+
+                this->mcModel_ =
+                    std::shared_ptr<MonteCarloModel<MC,RNG,S> >(
+                        new MonteCarloModel<MC,RNG,S>(
+                               pathGenerator(), this->pathPricer(), stats_type(),
+                               this->antitheticVariate_, controlPP,
+                               controlVariateValue, controlPG));
+            }
+        } else if (nThreads_ > 1) {
+            buildParallelModel(result_type());
         } else {
             this->mcModel_ =
                 std::shared_ptr<MonteCarloModel<MC,RNG,S> >(
@@ -206,6 +257,42 @@ namespace QuantLib {
 
     }
 
+    template <template <class> class MC, class RNG, class S>
+    inline void McSimulation<MC,RNG,S>::buildParallelModel(
+                                   result_type controlVariateValue) const {
+
+        QL_REQUIRE(RNG::allowsErrorEstimate,
+                   "multi-threaded simulation requires "
+                   "pseudo-random sequences");
+        QL_REQUIRE(!this->controlPathGenerator(),
+                   "multi-threaded simulation does not support "
+                   "a separate control-variation path generator");
+
+        std::vector<std::shared_ptr<path_generator_type> > generators;
+        std::vector<std::shared_ptr<path_pricer_type> > pricers, controlPricers;
+        for (Size i=0; i<nThreads_; ++i) {
+            generators.push_back(this->workerPathGenerator(i));
+            pricers.push_back(this->workerPathPricer(i));
+            if (this->controlVariate_) {
+                controlPricers.push_back(this->controlPathPricer());
+                QL_REQUIRE(controlPricers.back(),
+                           "engine does not provide "
+                           "control-variation path pricer");
+            }
+        }
+
+        // price a path on a throwaway generator so that any lazy
+        // calculation is triggered before workers run concurrently
+        (*this->pathPricer())(pathGenerator()->next().value);
+
+        this->mcModel_ =
+            std::shared_ptr<MonteCarloModel<MC,RNG,S> >(
+                new MonteCarloModel<MC,RNG,S>(
+                       generators, pricers, stats_type(),
+                       this->antitheticVariate_, controlPricers,
+                       controlVariateValue));
+    }
+
     template <template <class> class MC, class RNG, class S>
     inline typename McSimulation<MC,RNG,S>::result_type
         McSimulation<MC,RNG,S>::errorEstimate() const {
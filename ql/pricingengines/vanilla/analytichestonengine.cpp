@@ -84,6 +84,85 @@ namespace QuantLib {
             Real operator()(Real x) const { return int_(1.0 - x); }
         };
 
+        // complex number together with its derivatives with respect
+        // to the Heston parameters, in the order of HestonModel::params()
+        class ComplexGradient {
+          public:
+            static constexpr Size dimension = 5;
+            typedef std::complex<Real> complex;
+            ComplexGradient(Real v = 0.0) : v_(v) {
+                std::fill(d_, d_+dimension, complex(0.0));
+            }
+            ComplexGradient(const complex& v) : v_(v) {
+                std::fill(d_, d_+dimension, complex(0.0));
+            }
+            static ComplexGradient parameter(Real v, Size i) {
+                ComplexGradient x(v);
+                x.d_[i] = 1.0;
+                return x;
+            }
+            const complex& value() const { return v_; }
+            const complex& derivative(Size i) const {
+                return d_[i];
+            }
+
+            friend ComplexGradient operator-(const ComplexGradient& a) {
+                ComplexGradient r(-a.v_);
+                for (Size i=0; i<dimension; ++i)
+                    r.d_[i] = -a.d_[i];
+                return r;
+            }
+            friend ComplexGradient operator+(const ComplexGradient& a,
+                                             const ComplexGradient& b) {
+                ComplexGradient r(a.v_ + b.v_);
+                for (Size i=0; i<dimension; ++i)
+                    r.d_[i] = a.d_[i] + b.d_[i];
+                return r;
+            }
+            friend ComplexGradient operator-(const ComplexGradient& a,
+                                             const ComplexGradient& b) {
+                ComplexGradient r(a.v_ - b.v_);
+                for (Size i=0; i<dimension; ++i)
+                    r.d_[i] = a.d_[i] - b.d_[i];
+                return r;
+            }
+            friend ComplexGradient operator*(const ComplexGradient& a,
+                                             const ComplexGradient& b) {
+                ComplexGradient r(a.v_ * b.v_);
+                for (Size i=0; i<dimension; ++i)
+                    r.d_[i] = a.d_[i]*b.v_ + a.v_*b.d_[i];
+                return r;
+            }
+            friend ComplexGradient operator/(const ComplexGradient& a,
+                                             const ComplexGradient& b) {
+                ComplexGradient r(a.v_ / b.v_);
+                for (Size i=0; i<dimension; ++i)
+                    r.d_[i] = (a.d_[i] - r.v_*b.d_[i]) / b.v_;
+                return r;
+            }
+            friend ComplexGradient exp(const ComplexGradient& a) {
+                ComplexGradient r(std::exp(a.v_));
+                for (Size i=0; i<dimension; ++i)
+                    r.d_[i] = r.v_*a.d_[i];
+                return r;
+            }
+            friend ComplexGradient log(const ComplexGradient& a) {
+                ComplexGradient r(std::log(a.v_));
+                for (Size i=0; i<dimension; ++i)
+                    r.d_[i] = a.d_[i] / a.v_;
+                return r;
+            }
+            friend ComplexGradient sqrt(const ComplexGradient& a) {
+                ComplexGradient r(std::sqrt(a.v_));
+                for (Size i=0; i<dimension; ++i)
+                    r.d_[i] = a.d_[i] / (2.0*r.v_);
+                return r;
+            }
+          private:
+            complex v_;
+            complex d_[dimension];
+        };
+
     }
 
     // helper class for integration
@@ -363,6 +442,116 @@ namespace QuantLib {
         return evaluations_;
     }
 
+    bool AnalyticHestonEngine::providesGradient() const {
+        // extended models, e.g., Bates, have additional parameters
+        return cpxLog_ == Gatheral
+            && !integration_->isAdaptiveIntegration()
+            && integration_->isGaussianQuadrature()
+            && model_->params().size() == ComplexGradient::dimension;
+    }
+
+    Real AnalyticHestonEngine::valueAndGradient(
+                                   const VanillaOption::arguments& arguments,
+                                   Array& gradient) const {
+        QL_REQUIRE(providesGradient(),
+                   "parameter gradient not available: it requires "
+                   "Gatheral's formula, a Gaussian quadrature and "
+                   "a model with the Heston parameters only");
+        QL_REQUIRE(arguments.exercise->type() == Exercise::European,
+                   "not an European option");
+        std::shared_ptr<PlainVanillaPayoff> payoff =
+            std::dynamic_pointer_cast<PlainVanillaPayoff>(arguments.payoff);
+        QL_REQUIRE(payoff, "non plain vanilla payoff given");
+
+        const std::shared_ptr<HestonProcess>& process = model_->process();
+        const Date maturity = arguments.exercise->lastDate();
+        const Real riskFreeDiscount =
+            process->riskFreeRate()->discount(maturity);
+        const Real dividendDiscount =
+            process->dividendYield()->discount(maturity);
+        const Real spotPrice = process->s0()->value();
+        QL_REQUIRE(spotPrice > 0.0, "negative or null underlying given");
+        const Real strikePrice = payoff->strike();
+        const Time term = process->time(maturity);
+
+        const Real theta = model_->theta(), kappa = model_->kappa();
+        const Real sigma = model_->sigma(), rho = model_->rho();
+        const Real v0 = model_->v0();
+        QL_REQUIRE(term > 0.0, "null or negative time to maturity");
+
+        const ComplexGradient thetaG = ComplexGradient::parameter(theta, 0);
+        const ComplexGradient kappaG = ComplexGradient::parameter(kappa, 1);
+        const ComplexGradient sigmaG = ComplexGradient::parameter(sigma, 2);
+        const ComplexGradient rhoG = ComplexGradient::parameter(rho, 3);
+        const ComplexGradient v0G = ComplexGradient::parameter(v0, 4);
+        const ComplexGradient sigma2 = sigmaG*sigmaG;
+        const ComplexGradient kappaTheta = kappaG*thetaG;
+        const Real dd_sx = std::log(spotPrice)
+            - std::log(riskFreeDiscount/dividendDiscount)
+            - std::log(strikePrice);
+
+        // integrand of P_j, as in Fj_Helper, and its derivatives; the
+        // Gaussian abscissas are never null, so phi = 0 is not needed
+        auto integrand = [&](Real phi, Size j) -> Array {
+            const std::complex<Real> u(-phi, (j == 1) ? 1 : -1);
+            const ComplexGradient t0 =
+                (j == 1) ? kappaG - rhoG*sigmaG : kappaG;
+            const ComplexGradient t1 =
+                t0 - std::complex<Real>(0.0, phi) * rhoG*sigmaG;
+            const ComplexGradient d = sqrt(t1*t1 - sigma2*(phi*u));
+            const ComplexGradient ex = exp(-d*term);
+            ComplexGradient e;
+            if (sigma > 1e-5) {
+                const ComplexGradient p = (t1 - d) / (t1 + d);
+                const ComplexGradient g = log((1.0 - p*ex) / (1.0 - p));
+                e = v0G*(t1 - d)*(1.0 - ex) / (sigma2*(1.0 - ex*p))
+                    + kappaTheta / sigma2 * ((t1 - d)*term - 2.0*g);
+            } else {
+                const ComplexGradient td = (phi*u) / (2.0*t1);
+                const ComplexGradient p = td*sigma2 / (t1 + d);
+                const ComplexGradient g = p*(1.0 - ex);
+                e = v0G*td*(1.0 - ex) / (1.0 - p*ex)
+                    + kappaTheta * (td*term - 2.0*g / sigma2);
+            }
+            e = e + std::complex<Real>(0.0, phi*dd_sx)
+                + addOnTerm(phi, term, j);
+            const ComplexGradient f = exp(e);
+
+            Array result(ComplexGradient::dimension+1);
+            result[0] = f.value().imag() / phi;
+            for (Size i=0; i<ComplexGradient::dimension; ++i)
+                result[i+1] = f.derivative(i).imag() / phi;
+            return result;
+        };
+
+        const Real c_inf = std::min(0.2, std::max(0.0001,
+                                                  std::sqrt(1.0 - square(rho)) / sigma))
+                           * (v0 + kappa * theta * term);
+
+        const Array p1 = integration_->calculate(
+            c_inf, [&](Real phi) { return integrand(phi, 1); },
+            ComplexGradient::dimension+1) / M_PI;
+        const Array p2 = integration_->calculate(
+            c_inf, [&](Real phi) { return integrand(phi, 2); },
+            ComplexGradient::dimension+1) / M_PI;
+        evaluations_ = 2*integration_->numberOfEvaluations();
+
+        const Real s = spotPrice * dividendDiscount;
+        const Real k = strikePrice * riskFreeDiscount;
+        gradient = Array(ComplexGradient::dimension);
+        for (Size i=0; i<ComplexGradient::dimension; ++i)
+            gradient[i] = s*p1[i+1] - k*p2[i+1];
+
+        switch (payoff->optionType()) {
+          case Option::Call:
+            return s * (p1[0] + 0.5) - k * (p2[0] + 0.5);
+          case Option::Put:
+            return s * (p1[0] - 0.5) - k * (p2[0] - 0.5);
+          default:
+            QL_FAIL("unknown option type");
+        }
+    }
+
     void AnalyticHestonEngine::doCalculation(Real riskFreeDiscount,
                                              Real dividendDiscount,
                                              Real spotPrice,
@@ -553,6 +742,10 @@ namespace QuantLib {
         }
     }
 
+    bool AnalyticHestonEngine::Integration::isGaussianQuadrature() const {
+        return gaussianQuadrature_ != nullptr;
+    }
+
     bool AnalyticHestonEngine::Integration::isAdaptiveIntegration() const {
         return intAlgo_ == GaussLobatto
                || intAlgo_ == GaussKronrod
@@ -592,4 +785,27 @@ namespace QuantLib {
 
         return retVal;
     }
+
+    Array AnalyticHestonEngine::Integration::calculate(
+            Real c_inf,
+            const std::function<Array(Real)>& f,
+            Size size) const {
+        QL_REQUIRE(gaussianQuadrature_,
+                   "integration of array values requires "
+                   "a Gaussian quadrature");
+
+        const Array& x = gaussianQuadrature_->x();
+        const Array& w = gaussianQuadrature_->weights();
+        Array sum(size, 0.0);
+        // same order and change of variable as the scalar version
+        for (Integer i = gaussianQuadrature_->order()-1; i >= 0; --i) {
+            if (intAlgo_ == GaussLaguerre) {
+                sum += w[i] * f(x[i]);
+            } else if ((1.0 - x[i]) * c_inf > QL_EPSILON) {
+                sum += w[i] * f(-std::log(0.5 - 0.5 * x[i]) / c_inf)
+                    / ((1.0 - x[i]) * c_inf);
+            }
+        }
+        return sum;
+    }
 }
@@ -69,6 +69,10 @@ namespace QuantLib {
         J. Gatheral, The Volatility Surface: A Practitioner's Guide,
         Wiley Finance
 
+        Y. Cui, S. del Bano Rollin and G. Germano, Full and fast
+        calibration of the Heston stochastic volatility model,
+        European Journal of Operational Research, 263 (2), 625-638
+
         \ingroup vanillaengines
 
         \test the correctness of the returned value is tested by
@@ -105,6 +109,24 @@ namespace QuantLib {
         void calculate() const;
         Size numberOfEvaluations() const;
 
+        /*! Returns whether valueAndGradient() is available, i.e.,
+            if Gatheral's formula is integrated with a non-adaptive
+            Gaussian quadrature and the model has no parameters
+            besides the Heston ones.
+        */
+        bool providesGradient() const;
+
+        /*! Returns the value of the option described by the given
+            arguments and stores in \c gradient its derivatives with
+            respect to the model parameters, in the order of
+            HestonModel::params(), i.e., theta, kappa, sigma, rho and
+            v0.  The derivatives of the characteristic function are
+            integrated by the same quadrature, in the same pass, as
+            the characteristic function itself.
+        */
+        Real valueAndGradient(const VanillaOption::arguments& arguments,
+                              Array& gradient) const;
+
         static void doCalculation(Real riskFreeDiscount,
                                   Real dividendDiscount,
                                   Real spotPrice,
@@ -162,8 +184,15 @@ namespace QuantLib {
         Real calculate(Real c_inf,
                        std::function<Real(Real)> f) const;
 
+        // integrates a function returning an array of the given size;
+        // only available for non-adaptive Gaussian quadratures
+        Array calculate(Real c_inf,
+                        const std::function<Array(Real)>& f,
+                        Size size) const;
+
         Size numberOfEvaluations() const;
         bool isAdaptiveIntegration() const;
+        bool isGaussianQuadrature() const;
 
       private:
         enum Algorithm
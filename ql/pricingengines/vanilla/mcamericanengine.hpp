@@ -32,6 +32,7 @@
 #include <ql/methods/montecarlo/lsmbasissystem.hpp>
 #include <ql/processes/blackscholesprocess.hpp>
 #include <ql/pricingengines/mclongstaffschwartzengine.hpp>
+#include <ql/methods/montecarlo/compactlongstaffschwartzpathpricer.hpp>
 #include <ql/pricingengines/vanilla/mceuropeanengine.hpp>
 #include <ql/pricingengines/vanilla/analyticeuropeanengine.hpp>
 
@@ -187,7 +188,7 @@ namespace QuantLib {
                                    polynomOrder_, polynomType_));
 
         return std::shared_ptr<LongstaffSchwartzPathPricer<Path> > (
-             new LongstaffSchwartzPathPricer<Path>(
+             new CompactLongstaffSchwartzPathPricer<Path>(
                                       this->timeGrid(),
                                       earlyExercisePathPricer,
                                       *(process->riskFreeRate())));
@@ -65,7 +65,8 @@ namespace QuantLib {
                         Size requiredSamples,
                         Real requiredTolerance,
                         Size maxSamples,
-                        BigNatural seed);
+                        BigNatural seed,
+                        Size nThreads = 1);
         // McSimulation implementation
         TimeGrid timeGrid() const;
         std::shared_ptr<path_generator_type> pathGenerator() const {
@@ -78,6 +79,19 @@ namespace QuantLib {
                    new path_generator_type(process_, grid,
                                            generator, brownianBridge_));
         }
+        std::shared_ptr<path_generator_type>
+        workerPathGenerator(Size worker) const {
+
+            Size dimensions = process_->factors();
+            TimeGrid grid = this->timeGrid();
+            typename RNG::rsg_type generator =
+                RNG::make_sequence_generator(
+                    dimensions*(grid.size()-1),
+                    McSimulation<MC,RNG,S>::workerSeed(seed_, worker));
+            return std::shared_ptr<path_generator_type>(
+                   new path_generator_type(process_, grid,
+                                           generator, brownianBridge_));
+        }
         result_type controlVariateValue() const;
         // data members
         std::shared_ptr<StochasticProcess> process_;
@@ -102,8 +116,9 @@ namespace QuantLib {
                           Size requiredSamples,
                           Real requiredTolerance,
                           Size maxSamples,
-                          BigNatural seed)
-    : McSimulation<MC,RNG,S>(antitheticVariate, controlVariate),
+                          BigNatural seed,
+                          Size nThreads)
+    : McSimulation<MC,RNG,S>(antitheticVariate, controlVariate, nThreads),
       process_(process), timeSteps_(timeSteps),
       timeStepsPerYear_(timeStepsPerYear),
       requiredSamples_(requiredSamples), maxSamples_(maxSamples),
@@ -213,6 +213,7 @@ namespace QuantLib {
 
     template <class C, class I, template <class> class B>
     inline void PiecewiseDefaultCurve<C,I,B>::update() {
+        bootstrap_.curveUpdated();
         base_curve::update();
         LazyObject::update();
     }
@@ -146,6 +146,7 @@ namespace QuantLib {
 
     template <class I, template <class> class B, class T>
     void PiecewiseYoYInflationCurve<I,B,T>::update() {
+        bootstrap_.curveUpdated();
         base_curve::update();
         LazyObject::update();
     }
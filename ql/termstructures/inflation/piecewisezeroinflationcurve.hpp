@@ -144,6 +144,7 @@ namespace QuantLib {
 
     template <class I, template<class> class B, class T>
     void PiecewiseZeroInflationCurve<I,B,T>::update() {
+        bootstrap_.curveUpdated();
         base_curve::update();
         LazyObject::update();
     }
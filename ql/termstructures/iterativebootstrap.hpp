@@ -37,6 +37,15 @@
 namespace QuantLib {
 
     //! Universal piecewise-term-structure bootsrapper.
+    /*! When the interpolation is local and each pillar only depends
+        on the curve up to its own date, the bootstrapper keeps track
+        of the helpers that notified a change since the last
+        calculation and only re-solves the pillars from the earliest
+        of them onwards; the curve before it is unaffected.  This
+        requires the curve to call curveUpdated() whenever it is
+        notified, so that changes in its other dependencies (such as
+        jumps) can be told apart and cause a full bootstrap.
+    */
     template <class Curve>
     class IterativeBootstrap {
         typedef typename Curve::traits_type Traits;
@@ -45,16 +54,38 @@ namespace QuantLib {
         IterativeBootstrap();
         void setup(Curve* ts);
         void calculate() const;
+        //! to be called by the curve when notified of a change
+        void curveUpdated();
       private:
+        // flags a helper which notified a change and forwards the
+        // notification to the curve
+        class HelperMonitor : public Observer {
+          public:
+            explicit HelperMonitor(IterativeBootstrap* bootstrap)
+            : bootstrap_(bootstrap), changed_(true) {}
+            void update() {
+                changed_ = true;
+                bootstrap_->helperNotifying_ = true;
+                bootstrap_->ts_->update();
+                bootstrap_->helperNotifying_ = false;
+            }
+            IterativeBootstrap* bootstrap_;
+            bool changed_;
+        };
         void initialize() const;
+        Size firstChangedPillar() const;
         Curve* ts_;
         Size n_;
         Brent firstSolver_;
         FiniteDifferenceNewtonSafe solver_;
-        mutable bool initialized_, validCurve_, loopRequired_;
+        mutable bool initialized_, validCurve_, loopRequired_, datesChanged_;
+        // whether the curve was notified by anything but its helpers
+        mutable bool dependenciesChanged_;
+        bool helperNotifying_;
         mutable Size firstAliveHelper_, alive_;
         mutable std::vector<Real> previousData_;
         mutable std::vector<std::shared_ptr<BootstrapError<Curve> > > errors_;
+        mutable std::vector<std::shared_ptr<HelperMonitor> > monitors_;
     };
 
 
@@ -63,7 +94,8 @@ namespace QuantLib {
     template <class Curve>
     IterativeBootstrap<Curve>::IterativeBootstrap()
         : ts_(0), initialized_(false), validCurve_(false), 
-          loopRequired_(Interpolator::global) {}
+          loopRequired_(Interpolator::global), datesChanged_(true),
+          dependenciesChanged_(true), helperNotifying_(false) {}
 
     template <class Curve>
     void IterativeBootstrap<Curve>::setup(Curve* ts) {
@@ -71,8 +103,13 @@ namespace QuantLib {
         ts_ = ts;
         n_ = ts_->instruments_.size();
         QL_REQUIRE(n_ > 0, "no bootstrap helpers given")
-        for (Size j=0; j<n_; ++j)
-            ts_->registerWith(ts_->instruments_[j]);
+        // the curve is notified of changes in the helpers through
+        // the monitors, which are kept in the same order as the helpers
+        monitors_.clear();
+        for (Size j=0; j<n_; ++j) {
+            monitors_.push_back(std::make_shared<HelperMonitor>(this));
+            monitors_.back()->registerWith(ts_->instruments_[j]);
+        }
 
         // do not initialize yet: instruments could be invalid here
         // but valid later when bootstrapping is actually required
@@ -80,9 +117,23 @@ namespace QuantLib {
 
     template <class Curve>
     void IterativeBootstrap<Curve>::initialize() const {
-        // ensure helpers are sorted
-        std::sort(ts_->instruments_.begin(), ts_->instruments_.end(),
-                  detail::BootstrapHelperSorter());
+        // ensure helpers are sorted, keeping the monitors in the
+        // same order
+        typedef std::pair<std::shared_ptr<typename Traits::helper>,
+                          std::shared_ptr<HelperMonitor> > entry;
+        std::vector<entry> sorted;
+        sorted.reserve(n_);
+        for (Size j=0; j<n_; ++j)
+            sorted.emplace_back(ts_->instruments_[j], monitors_[j]);
+        std::sort(sorted.begin(), sorted.end(),
+                  [](const entry& e1, const entry& e2) {
+                      return detail::BootstrapHelperSorter()(e1.first,
+                                                             e2.first);
+                  });
+        for (Size j=0; j<n_; ++j) {
+            ts_->instruments_[j] = sorted[j].first;
+            monitors_[j] = sorted[j].second;
+        }
         // skip expired helpers
         Date firstDate = Traits::initialDate(ts_);
         QL_REQUIRE(ts_->instruments_[n_-1]->pillarDate()>firstDate,
@@ -99,6 +150,7 @@ namespace QuantLib {
         // calculate dates and times, create errors_
         std::vector<Date>& dates = ts_->dates_;
         std::vector<Time>& times = ts_->times_;
+        datesChanged_ = dates.size() != alive_+1 || dates[0] != firstDate;
         dates.resize(alive_+1);
         times.resize(alive_+1);
         errors_.resize(alive_+1);
@@ -111,6 +163,8 @@ namespace QuantLib {
         for (Size i=1, j=firstAliveHelper_; j<n_; ++i, ++j) {
             const std::shared_ptr<typename Traits::helper>& helper =
                                                         ts_->instruments_[j];
+            if (dates[i] != helper->pillarDate())
+                datesChanged_ = true;
             dates[i] = helper->pillarDate();
             times[i] = ts_->timeFromReference(dates[i]);
             // check for duplicated pillars
@@ -175,6 +229,12 @@ namespace QuantLib {
             helper->setTermStructure(const_cast<Curve*>(ts_));
         }
 
+        // pillars before the first changed one can be kept as they are
+        const Size firstPillar = firstChangedPillar();
+        for (Size j=0; j<n_; ++j)
+            monitors_[j]->changed_ = false;
+        dependenciesChanged_ = false;
+
         const std::vector<Time>& times = ts_->times_;
         const std::vector<Real>& data = ts_->data_;
         Real accuracy = ts_->accuracy_;
@@ -187,7 +247,7 @@ namespace QuantLib {
         for (Size iteration=0; ; ++iteration) {
             previousData_ = ts_->data_;
 
-            for (Size i=1; i<=alive_; ++i) { // pillar loop
+            for (Size i=firstPillar; i<=alive_; ++i) { // pillar loop
 
                 // bracket root and calculate guess
                 Real min = Traits::minValueAfter(i, ts_, validData,
@@ -259,6 +319,28 @@ namespace QuantLib {
             validData = true;
         }
         validCurve_ = true;
+        datesChanged_ = false;
+    }
+
+    template <class Curve>
+    void IterativeBootstrap<Curve>::curveUpdated() {
+        if (!helperNotifying_)
+            dependenciesChanged_ = true;
+    }
+
+    template <class Curve>
+    Size IterativeBootstrap<Curve>::firstChangedPillar() const {
+        // a full bootstrap is needed unless the pillars can be solved
+        // one after the other and the previous solution is still valid
+        if (loopRequired_ || !validCurve_ || datesChanged_
+            || dependenciesChanged_)
+            return 1;
+        for (Size i=1, j=firstAliveHelper_; j<n_; ++i, ++j) {
+            if (monitors_[j]->changed_)
+                return i;
+        }
+        // the recalculation was not triggered by the helpers
+        return 1;
     }
 
 }
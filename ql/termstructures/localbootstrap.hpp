@@ -92,6 +92,7 @@ namespace QuantLib {
                        bool forcePositive = true);
         void setup(Curve* ts);
         void calculate() const;
+        void curveUpdated() {}
 
       private:
         mutable bool validCurve_;
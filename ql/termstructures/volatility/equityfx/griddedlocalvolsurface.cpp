@@ -0,0 +1,148 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/termstructures/volatility/equityfx/griddedlocalvolsurface.hpp>
+#include <ql/utilities/parallelfor.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace QuantLib {
+
+    namespace {
+
+        // grid cell containing the point, and position within it;
+        // points outside the grid are moved to its boundary
+        void locate(Real u, Size steps, Size& i, Real& s) {
+            u = std::min(std::max(u, 0.0), Real(steps));
+            i = std::min(static_cast<Size>(u), steps-1);
+            s = u - i;
+        }
+
+        // weights of the cubic convolution kernel with a = -1/2
+        void cubicWeights(Real s, Real w[4]) {
+            Real s2 = s*s, s3 = s2*s;
+            w[0] = 0.5*(-s3 + 2.0*s2 - s);
+            w[1] = 0.5*(3.0*s3 - 5.0*s2 + 2.0);
+            w[2] = 0.5*(-3.0*s3 + 4.0*s2 + s);
+            w[3] = 0.5*(s3 - s2);
+        }
+
+    }
+
+    GriddedLocalVolSurface::GriddedLocalVolSurface(
+                                const Handle<LocalVolTermStructure>& localVol,
+                                Time maxTime,
+                                Size timeSteps,
+                                Real minStrike,
+                                Real maxStrike,
+                                Size strikeSteps,
+                                InterpolationType interpolation,
+                                Size threads)
+    : LocalVolTermStructure(localVol->businessDayConvention(),
+                            localVol->dayCounter()),
+      localVol_(localVol), maxTime_(maxTime), timeSteps_(timeSteps),
+      minStrike_(minStrike), maxStrike_(maxStrike),
+      strikeSteps_(strikeSteps), interpolation_(interpolation),
+      threads_(threads) {
+        QL_REQUIRE(maxTime_ > 0.0,
+                   "positive maximum time required: " << maxTime_
+                   << " not allowed");
+        QL_REQUIRE(timeSteps_ > 0, "at least one time step required");
+        QL_REQUIRE(strikeSteps_ > 0, "at least one strike step required");
+        QL_REQUIRE(minStrike_ > 0.0 && minStrike_ < maxStrike_,
+                   "invalid strike range [" << minStrike_ << ", "
+                   << maxStrike_ << "]");
+        QL_REQUIRE(threads_ > 0, "positive number of threads required");
+        dt_ = maxTime_/timeSteps_;
+        xMin_ = std::log(minStrike_);
+        dx_ = (std::log(maxStrike_) - xMin_)/strikeSteps_;
+        registerWith(localVol_);
+    }
+
+    const Date& GriddedLocalVolSurface::referenceDate() const {
+        return localVol_->referenceDate();
+    }
+
+    DayCounter GriddedLocalVolSurface::dayCounter() const {
+        return localVol_->dayCounter();
+    }
+
+    Date GriddedLocalVolSurface::maxDate() const {
+        return localVol_->maxDate();
+    }
+
+    Real GriddedLocalVolSurface::minStrike() const {
+        return localVol_->minStrike();
+    }
+
+    Real GriddedLocalVolSurface::maxStrike() const {
+        return localVol_->maxStrike();
+    }
+
+    void GriddedLocalVolSurface::performCalculations() const {
+        localVols_ = Matrix(timeSteps_+1, strikeSteps_+1);
+
+        const LocalVolTermStructure& localVol = **localVol_;
+        // Dupire's formula is singular at t = 0, where the Black
+        // variance vanishes; the first row is sampled shortly after.
+        const Time t0 = 0.01*dt_;
+        // triggers the lazy calculations of the underlying structures
+        // before they are accessed concurrently
+        localVols_[0][0] = localVol.localVol(t0, minStrike_, true);
+
+        parallelFor(timeSteps_+1, threads_, [&](Size i) {
+            Time t = i == 0 ? t0 : i*dt_;
+            for (Size j=0; j<=strikeSteps_; ++j)
+                localVols_[i][j] =
+                    localVol.localVol(t, std::exp(xMin_ + j*dx_), true);
+        });
+    }
+
+    Volatility GriddedLocalVolSurface::localVolImpl(Time t,
+                                                    Real strike) const {
+        calculate();
+
+        Size i, j;
+        Real s, r;
+        locate(t/dt_, timeSteps_, i, s);
+        locate((std::log(strike) - xMin_)/dx_, strikeSteps_, j, r);
+
+        const Matrix& v = localVols_;
+        if (interpolation_ == Linear) {
+            return (1.0-s)*((1.0-r)*v[i][j] + r*v[i][j+1])
+                + s*((1.0-r)*v[i+1][j] + r*v[i+1][j+1]);
+        } else {
+            Real wt[4], wx[4];
+            cubicWeights(s, wt);
+            cubicWeights(r, wx);
+            // indices beyond the grid are replaced by the boundary
+            const Integer ni = Integer(timeSteps_), nj = Integer(strikeSteps_);
+            Real result = 0.0;
+            for (Integer k=0; k<4; ++k) {
+                Integer ik = std::min(std::max(Integer(i)+k-1, 0), ni);
+                Real row = 0.0;
+                for (Integer l=0; l<4; ++l) {
+                    Integer jl = std::min(std::max(Integer(j)+l-1, 0), nj);
+                    row += wx[l]*v[ik][jl];
+                }
+                result += wt[k]*row;
+            }
+            return result;
+        }
+    }
+
+}
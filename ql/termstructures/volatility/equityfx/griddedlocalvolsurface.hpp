@@ -0,0 +1,120 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file griddedlocalvolsurface.hpp
+    \brief Local volatility surface sampled on a regular grid
+*/
+
+#ifndef quantlib_gridded_local_vol_surface_hpp
+#define quantlib_gridded_local_vol_surface_hpp
+
+#include <ql/termstructures/volatility/equityfx/localvoltermstructure.hpp>
+#include <ql/patterns/lazyobject.hpp>
+#include <ql/math/matrix.hpp>
+
+namespace QuantLib {
+
+    //! Local volatility surface sampled on a regular grid
+    /*! The local volatility of another term structure, typically a
+        LocalVolSurface applying Dupire's formula to a Black surface,
+        is sampled once on a grid of equally spaced times and
+        log-strikes; later lookups interpolate the samples, either
+        bilinearly or with cubic convolution (Keys, 1981), locating
+        the grid cell in constant time.  The samples are taken again
+        lazily when the underlying term structure notifies a change.
+
+        Outside the grid, the volatility is extrapolated flat.  The
+        first row of the grid is sampled at a small positive time, as
+        Dupire's formula is singular at \f$ t = 0 \f$.
+
+        The grid can be sampled on multiple threads.
+
+        \warning with more than one thread, the underlying local
+                 volatility is evaluated concurrently; the first grid
+                 point is sampled beforehand so as to trigger any lazy
+                 calculation of the underlying term structures.  For
+                 the same reason, the surface must have been
+                 calculated before being used by multiple threads.
+
+        \warning failures while sampling, such as a negative local
+                 variance, are propagated; a NoExceptLocalVolSurface
+                 can be used as the underlying surface to replace
+                 them with a given value.
+    */
+    class GriddedLocalVolSurface : public LocalVolTermStructure,
+                                   public LazyObject {
+      public:
+        enum InterpolationType { Linear, Cubic };
+
+        GriddedLocalVolSurface(const Handle<LocalVolTermStructure>& localVol,
+                               Time maxTime,
+                               Size timeSteps,
+                               Real minStrike,
+                               Real maxStrike,
+                               Size strikeSteps,
+                               InterpolationType interpolation = Linear,
+                               Size threads = 1);
+        //! \name TermStructure interface
+        //@{
+        const Date& referenceDate() const;
+        DayCounter dayCounter() const;
+        Date maxDate() const;
+        //@}
+        //! \name VolatilityTermStructure interface
+        //@{
+        Real minStrike() const;
+        Real maxStrike() const;
+        //@}
+        //! \name Observer interface
+        //@{
+        void update();
+        //@}
+        //! \name Inspectors
+        //@{
+        //! sampled local volatilities; rows are times, columns log-strikes
+        const Matrix& localVols() const;
+        //@}
+      protected:
+        void performCalculations() const;
+        Volatility localVolImpl(Time t, Real strike) const;
+      private:
+        Handle<LocalVolTermStructure> localVol_;
+        Time maxTime_;
+        Size timeSteps_;
+        Real minStrike_, maxStrike_;
+        Size strikeSteps_;
+        InterpolationType interpolation_;
+        Size threads_;
+        Real dt_, dx_, xMin_;
+        mutable Matrix localVols_;
+    };
+
+    // inline definitions
+
+    inline void GriddedLocalVolSurface::update() {
+        TermStructure::update();
+        LazyObject::update();
+    }
+
+    inline const Matrix& GriddedLocalVolSurface::localVols() const {
+        calculate();
+        return localVols_;
+    }
+
+}
+
+#endif
@@ -232,6 +232,8 @@ namespace QuantLib {
     template <class C, class I, template <class> class B>
     inline void PiecewiseYieldCurve<C,I,B>::update() {
 
+        bootstrap_.curveUpdated();
+
         // it dispatches notifications only if (!calculated_ && !frozen_)
         LazyObject::update();
 
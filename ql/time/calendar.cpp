@@ -22,9 +22,18 @@
 
 #include <ql/time/calendar.hpp>
 #include <ql/errors.hpp>
+#include <bitset>
 
 namespace QuantLib {
 
+    namespace {
+
+        inline Date::serial_type bitCount(std::uint64_t x) {
+            return static_cast<Date::serial_type>(std::bitset<64>(x).count());
+        }
+
+    }
+
     void Calendar::addHoliday(const Date& d) {
         QL_REQUIRE(impl_, "no implementation provided");
         // if d was a genuine holiday previously removed, revert the change
@@ -33,6 +42,9 @@ namespace QuantLib {
         // Otherwise, add it.
         if (impl_->isBusinessDay(d))
             impl_->addedHolidays.insert(d);
+        BusinessDayCache* cache = impl_->businessDayCache.get();
+        if (cache != nullptr && cache->covers(d))
+            cache->update(d, false);
     }
 
     void Calendar::removeHoliday(const Date& d) {
@@ -43,6 +55,22 @@ namespace QuantLib {
         // Otherwise, add it.
         if (!impl_->isBusinessDay(d))
             impl_->removedHolidays.insert(d);
+        BusinessDayCache* cache = impl_->businessDayCache.get();
+        if (cache != nullptr && cache->covers(d))
+            cache->update(d, true);
+    }
+
+    void Calendar::enableBusinessDayCache(Year firstYear, Year lastYear) {
+        QL_REQUIRE(impl_, "no implementation provided");
+        // the old cache, if any, must not be used to build the new one
+        impl_->businessDayCache.reset();
+        impl_->businessDayCache.reset(
+                          new BusinessDayCache(*this, firstYear, lastYear));
+    }
+
+    void Calendar::disableBusinessDayCache() {
+        QL_REQUIRE(impl_, "no implementation provided");
+        impl_->businessDayCache.reset();
     }
 
     Date Calendar::adjust(const Date& d,
@@ -99,6 +127,13 @@ namespace QuantLib {
         if (n == 0) {
             return adjust(d,c);
         } else if (unit == Days) {
+            const BusinessDayCache* cache =
+                impl_ ? impl_->businessDayCache.get() : nullptr;
+            if (cache != nullptr && cache->covers(d)) {
+                Date d1 = cache->advance(d, n);
+                if (d1 != Date())
+                    return d1;
+            }
             Date d1 = d;
             if (n > 0) {
                 while (n > 0) {
@@ -143,21 +178,21 @@ namespace QuantLib {
                                                     bool includeLast) const {
         Date::serial_type wd = 0;
         if (from != to) {
-            if (from < to) {
+            const Date& first = std::min(from, to);
+            const Date& last = std::max(from, to);
+            const BusinessDayCache* cache =
+                impl_ ? impl_->businessDayCache.get() : nullptr;
+            if (cache != nullptr
+                && cache->covers(first) && cache->covers(last)) {
+                wd = cache->count(first, last);
+            } else {
                 // the last one is treated separately to avoid
                 // incrementing Date::maxDate()
-                for (Date d = from; d < to; ++d) {
-                    if (isBusinessDay(d))
-                        ++wd;
-                }
-                if (isBusinessDay(to))
-                    ++wd;
-            } else if (from > to) {
-                for (Date d = to; d < from; ++d) {
+                for (Date d = first; d < last; ++d) {
                     if (isBusinessDay(d))
                         ++wd;
                 }
-                if (isBusinessDay(from))
+                if (isBusinessDay(last))
                     ++wd;
             }
 
@@ -175,7 +210,83 @@ namespace QuantLib {
 
 
 
-   // Western calendars
+    // business-day cache
+
+    Calendar::BusinessDayCache::BusinessDayCache(const Calendar& calendar,
+                                                 Year firstYear,
+                                                 Year lastYear)
+    : firstYear_(firstYear), lastYear_(lastYear) {
+        QL_REQUIRE(firstYear <= lastYear,
+                   "first year (" << firstYear
+                   << ") cannot be later than last year ("
+                   << lastYear << ")");
+        first_ = Date(1, January, firstYear).serialNumber();
+        days_ = Date(31, December, lastYear).serialNumber() - first_ + 1;
+        bits_.assign((days_ + 63) / 64, 0);
+        for (Date::serial_type i=0; i<days_; ++i) {
+            if (calendar.isBusinessDay(Date(first_ + i)))
+                bits_[i >> 6] |= std::uint64_t(1) << (i & 63);
+        }
+        counts_.resize(bits_.size() + 1);
+        counts_[0] = 0;
+        for (Size w=0; w<bits_.size(); ++w)
+            counts_[w+1] = counts_[w] + bitCount(bits_[w]);
+    }
+
+    void Calendar::BusinessDayCache::update(const Date& d,
+                                            bool isBusinessDay) {
+        Date::serial_type i = d.serialNumber() - first_;
+        std::uint64_t mask = std::uint64_t(1) << (i & 63);
+        std::uint64_t& word = bits_[i >> 6];
+        if (((word & mask) != 0) == isBusinessDay)
+            return;
+        word ^= mask;
+        Date::serial_type change = isBusinessDay ? 1 : -1;
+        for (Size w=(i >> 6)+1; w<counts_.size(); ++w)
+            counts_[w] += change;
+    }
+
+    Date::serial_type
+    Calendar::BusinessDayCache::count(const Date& from,
+                                      const Date& to) const {
+        return rank(to.serialNumber() - first_ + 1)
+            - rank(from.serialNumber() - first_);
+    }
+
+    Date Calendar::BusinessDayCache::advance(const Date& d,
+                                             Integer n) const {
+        Date::serial_type i = d.serialNumber() - first_;
+        // index of the target among the cached business days
+        Date::serial_type j = n > 0 ? rank(i+1) + n - 1 : rank(i) + n;
+        if (j < 0 || j >= counts_.back())
+            return Date();
+        return Date(first_ + select(j));
+    }
+
+    Date::serial_type
+    Calendar::BusinessDayCache::rank(Date::serial_type i) const {
+        // number of business days before the i-th cached day
+        Date::serial_type w = i >> 6, b = i & 63;
+        Date::serial_type r = counts_[w];
+        if (b != 0)
+            r += bitCount(bits_[w] & ((std::uint64_t(1) << b) - 1));
+        return r;
+    }
+
+    Date::serial_type
+    Calendar::BusinessDayCache::select(Date::serial_type j) const {
+        // offset of the j-th cached business day (starting from 0)
+        Date::serial_type w = static_cast<Date::serial_type>(
+            std::upper_bound(counts_.begin(), counts_.end(), j)
+            - counts_.begin()) - 1;
+        std::uint64_t x = bits_[w];
+        for (Date::serial_type k=j-counts_[w]; k>0; --k)
+            x &= x - 1;   // drop the lowest business day
+        return (w << 6) + bitCount((x & (~x + 1)) - 1);
+    }
+
+
+    // Western calendars
 
     bool Calendar::WesternImpl::isWeekend(Weekday w) const {
         return w == Saturday || w == Sunday;
@@ -31,6 +31,7 @@
 #include <ql/time/businessdayconvention.hpp>
 #include <memory>
 #include <algorithm>
+#include <cstdint>
 #include <set>
 #include <vector>
 #include <string>
@@ -51,14 +52,55 @@ namespace QuantLib {
         or for general country holiday schedule. Legacy city holiday schedule
         calendars will be moved to the exchange/country convention.
 
+        Optionally, the business days over a range of years can be
+        precomputed and stored as a bitmap (see
+        enableBusinessDayCache()); holiday checks within the range
+        then become a bit lookup, and business-day counts and
+        business-day advances no longer need to walk the dates one by
+        one.
+
         \ingroup datetime
 
         \test the methods for adding and removing holidays are tested
               by inspecting the calendar before and after their
               invocation.
+
+        \test the results of cached calendars are checked against
+              the non-cached ones.
     */
     class Calendar {
       protected:
+        //! bitmap of business days over a range of years
+        class BusinessDayCache {
+          public:
+            BusinessDayCache(const Calendar&, Year firstYear, Year lastYear);
+            Year firstYear() const { return firstYear_; }
+            Year lastYear() const { return lastYear_; }
+            bool covers(const Date& d) const {
+                return d.serialNumber() >= first_
+                    && d.serialNumber() < first_ + days_;
+            }
+            bool isBusinessDay(const Date& d) const {
+                Date::serial_type i = d.serialNumber() - first_;
+                return ((bits_[i >> 6] >> (i & 63)) & 1) != 0;
+            }
+            void update(const Date& d, bool isBusinessDay);
+            //! business days in [from, to]; both must be covered
+            Date::serial_type count(const Date& from, const Date& to) const;
+            /*! n-th business day after (n>0) or before (n<0) the
+                given covered date; returns a null date if the
+                result falls outside the cached range.
+            */
+            Date advance(const Date& d, Integer n) const;
+          private:
+            Date::serial_type rank(Date::serial_type i) const;
+            Date::serial_type select(Date::serial_type j) const;
+            Year firstYear_, lastYear_;
+            Date::serial_type first_, days_;
+            std::vector<std::uint64_t> bits_;
+            // business days in the words before each word
+            std::vector<Date::serial_type> counts_;
+        };
         //! abstract base class for calendar implementations
         class Impl {
           public:
@@ -67,6 +109,7 @@ namespace QuantLib {
             virtual bool isBusinessDay(const Date&) const = 0;
             virtual bool isWeekend(Weekday) const = 0;
             std::set<Date> addedHolidays, removedHolidays;
+            std::unique_ptr<BusinessDayCache> businessDayCache;
         };
         std::shared_ptr<Impl> impl_;
       public:
@@ -109,6 +152,26 @@ namespace QuantLib {
         /*! Removes a date from the set of holidays for the given calendar. */
         void removeHoliday(const Date&);
 
+        /*! Precomputes the business days between the first and the
+            last given years (included) so that later queries within
+            the range don't need to evaluate the holiday rules.  The
+            cache is kept up to date by addHoliday() and
+            removeHoliday().
+
+            \warning As for added and removed holidays, the cache is
+                     shared by all the instances of the calendar.
+                     Changes to other calendars this one is built
+                     upon, e.g., the components of a JointCalendar,
+                     are not tracked; the cache must be enabled again
+                     after modifying them.
+        */
+        void enableBusinessDayCache(Year firstYear = 1901,
+                                    Year lastYear = 2199);
+        /*! Discards the precomputed business days, if any. */
+        void disableBusinessDayCache();
+        //! Returns whether business days are being cached
+        bool hasBusinessDayCache() const;
+
         //! Returns the holidays between two dates
         static std::vector<Date> holidayList(const Calendar& calendar,
                                              const Date& from,
@@ -197,6 +260,9 @@ namespace QuantLib {
 
     inline bool Calendar::isBusinessDay(const Date& d) const {
         QL_REQUIRE(impl_, "no implementation provided");
+        const BusinessDayCache* cache = impl_->businessDayCache.get();
+        if (cache != nullptr && cache->covers(d))
+            return cache->isBusinessDay(d);
         if (impl_->addedHolidays.find(d) != impl_->addedHolidays.end())
             return false;
         if (impl_->removedHolidays.find(d) != impl_->removedHolidays.end())
@@ -204,6 +270,11 @@ namespace QuantLib {
         return impl_->isBusinessDay(d);
     }
 
+    inline bool Calendar::hasBusinessDayCache() const {
+        QL_REQUIRE(impl_, "no implementation provided");
+        return impl_->businessDayCache != nullptr;
+    }
+
     inline bool Calendar::isEndOfMonth(const Date& d) const {
         return (d.month() != adjust(d+1).month());
     }
@@ -50,6 +50,10 @@ namespace QuantLib {
 
     void BespokeCalendar::addWeekend(Weekday w) {
         bespokeImpl_->addWeekend(w);
+        // the cached business days are obsolete
+        if (bespokeImpl_->businessDayCache)
+            enableBusinessDayCache(bespokeImpl_->businessDayCache->firstYear(),
+                                   bespokeImpl_->businessDayCache->lastYear());
     }
 
 }
@@ -32,6 +32,7 @@
 #include <ql/utilities/transformiterator.hpp>
 #include <functional>
 #include <map>
+#include <utility>
 #include <vector>
 
 namespace QuantLib {
@@ -44,6 +45,7 @@ namespace QuantLib {
 
         \pre The <c>Container</c> type must satisfy the requirements
              set by the C++ standard for associative containers.
+             DenseDateMap can be used instead for dense daily data.
     */
     template <class T, class Container = std::map<Date, T> >
     class TimeSeries {
@@ -52,6 +54,19 @@ namespace QuantLib {
         using value_type = T;
       private:
         mutable Container values_;
+        // containers providing lookup(), such as DenseDateMap, are
+        // searched through it; others through find()
+        template <class C>
+        static auto find(const C& c, const Date& d, int)
+        -> decltype(c.lookup(d), T()) {
+            const T* x = c.lookup(d);
+            return x != nullptr ? *x : Null<T>();
+        }
+        template <class C>
+        static T find(const C& c, const Date& d, long) {
+            typename C::const_iterator i = c.find(d);
+            return i != c.end() ? i->second : Null<T>();
+        }
       public:
         /*! Default constructor */
         TimeSeries() {}
@@ -77,6 +92,19 @@ namespace QuantLib {
             while (begin != end)
                 values_[d++] = *(begin++);
         }
+        /*! This constructor takes over the data stored in the given
+            container.
+        */
+        explicit TimeSeries(Container values)
+        : values_(std::move(values)) {}
+        /*! This constructor copies the data of a series using a
+            different container.
+        */
+        template <class OtherContainer>
+        TimeSeries(const TimeSeries<T, OtherContainer>& other) {
+            for (const auto& i : other)
+                values_[i.first] = i.second;
+        }
         //! \name Inspectors
         //@{
         //! returns the first date for which a historical datum exists
@@ -92,10 +120,7 @@ namespace QuantLib {
         //@{
         //! returns the (possibly null) datum corresponding to the given date
         T operator[](const Date& d) const {
-            if (values_.find(d) != values_.end())
-                return values_[d];
-            else
-                return Null<T>();
+            return find(values_, d, 0);
         }
         T& operator[](const Date& d) {
             if (values_.find(d) == values_.end())
@@ -0,0 +1,342 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file densedatemap.hpp
+    \brief date-indexed container with contiguous storage
+*/
+
+#ifndef quantlib_dense_date_map_hpp
+#define quantlib_dense_date_map_hpp
+
+#include <ql/time/date.hpp>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace QuantLib {
+
+    //! date-indexed container with contiguous storage
+    /*! This class provides the subset of the interface of
+        <tt>std::map<Date,T></tt> used by TimeSeries, so that it can be
+        used as its container.  Values are stored contiguously, one per
+        day from the first to the last date, and are accessed in
+        constant time through the offset of the serial number of their
+        date; days with no datum hold a NaN.  For daily data such as
+        index fixings, this takes far less memory than the nodes of a
+        map.
+
+        Iterators skip the missing days; they are bidirectional and
+        yield <tt>(date, value)</tt> pairs.
+
+        \pre T must be a floating-point type; NaN cannot be stored as
+             a datum, since it marks missing days.
+
+        \warning only the day of a date is used as its key, regardless
+                 of its time when high-resolution dates are enabled.
+                 Adding a date before the first one shifts all the
+                 stored values.
+    */
+    template <class T>
+    class DenseDateMap {
+        static_assert(std::is_floating_point<T>::value,
+                      "DenseDateMap requires a floating-point type");
+      public:
+        typedef Date key_type;
+        typedef T mapped_type;
+        typedef std::pair<Date, T> value_type;
+        typedef Size size_type;
+
+        //! bidirectional iterator over the stored data
+        /*! The pair it yields is kept in the iterator itself; as for
+            other proxy iterators, references to it are invalidated
+            when the iterator is moved or destroyed.
+        */
+        template <bool Reverse>
+        class base_iterator {
+          public:
+            typedef std::bidirectional_iterator_tag iterator_category;
+            typedef typename DenseDateMap::value_type value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef const value_type* pointer;
+            typedef const value_type& reference;
+
+            base_iterator() : map_(nullptr), i_(0) {}
+
+            reference operator*() const { return current_; }
+            pointer operator->() const { return &current_; }
+
+            base_iterator& operator++() {
+                Reverse ? retreat() : advance();
+                return *this;
+            }
+            base_iterator operator++(int) {
+                base_iterator tmp(*this);
+                ++*this;
+                return tmp;
+            }
+            base_iterator& operator--() {
+                Reverse ? advance() : retreat();
+                return *this;
+            }
+            base_iterator operator--(int) {
+                base_iterator tmp(*this);
+                --*this;
+                return tmp;
+            }
+
+            bool operator==(const base_iterator& other) const {
+                return i_ == other.i_;
+            }
+            bool operator!=(const base_iterator& other) const {
+                return i_ != other.i_;
+            }
+
+          private:
+            friend class DenseDateMap;
+            // i_ is the offset of the current day; forward iterators
+            // end at size(), reverse ones at -1
+            base_iterator(const DenseDateMap* map, std::ptrdiff_t i)
+            : map_(map), i_(i) {
+                update();
+            }
+            void advance() {
+                const std::ptrdiff_t n = map_->values_.size();
+                do {
+                    ++i_;
+                } while (i_ < n && missing(map_->values_[i_]));
+                update();
+            }
+            void retreat() {
+                do {
+                    --i_;
+                } while (i_ >= 0 && missing(map_->values_[i_]));
+                update();
+            }
+            void update() {
+                if (i_ >= 0 && i_ < std::ptrdiff_t(map_->values_.size()))
+                    current_ = value_type(map_->dateAt(i_),
+                                          map_->values_[i_]);
+            }
+
+            const DenseDateMap* map_;
+            std::ptrdiff_t i_;
+            value_type current_;
+        };
+
+        typedef base_iterator<false> const_iterator;
+        typedef base_iterator<true> const_reverse_iterator;
+        typedef const_iterator iterator;
+        typedef const_reverse_iterator reverse_iterator;
+
+        DenseDateMap() : first_(0), count_(0), pending_(-1) {}
+
+        //! \name Element access
+        //@{
+        //! returns the datum at the given date, adding it if missing
+        /*! The storage is extended to the date if needed.
+
+            \warning the returned reference is invalidated by the
+                     next call to a non-const method.
+        */
+        T& operator[](const Date& d);
+        //! returns a pointer to the datum, or null if missing
+        const T* lookup(const Date& d) const;
+        //@}
+
+        //! \name Inspectors
+        //@{
+        //! returns the number of data, excluding missing days
+        Size size() const;
+        bool empty() const;
+        //! first and last day covered by the storage
+        Date firstSlot() const { return Date(first_); }
+        Date lastSlot() const { return Date(first_ + values_.size() - 1); }
+        //! the stored values, one per day starting from firstSlot()
+        const std::vector<T>& slots() const { return values_; }
+        //@}
+
+        //! \name Modifiers
+        //@{
+        //! replaces the content with consecutive daily values
+        /*! NaN values mark missing days. */
+        template <class Iterator>
+        void assign(const Date& firstDate, Iterator begin, Iterator end);
+        //! as above, taking over the storage of the given values
+        void assign(const Date& firstDate, std::vector<T>&& values);
+        void erase(const Date& d);
+        void clear();
+        //@}
+
+        //! \name Iterators
+        //@{
+        const_iterator find(const Date& d) const;
+        const_iterator begin() const;
+        const_iterator end() const {
+            return const_iterator(this, values_.size());
+        }
+        const_reverse_iterator rbegin() const;
+        const_reverse_iterator rend() const {
+            return const_reverse_iterator(this, -1);
+        }
+        //@}
+
+      private:
+        static bool missing(T x) { return std::isnan(x); }
+        static T missingValue() {
+            return std::numeric_limits<T>::quiet_NaN();
+        }
+        Date dateAt(std::ptrdiff_t i) const { return Date(first_ + i); }
+        std::ptrdiff_t offset(const Date& d) const {
+            return std::ptrdiff_t(d.serialNumber()) - first_;
+        }
+        // counts the slot last returned by operator[], which might
+        // have been written since
+        void settle();
+        void recount();
+        Date::serial_type first_;
+        std::vector<T> values_;
+        // number of data, excluding the slot last returned by
+        // operator[] until the next non-const call
+        Size count_;
+        std::ptrdiff_t pending_;
+    };
+
+
+    // inline definitions
+
+    template <class T>
+    inline T& DenseDateMap<T>::operator[](const Date& d) {
+        settle();
+        const Date::serial_type serial = d.serialNumber();
+        if (values_.empty()) {
+            first_ = serial;
+            values_.push_back(missingValue());
+        } else if (serial < first_) {
+            values_.insert(values_.begin(), first_ - serial, missingValue());
+            first_ = serial;
+        } else if (Size(serial - first_) >= values_.size()) {
+            values_.resize(serial - first_ + 1, missingValue());
+        }
+        const std::ptrdiff_t i = serial - first_;
+        if (!missing(values_[i]))
+            --count_;
+        pending_ = i;
+        return values_[i];
+    }
+
+    template <class T>
+    inline const T* DenseDateMap<T>::lookup(const Date& d) const {
+        const std::ptrdiff_t i = offset(d);
+        if (i < 0 || i >= std::ptrdiff_t(values_.size())
+            || missing(values_[i]))
+            return nullptr;
+        return &values_[i];
+    }
+
+    template <class T>
+    inline Size DenseDateMap<T>::size() const {
+        if (pending_ >= 0 && !missing(values_[pending_]))
+            return count_ + 1;
+        return count_;
+    }
+
+    template <class T>
+    inline bool DenseDateMap<T>::empty() const {
+        return size() == 0;
+    }
+
+    template <class T>
+    template <class Iterator>
+    inline void DenseDateMap<T>::assign(const Date& firstDate,
+                                        Iterator begin, Iterator end) {
+        first_ = firstDate.serialNumber();
+        values_.assign(begin, end);
+        recount();
+    }
+
+    template <class T>
+    inline void DenseDateMap<T>::assign(const Date& firstDate,
+                                        std::vector<T>&& values) {
+        first_ = firstDate.serialNumber();
+        values_ = std::move(values);
+        recount();
+    }
+
+    template <class T>
+    inline void DenseDateMap<T>::erase(const Date& d) {
+        settle();
+        const std::ptrdiff_t i = offset(d);
+        if (i >= 0 && i < std::ptrdiff_t(values_.size())
+            && !missing(values_[i])) {
+            values_[i] = missingValue();
+            --count_;
+        }
+    }
+
+    template <class T>
+    inline void DenseDateMap<T>::clear() {
+        values_.clear();
+        first_ = 0;
+        count_ = 0;
+        pending_ = -1;
+    }
+
+    template <class T>
+    inline void DenseDateMap<T>::settle() {
+        if (pending_ >= 0) {
+            if (!missing(values_[pending_]))
+                ++count_;
+            pending_ = -1;
+        }
+    }
+
+    template <class T>
+    inline void DenseDateMap<T>::recount() {
+        count_ = 0;
+        for (T x : values_)
+            if (!missing(x))
+                ++count_;
+        pending_ = -1;
+    }
+
+    template <class T>
+    inline typename DenseDateMap<T>::const_iterator
+    DenseDateMap<T>::find(const Date& d) const {
+        return lookup(d) ? const_iterator(this, offset(d)) : end();
+    }
+
+    template <class T>
+    inline typename DenseDateMap<T>::const_iterator
+    DenseDateMap<T>::begin() const {
+        const_iterator i(this, -1);
+        return ++i;
+    }
+
+    template <class T>
+    inline typename DenseDateMap<T>::const_reverse_iterator
+    DenseDateMap<T>::rbegin() const {
+        const_reverse_iterator i(this, values_.size());
+        return ++i;
+    }
+
+}
+
+
+#endif
@@ -25,6 +25,7 @@
 #define quantlib_observable_value_hpp
 
 #include <ql/patterns/observable.hpp>
+#include <utility>
 
 namespace QuantLib {
 
@@ -47,6 +48,7 @@ namespace QuantLib {
         //! \name controlled assignment
         //@{
         ObservableValue<T>& operator=(const T&);
+        ObservableValue<T>& operator=(T&&);
         ObservableValue<T>& operator=(const ObservableValue<T>&);
         //@}
         //! implicit conversion
@@ -81,6 +83,13 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class T>
+    ObservableValue<T>& ObservableValue<T>::operator=(T&& t) {
+        value_ = std::move(t);
+        observable_->notifyObservers();
+        return *this;
+    }
+
     template <class T>
     ObservableValue<T>&
     ObservableValue<T>::operator=(const ObservableValue<T>& t) {
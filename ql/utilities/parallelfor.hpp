@@ -0,0 +1,76 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file parallelfor.hpp
+    \brief loop over a range of indices on multiple threads
+*/
+
+#ifndef quantlib_parallel_for_hpp
+#define quantlib_parallel_for_hpp
+
+#include <ql/types.hpp>
+#include <algorithm>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace QuantLib {
+
+    //! calls f(i) for each i in [0, n), possibly on multiple threads
+    /*! The range is split into contiguous chunks, one per thread;
+        the calling thread takes care of the first one.  If any call
+        throws, the remaining indices of its chunk are skipped and,
+        once all threads are done, the exception raised by the first
+        failing chunk is rethrown.
+
+        \warning f is called concurrently when more than one thread
+                 is used; it must be safe to do so.
+    */
+    template <class F>
+    void parallelFor(Size n, Size threads, const F& f) {
+        Size workers = std::min(threads, n);
+        if (workers <= 1) {
+            for (Size i=0; i<n; ++i)
+                f(i);
+            return;
+        }
+
+        std::vector<std::exception_ptr> errors(workers);
+        auto chunk = [&f, &errors, n, workers](Size w) {
+            try {
+                for (Size i=w*n/workers; i<(w+1)*n/workers; ++i)
+                    f(i);
+            } catch (...) {
+                errors[w] = std::current_exception();
+            }
+        };
+        std::vector<std::thread> threadPool;
+        threadPool.reserve(workers-1);
+        for (Size w=1; w<workers; ++w)
+            threadPool.emplace_back(chunk, w);
+        chunk(0);
+        for (auto& t : threadPool)
+            t.join();
+        for (Size w=0; w<workers; ++w)
+            if (errors[w])
+                std::rethrow_exception(errors[w]);
+    }
+
+}
+
+
+#endif
@@ -21,6 +21,7 @@
 
 #include "utilities.hpp"
 #include <ql/pricingengines/blackformula.hpp>
+#include <ql/pricingengines/blackcalculator.hpp>
 
 using namespace QuantLib;
 
@@ -116,3 +117,168 @@ TEST_CASE("BlackFormula_ChambersImpliedVol", "[BlackFormula]") {
     }
 }
 
+TEST_CASE("BlackFormula_BatchFormulas", "[BlackFormula]") {
+
+    INFO("Testing batch Black and Bachelier formulas...");
+
+    Option::Type types[] = {Option::Call, Option::Put};
+    Real displacements[] = {0.0, 0.01};
+
+    std::vector<Real> strikes, forwards, stdDevs, discounts;
+    for (Real strike = 0.005; strike < 0.1; strike += 0.0025) {
+        for (Real stdDev = 0.05; stdDev < 1.5; stdDev += 0.15) {
+            strikes.push_back(strike);
+            forwards.push_back(0.03 + 0.1*stdDev*strike);
+            stdDevs.push_back(stdDev);
+            discounts.push_back(1.0 - 0.2*stdDev);
+        }
+    }
+    const Size n = strikes.size();
+
+    std::vector<Real> prices, vegas, deltas, gammas, impliedStdDevs;
+    std::vector<Real> ttes(1, 4.0);
+    std::vector<Real> bpStdDevs(n), bpPrices, bpVols;
+    for (Size i = 0; i < n; ++i)
+        bpStdDevs[i] = 0.0025*stdDevs[i];
+
+    for (Size j = 0; j < LENGTH(types); ++j) {
+        for (Size l = 0; l < LENGTH(displacements); ++l) {
+            const Real displacement = displacements[l];
+
+            blackFormula(types[j], strikes, forwards, stdDevs, discounts,
+                         prices, displacement);
+            blackFormulaStdDevDerivative(strikes, forwards, stdDevs,
+                                         discounts, vegas, displacement);
+            blackFormulaForwardDerivative(types[j], strikes, forwards,
+                                          stdDevs, discounts, deltas,
+                                          displacement);
+            blackFormulaForwardSecondDerivative(strikes, forwards, stdDevs,
+                                                discounts, gammas,
+                                                displacement);
+
+            for (Size i = 0; i < n; ++i) {
+                BlackCalculator calculator(types[j],
+                                           strikes[i] + displacement,
+                                           forwards[i] + displacement,
+                                           stdDevs[i], discounts[i]);
+                if (std::fabs(prices[i] - calculator.value()) > 1.0e-12)
+                    FAIL_CHECK("batch price does not match Black calculator"
+                               << "\n    type:       " << types[j]
+                               << "\n    strike:     " << strikes[i]
+                               << "\n    forward:    " << forwards[i]
+                               << "\n    stdDev:     " << stdDevs[i]
+                               << "\n    calculated: " << prices[i]
+                               << "\n    expected:   " << calculator.value());
+
+                const Real vega = blackFormulaStdDevDerivative(
+                    strikes[i], forwards[i], stdDevs[i], discounts[i],
+                    displacement);
+                if (std::fabs(vegas[i] - vega) > 1.0e-12)
+                    FAIL_CHECK("batch stdDev derivative does not match "
+                               "scalar formula"
+                               << "\n    calculated: " << vegas[i]
+                               << "\n    expected:   " << vega);
+
+                if (std::fabs(deltas[i] - calculator.deltaForward())
+                                                            > 1.0e-12)
+                    FAIL_CHECK("batch forward delta does not match "
+                               "Black calculator"
+                               << "\n    type:       " << types[j]
+                               << "\n    strike:     " << strikes[i]
+                               << "\n    forward:    " << forwards[i]
+                               << "\n    stdDev:     " << stdDevs[i]
+                               << "\n    calculated: " << deltas[i]
+                               << "\n    expected:   "
+                               << calculator.deltaForward());
+
+                // gammas grow as the inverse of the forward
+                const Real gamma = calculator.gammaForward();
+                if (std::fabs(gammas[i] - gamma)
+                                > 1.0e-12*std::max(1.0, std::fabs(gamma)))
+                    FAIL_CHECK("batch forward gamma does not match "
+                               "Black calculator"
+                               << "\n    type:       " << types[j]
+                               << "\n    strike:     " << strikes[i]
+                               << "\n    forward:    " << forwards[i]
+                               << "\n    stdDev:     " << stdDevs[i]
+                               << "\n    calculated: " << gammas[i]
+                               << "\n    expected:   " << gamma);
+
+            }
+
+            // prices with hardly any time value carry no information
+            // on the volatility and are left out of the inversion
+            std::vector<Real> k, f, p, d, expected;
+            for (Size i = 0; i < n; ++i) {
+                if (vegas[i] > 1.0e-3) {
+                    k.push_back(strikes[i]);
+                    f.push_back(forwards[i]);
+                    p.push_back(prices[i]);
+                    d.push_back(discounts[i]);
+                    expected.push_back(stdDevs[i]);
+                }
+            }
+            blackFormulaImpliedStdDev(types[j], k, f, p, d, impliedStdDevs,
+                                      displacement, 1.0e-10);
+
+            for (Size i = 0; i < k.size(); ++i) {
+                if (std::fabs(impliedStdDevs[i] - expected[i]) > 1.0e-8)
+                    FAIL_CHECK("batch implied stdDev does not reproduce "
+                               "the input"
+                               << "\n    type:       " << types[j]
+                               << "\n    strike:     " << k[i]
+                               << "\n    forward:    " << f[i]
+                               << "\n    calculated: " << impliedStdDevs[i]
+                               << "\n    expected:   " << expected[i]);
+            }
+        }
+
+        bachelierBlackFormula(types[j], strikes, forwards, bpStdDevs,
+                              discounts, bpPrices);
+        bachelierBlackFormulaImpliedVol(types[j], strikes, forwards, ttes,
+                                        bpPrices, discounts, bpVols);
+        for (Size i = 0; i < n; ++i) {
+            const Real expected = bachelierBlackFormula(
+                types[j], strikes[i], forwards[i], bpStdDevs[i],
+                discounts[i]);
+            if (std::fabs(bpPrices[i] - expected) > 1.0e-14)
+                FAIL_CHECK("batch Bachelier price does not match "
+                           "scalar formula"
+                           << "\n    calculated: " << bpPrices[i]
+                           << "\n    expected:   " << expected);
+
+            const Real expectedVol = bachelierBlackFormulaImpliedVol(
+                types[j], strikes[i], forwards[i], ttes[0], bpPrices[i],
+                discounts[i]);
+            if (std::fabs(bpVols[i] - expectedVol) > 1.0e-14)
+                FAIL_CHECK("batch Bachelier implied vol does not match "
+                           "scalar formula"
+                           << "\n    calculated: " << bpVols[i]
+                           << "\n    expected:   " << expectedVol);
+        }
+    }
+
+    // inconsistent batch sizes are rejected
+    std::vector<Real> twoDiscounts(2, 1.0);
+    bool thrown = false;
+    try {
+        blackFormula(Option::Call, strikes, forwards, stdDevs,
+                     twoDiscounts, prices);
+    } catch (Error&) {
+        thrown = true;
+    }
+    if (!thrown)
+        FAIL_CHECK("inconsistent number of discounts was not detected");
+
+    // results cannot overwrite an input
+    std::vector<Real> aliased = forwards;
+    thrown = false;
+    try {
+        blackFormula(Option::Call, strikes, aliased, stdDevs,
+                     discounts, aliased);
+    } catch (Error&) {
+        thrown = true;
+    }
+    if (!thrown)
+        FAIL_CHECK("results aliasing the forwards were not detected");
+}
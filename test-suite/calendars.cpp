@@ -1895,3 +1895,76 @@ TEST_CASE("Calendar_BespokeCalendars", "[Calendar]") {
         FAIL_CHECK(testDate4 << " (marked as holiday) not detected");
 
 }
+
+TEST_CASE("Calendar_BusinessDayCache", "[Calendar]") {
+
+    INFO("Testing cached business days...");
+
+    Calendar reference = JointCalendar(TARGET(), UnitedKingdom());
+    Calendar cached = JointCalendar(TARGET(), UnitedKingdom());
+    cached.enableBusinessDayCache(2000, 2030);
+
+    if (!cached.hasBusinessDayCache())
+        FAIL("cache not enabled");
+
+    // holidays added or removed after the cache is built
+    Date added(27, May, 2015), removed(25, December, 2020);
+    cached.addHoliday(added);
+    reference.addHoliday(added);
+    cached.removeHoliday(removed);
+    reference.removeHoliday(removed);
+
+    for (Date d(1, June, 1999); d <= Date(31, July, 2031); ++d) {
+        if (cached.isBusinessDay(d) != reference.isBusinessDay(d))
+            FAIL("business day mismatch at " << d);
+    }
+
+    Integer steps[] = { 1, 2, 5, 20, 250, 2500, -1, -3, -20, -250, -2500 };
+    for (Date d(15, December, 1999); d <= Date(15, January, 2031); d += 11) {
+        for (Integer n : steps) {
+            Date calculated = cached.advance(d, n, Days);
+            Date expected = reference.advance(d, n, Days);
+            if (calculated != expected)
+                FAIL("advancing " << d << " by " << n
+                     << " business days:\n"
+                     << "    calculated: " << calculated << "\n"
+                     << "    expected:   " << expected);
+        }
+        Date to = d + 397*Days;
+        for (Integer i=0; i<4; ++i) {
+            bool includeFirst = (i & 1) != 0, includeLast = (i & 2) != 0;
+            Date::serial_type calculated =
+                cached.businessDaysBetween(d, to, includeFirst, includeLast);
+            Date::serial_type expected =
+                reference.businessDaysBetween(d, to, includeFirst, includeLast);
+            if (calculated != expected)
+                FAIL("business days between " << d << " and " << to
+                     << ":\n"
+                     << "    calculated: " << calculated << "\n"
+                     << "    expected:   " << expected);
+            calculated =
+                cached.businessDaysBetween(to, d, includeFirst, includeLast);
+            expected =
+                reference.businessDaysBetween(to, d, includeFirst, includeLast);
+            if (calculated != expected)
+                FAIL("business days between " << to << " and " << d
+                     << ":\n"
+                     << "    calculated: " << calculated << "\n"
+                     << "    expected:   " << expected);
+        }
+    }
+
+    cached.addHoliday(removed);
+    if (cached.isBusinessDay(removed))
+        FAIL(removed << " not detected as holiday after being added again");
+
+    BespokeCalendar bespoke;
+    bespoke.enableBusinessDayCache(2020, 2021);
+    bespoke.addWeekend(Sunday);
+    if (bespoke.isBusinessDay(Date(5, July, 2020)))
+        FAIL("added weekend not detected in cached calendar");
+
+    cached.disableBusinessDayCache();
+    if (cached.hasBusinessDayCache())
+        FAIL("cache not disabled");
+}
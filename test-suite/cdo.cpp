@@ -27,6 +27,8 @@
 #include <ql/experimental/credit/homogeneouspooldef.hpp>
 
 #include <ql/experimental/credit/gaussianlhplossmodel.hpp>
+#include <ql/experimental/credit/recursivelossmodel.hpp>
+#include <ql/experimental/credit/fftlossmodel.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
 #include <ql/termstructures/credit/flathazardrate.hpp>
 #include <ql/time/calendars/target.hpp>
@@ -373,3 +375,89 @@ TEST_CASE("Cdo_HW", "[Cdo]") {
 	    testHW(i);
     #endif
 }
+
+TEST_CASE("Cdo_FFTLossModel", "[Cdo]") {
+    #ifndef QL_PATCH_SOLARIS
+    INFO("Testing FFT loss model against the recursive loss model...");
+
+    SavedSettings backup;
+
+    Date asofDate = Date(31, August, 2006);
+    Settings::instance().evaluationDate() = asofDate;
+
+    // heterogeneous names: notionals, recoveries and default intensities;
+    //   with a single intensity, names with the same loss are identical
+    Size poolSize = 40;
+    Size intensities[] = { poolSize, 1 };
+    for (Size n : intensities) {
+        std::shared_ptr<Pool> pool(new Pool());
+        vector<string> names;
+        vector<Real> nominals, recoveries;
+        for (Size i=0; i<poolSize; ++i) {
+            ostringstream o;
+            o << "issuer-" << i;
+            names.emplace_back(o.str());
+            nominals.emplace_back(100.0 * (1 + i % 3));
+            recoveries.emplace_back(i % 2 == 0 ? 0.4 : 0.3);
+
+            Real intensity = 0.005 + 0.001 * (i % n);
+            std::shared_ptr<DefaultProbabilityTermStructure> ptr(
+                new FlatHazardRate(asofDate,
+                                   Handle<Quote>(std::shared_ptr<Quote>(
+                                       new SimpleQuote(intensity))),
+                                   ActualActual()));
+            vector<pair<DefaultProbKey,
+                Handle<DefaultProbabilityTermStructure> > > probabilities;
+            probabilities.emplace_back(
+                NorthAmericaCorpDefaultKey(EURCurrency(), SeniorSec,
+                                           Period(0, Weeks), 10.),
+                Handle<DefaultProbabilityTermStructure>(ptr));
+            pool->add(names.back(), Issuer(probabilities),
+                      NorthAmericaCorpDefaultKey(EURCurrency(), SeniorSec,
+                                                 Period(), 1.));
+        }
+
+        Handle<Quote> correlation(
+                             std::shared_ptr<Quote>(new SimpleQuote(0.3)));
+        Size nBuckets = 4;
+        std::shared_ptr<GaussianConstantLossLM> recursiveLM(
+            new GaussianConstantLossLM(correlation, recoveries,
+                LatentModelIntegrationType::GaussianQuadrature, poolSize,
+                GaussianCopulaPolicy::initTraits()));
+        std::shared_ptr<GaussianConstantLossLM> fftLM(
+            new GaussianConstantLossLM(correlation, recoveries,
+                LatentModelIntegrationType::GaussianQuadrature, poolSize,
+                GaussianCopulaPolicy::initTraits()));
+        std::shared_ptr<DefaultLossModel> recursiveModel(
+            new RecursiveGaussLossModel(recursiveLM, nBuckets));
+        // a single model is shared by all tranches of the pool
+        std::shared_ptr<DefaultLossModel> fftModel(
+            new FFTGaussLossModel(fftLM, nBuckets));
+
+        Date dates[] = { asofDate + Period(1, Years),
+                         asofDate + Period(3, Years),
+                         asofDate + Period(5, Years) };
+        // the two models integrate over the market factor in different ways
+        Real tolerance = 1.0e-8;
+        for (Size j = 0; j < LENGTH(hwAttachment); j++) {
+            std::shared_ptr<Basket> basket(
+                new Basket(asofDate, names, nominals, pool,
+                           hwAttachment[j], hwDetachment[j]));
+            for (Size k = 0; k < LENGTH(dates); k++) {
+                basket->setLossModel(recursiveModel);
+                Real expected = basket->expectedTrancheLoss(dates[k]);
+                basket->setLossModel(fftModel);
+                Real calculated = basket->expectedTrancheLoss(dates[k]);
+                if (std::fabs(calculated - expected) >
+                                        tolerance * basket->trancheNotional())
+                    FAIL_CHECK("expected tranche loss mismatch on tranche ["
+                               << hwAttachment[j] << ", " << hwDetachment[j]
+                               << "] at " << dates[k]
+                               << std::setprecision(12)
+                               << "\n    recursive: " << expected
+                               << "\n    FFT:       " << calculated);
+            }
+        }
+    }
+    #endif
+}
@@ -1558,3 +1558,96 @@ TEST_CASE("EuropeanOption_AnalyticEngineDiscountCurve", "[EuropeanOption]") {
     npvMultiCurve = option.NPV();
     CHECK(npvSingleCurve != npvMultiCurve);
 }
+
+TEST_CASE("EuropeanOption_MultiThreadedMcEngine", "[EuropeanOption]") {
+    INFO("Testing multi-threaded Monte Carlo European engine...");
+
+    SavedSettings backup;
+
+    DayCounter dc = Actual360();
+    Date today = Date::todaysDate();
+    Settings::instance().evaluationDate() = today;
+
+    std::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    std::shared_ptr<YieldTermStructure> qTS = flatRate(today, 0.02, dc);
+    std::shared_ptr<YieldTermStructure> rTS = flatRate(today, 0.05, dc);
+    std::shared_ptr<BlackVolTermStructure> volTS = flatVol(today, 0.25, dc);
+
+    std::shared_ptr<BlackScholesMertonProcess> stochProcess(new
+        BlackScholesMertonProcess(Handle<Quote>(spot),
+            Handle<YieldTermStructure>(qTS),
+            Handle<YieldTermStructure>(rTS),
+            Handle<BlackVolTermStructure>(volTS)));
+
+    std::shared_ptr<StrikedTypePayoff> payoff(new
+        PlainVanillaPayoff(Option::Put, 105.0));
+    Date exDate = today + Period(1, Years);
+    std::shared_ptr<Exercise> exercise(new EuropeanExercise(exDate));
+    EuropeanOption option(payoff, exercise);
+
+    option.setPricingEngine(std::shared_ptr<PricingEngine>(
+        new AnalyticEuropeanEngine(stochProcess)));
+    Real expected = option.NPV();
+
+    const Size samples = 50001;
+    const BigNatural seed = 42;
+
+    // a single thread must reproduce the serial engine
+    option.setPricingEngine(MakeMCEuropeanEngine<PseudoRandom>(stochProcess)
+                            .withSteps(1)
+                            .withSamples(samples)
+                            .withSeed(seed));
+    Real serial = option.NPV();
+    option.setPricingEngine(MakeMCEuropeanEngine<PseudoRandom>(stochProcess)
+                            .withSteps(1)
+                            .withSamples(samples)
+                            .withSeed(seed)
+                            .withThreads(1));
+    if (option.NPV() != serial)
+        FAIL_CHECK("single-threaded engine does not reproduce serial one:"
+                   << "\n    serial value:          " << serial
+                   << "\n    single-threaded value: " << option.NPV());
+
+    std::shared_ptr<PricingEngine> threaded =
+        MakeMCEuropeanEngine<PseudoRandom>(stochProcess)
+        .withSteps(1)
+        .withSamples(samples)
+        .withSeed(seed)
+        .withThreads(4);
+    option.setPricingEngine(threaded);
+    Real first = option.NPV();
+    Real errorEstimate = option.errorEstimate();
+
+    // force recalculation with the same seed and number of threads
+    option.setPricingEngine(MakeMCEuropeanEngine<PseudoRandom>(stochProcess)
+                            .withSteps(1)
+                            .withSamples(samples)
+                            .withSeed(seed)
+                            .withThreads(4));
+    Real second = option.NPV();
+
+    if (first != second)
+        FAIL_CHECK("multi-threaded results are not reproducible:"
+                   << "\n    first run:  " << first
+                   << "\n    second run: " << second);
+
+    if (std::fabs(first - expected) > 4.0*errorEstimate)
+        FAIL_CHECK("multi-threaded result inconsistent with analytic value:"
+                   << "\n    calculated:     " << first
+                   << "\n    expected:       " << expected
+                   << "\n    error estimate: " << errorEstimate);
+
+    // tolerance-driven runs add samples in several batches
+    option.setPricingEngine(MakeMCEuropeanEngine<PseudoRandom>(stochProcess)
+                            .withSteps(1)
+                            .withAbsoluteTolerance(0.02)
+                            .withSeed(seed)
+                            .withThreads(3));
+    Real calculated = option.NPV();
+    errorEstimate = option.errorEstimate();
+    if (errorEstimate > 0.02 || std::fabs(calculated - expected) > 0.1)
+        FAIL_CHECK("multi-threaded tolerance-driven run failed:"
+                   << "\n    calculated:     " << calculated
+                   << "\n    expected:       " << expected
+                   << "\n    error estimate: " << errorEstimate);
+}
@@ -734,6 +734,88 @@ TEST_CASE("FdmLinearOp_TripleBandMapSolve", "[FdmLinearOp]") {
     }
 }
 
+TEST_CASE("FdmLinearOp_InPlaceOperators", "[FdmLinearOp]") {
+
+    INFO("Testing in-place application and solution of operators...");
+
+    SavedSettings backup;
+
+    Size dims[] = {50, 40};
+    const std::vector<Size> dim(dims, dims + LENGTH(dims));
+
+    std::shared_ptr < FdmLinearOpLayout > layout(new FdmLinearOpLayout(dim));
+
+    std::vector<std::pair<Real, Real> > boundaries;
+    boundaries.emplace_back(std::pair < Real, Real > (3.8, 4.905274778));
+    boundaries.emplace_back(std::pair < Real, Real > (0.000, 1.0));
+
+    std::shared_ptr < FdmMesher > mesher(
+            new UniformGridMesher(layout, boundaries));
+
+    Handle<Quote> s0(std::shared_ptr < Quote > (new SimpleQuote(100.0)));
+    Handle<YieldTermStructure> rTS(flatRate(0.05, Actual365Fixed()));
+    Handle<YieldTermStructure> qTS(flatRate(0.02, Actual365Fixed()));
+
+    std::shared_ptr < HestonProcess > hestonProcess(
+            new HestonProcess(rTS, qTS, s0, 0.04, 2.5, 0.04, 0.66, -0.8));
+
+    FdmHestonOp hestonOp(mesher, hestonProcess);
+    hestonOp.setTime(0.5, 0.6);
+
+    Array u(layout->size());
+    for (Size i = 0; i < layout->size(); ++i)
+        u[i] = std::sin(0.1 * i) + std::cos(0.35 * i);
+
+    const Real tol = 1e-12;
+    Array out(layout->size()), work(layout->size());
+
+    hestonOp.apply_into(u, out);
+    Array expected = hestonOp.apply(u);
+    for (Size i = 0; i < u.size(); ++i)
+        if (std::fabs(expected[i] - out[i]) > tol)
+            FAIL("in-place application is not consistent "
+                         << "\n expected      : " << expected[i]
+                         << "\n calculated    : " << out[i]);
+
+    hestonOp.apply_mixed_into(u, out);
+    expected = hestonOp.apply_mixed(u);
+    for (Size i = 0; i < u.size(); ++i)
+        if (std::fabs(expected[i] - out[i]) > tol)
+            FAIL("in-place mixed application is not consistent "
+                         << "\n expected      : " << expected[i]
+                         << "\n calculated    : " << out[i]);
+
+    for (Size direction = 0; direction < hestonOp.size(); ++direction) {
+        hestonOp.apply_direction_into(direction, u, out);
+        expected = hestonOp.apply_direction(direction, u);
+        for (Size i = 0; i < u.size(); ++i)
+            if (std::fabs(expected[i] - out[i]) > tol)
+                FAIL("in-place directional application is not consistent "
+                             << "\n direction     : " << direction
+                             << "\n expected      : " << expected[i]
+                             << "\n calculated    : " << out[i]);
+
+        hestonOp.solve_splitting_into(direction, u, -0.05, out, work);
+        expected = hestonOp.solve_splitting(direction, u, -0.05);
+        for (Size i = 0; i < u.size(); ++i)
+            if (std::fabs(expected[i] - out[i]) > tol)
+                FAIL("in-place splitting solution is not consistent "
+                             << "\n direction     : " << direction
+                             << "\n expected      : " << expected[i]
+                             << "\n calculated    : " << out[i]);
+
+        // the solution can overwrite the right hand side
+        out = u;
+        hestonOp.solve_splitting_into(direction, out, -0.05, out, work);
+        for (Size i = 0; i < u.size(); ++i)
+            if (std::fabs(expected[i] - out[i]) > tol)
+                FAIL("aliased splitting solution is not consistent "
+                             << "\n direction     : " << direction
+                             << "\n expected      : " << expected[i]
+                             << "\n calculated    : " << out[i]);
+    }
+}
+
 TEST_CASE("FdmLinearOp_FdmHestonBarrier", "[FdmLinearOp]") {
 
     INFO("Testing FDM with barrier option in Heston model...");
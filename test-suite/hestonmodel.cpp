@@ -293,6 +293,213 @@ TEST_CASE("HestonModel_DAXCalibration", "[HestonModel]") {
     }
 }
 
+TEST_CASE("HestonModel_AnalyticGradient", "[HestonModel]") {
+
+    INFO("Testing analytic Heston parameter gradient...");
+
+    SavedSettings backup;
+
+    const Date settlementDate(27, December, 2004);
+    Settings::instance().evaluationDate() = settlementDate;
+    const DayCounter dayCounter = Actual365Fixed();
+
+    const Handle<YieldTermStructure> riskFreeTS(
+                                flatRate(settlementDate, 0.03, dayCounter));
+    const Handle<YieldTermStructure> dividendTS(
+                                flatRate(settlementDate, 0.01, dayCounter));
+    const Handle<Quote> s0(std::make_shared<SimpleQuote>(100.0));
+
+    const std::shared_ptr<HestonModel> model =
+        std::make_shared<HestonModel>(
+            std::make_shared<HestonProcess>(riskFreeTS, dividendTS, s0,
+                                            0.04, 1.5, 0.06, 0.6, -0.6));
+
+    const std::shared_ptr<AnalyticHestonEngine> engines[] = {
+        std::make_shared<AnalyticHestonEngine>(model, 144),
+        std::make_shared<AnalyticHestonEngine>(
+            model, AnalyticHestonEngine::Gatheral,
+            AnalyticHestonEngine::Integration::gaussLegendre(256))
+    };
+
+    const Period maturities[] = { Period(3, Months), Period(1, Years),
+                                  Period(5, Years) };
+    const Real strikes[] = { 70.0, 100.0, 140.0 };
+    const Option::Type types[] = { Option::Call, Option::Put };
+
+    const Array params = model->params();
+    const Real h = 1e-5, tolerance = 1e-6;
+
+    for (const auto& engine : engines) {
+        if (!engine->providesGradient())
+            FAIL("gradient not available for Gaussian quadrature");
+        for (const auto& maturity : maturities) {
+            for (Real strike : strikes) {
+                for (Option::Type type : types) {
+                    VanillaOption option(
+                        std::make_shared<PlainVanillaPayoff>(type, strike),
+                        std::make_shared<EuropeanExercise>(
+                                               settlementDate + maturity));
+                    option.setPricingEngine(engine);
+
+                    model->setParams(params);
+                    VanillaOption::arguments arguments;
+                    option.setupArguments(&arguments);
+                    Array gradient;
+                    const Real value =
+                        engine->valueAndGradient(arguments, gradient);
+
+                    if (std::fabs(value - option.NPV()) > 1e-10)
+                        FAIL_CHECK("failed to reproduce option value"
+                                   << "\n    calculated: " << value
+                                   << "\n    expected:   " << option.NPV());
+
+                    for (Size k=0; k<params.size(); ++k) {
+                        Array p = params;
+                        p[k] += h;
+                        model->setParams(p);
+                        const Real up = option.NPV();
+                        p[k] -= 2*h;
+                        model->setParams(p);
+                        const Real down = option.NPV();
+                        const Real expected = (up - down)/(2*h);
+
+                        if (std::fabs(gradient[k] - expected)
+                                > tolerance*std::max(1.0, std::fabs(expected)))
+                            FAIL_CHECK("failed to reproduce derivative #" << k
+                                       << " for " << type << " option"
+                                       << "\n    strike:     " << strike
+                                       << "\n    maturity:   " << maturity
+                                       << std::setprecision(10)
+                                       << "\n    calculated: " << gradient[k]
+                                       << "\n    expected:   " << expected);
+                    }
+                }
+            }
+        }
+    }
+    model->setParams(params);
+
+    const AnalyticHestonEngine adaptiveEngine(model, 1e-8, 1000);
+    if (adaptiveEngine.providesGradient())
+        FAIL("gradient should not be available for adaptive integration");
+}
+
+TEST_CASE("HestonModel_AnalyticCalibrationJacobian", "[HestonModel]") {
+
+    INFO("Testing analytic Jacobian of the Heston calibration...");
+
+    SavedSettings backup;
+
+    const Date settlementDate(27, December, 2004);
+    Settings::instance().evaluationDate() = settlementDate;
+    const DayCounter dayCounter = Actual365Fixed();
+    const Calendar calendar = TARGET();
+
+    const Handle<YieldTermStructure> riskFreeTS(
+                                flatRate(settlementDate, 0.03, dayCounter));
+    const Handle<YieldTermStructure> dividendTS(
+                                flatRate(settlementDate, 0.01, dayCounter));
+    const Handle<Quote> s0(std::make_shared<SimpleQuote>(100.0));
+
+    // theta, kappa, sigma, rho, v0
+    const Real trueValues[] = { 0.06, 2.0, 0.5, -0.7, 0.05 };
+    const Array trueParams(trueValues, trueValues + LENGTH(trueValues));
+    const std::shared_ptr<HestonModel> model =
+        std::make_shared<HestonModel>(
+            std::make_shared<HestonProcess>(riskFreeTS, dividendTS, s0,
+                                            0.05, 2.0, 0.06, 0.5, -0.7));
+    const std::shared_ptr<PricingEngine> analyticEngine =
+        std::make_shared<AnalyticHestonEngine>(model, 144);
+
+    const Period maturities[] = { Period(6, Months), Period(1, Years),
+                                  Period(2, Years), Period(5, Years) };
+    const Real strikes[] = { 80.0, 100.0, 120.0 };
+    const CalibrationHelper::CalibrationErrorType errorTypes[] = {
+        CalibrationHelper::RelativePriceError,
+        CalibrationHelper::PriceError,
+        CalibrationHelper::ImpliedVolError
+    };
+
+    for (auto errorType : errorTypes) {
+        // market volatilities are implied by the true model
+        std::vector<std::shared_ptr<SimpleQuote> > vols;
+        std::vector<std::shared_ptr<CalibrationHelper> > helpers;
+        model->setParams(trueParams);
+        for (const auto& maturity : maturities) {
+            for (Real strike : strikes) {
+                vols.push_back(std::make_shared<SimpleQuote>(0.2));
+                helpers.push_back(std::make_shared<HestonModelHelper>(
+                    maturity, calendar, s0, strike, Handle<Quote>(vols.back()),
+                    riskFreeTS, dividendTS, errorType));
+                helpers.back()->setPricingEngine(analyticEngine);
+                vols.back()->setValue(helpers.back()->impliedVolatility(
+                    helpers.back()->modelValue(), 1e-12, 5000, 0.001, 10.0));
+            }
+        }
+
+        // the rows of the Jacobian away from the solution
+        const Real startValues[] = { 0.1, 1.0, 0.3, -0.5, 0.08 };
+        const Array start(startValues, startValues + LENGTH(startValues));
+        const Real h = 1e-5, tolerance = 1e-5;
+        for (Size i=0; i<helpers.size(); ++i) {
+            model->setParams(start);
+            if (!helpers[i]->providesGradient())
+                FAIL("gradient not available for calibration helper");
+            const Array gradient = helpers[i]->calibrationErrorGradient();
+            for (Size k=0; k<start.size(); ++k) {
+                Array p = start;
+                p[k] += h;
+                model->setParams(p);
+                const Real up = helpers[i]->calibrationError();
+                p[k] -= 2*h;
+                model->setParams(p);
+                const Real down = helpers[i]->calibrationError();
+                const Real expected = (up - down)/(2*h);
+
+                if (std::fabs(gradient[k] - expected)
+                        > tolerance*std::max(1.0, std::fabs(expected)))
+                    FAIL_CHECK("failed to reproduce finite-difference "
+                               "derivative #" << k << " of helper #" << i
+                               << "\n    error type: " << errorType
+                               << std::setprecision(10)
+                               << "\n    calculated: " << gradient[k]
+                               << "\n    expected:   " << expected);
+            }
+        }
+
+        if (errorType != CalibrationHelper::ImpliedVolError)
+            continue;
+
+        // the analytic Jacobian is used by Levenberg-Marquardt when all
+        //   the helpers provide it; an engine using adaptive integration
+        //   does not, and the finite-difference Jacobian is used instead
+        const std::shared_ptr<PricingEngine> engines[] = {
+            analyticEngine,
+            std::make_shared<AnalyticHestonEngine>(model, 1e-12, 100000)
+        };
+        for (const auto& engine : engines) {
+            for (const auto& helper : helpers)
+                helper->setPricingEngine(engine);
+            model->setParams(start);
+            LevenbergMarquardt om(1e-8, 1e-8, 1e-8);
+            model->calibrate(helpers, om,
+                             EndCriteria(400, 40, 1.0e-8, 1.0e-8, 1.0e-8));
+
+            const Array calibrated = model->params();
+            for (Size k=0; k<calibrated.size(); ++k) {
+                if (std::fabs(calibrated[k] - trueParams[k]) > 1e-4)
+                    FAIL_CHECK("failed to recover parameter #" << k
+                               << (engine == analyticEngine ?
+                                   " with analytic Jacobian" :
+                                   " with finite-difference Jacobian")
+                               << std::setprecision(10)
+                               << "\n    calculated: " << calibrated[k]
+                               << "\n    expected:   " << trueParams[k]);
+            }
+        }
+    }
+}
+
 TEST_CASE("HestonModel_AnalyticVsBlack", "[HestonModel]") {
     INFO("Testing analytic Heston engine against Black formula...");
 
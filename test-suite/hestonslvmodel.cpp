@@ -46,6 +46,7 @@
 #include <ql/termstructures/volatility/equityfx/noexceptlocalvolsurface.hpp>
 #include <ql/termstructures/volatility/equityfx/fixedlocalvolsurface.hpp>
 #include <ql/termstructures/volatility/equityfx/gridmodellocalvolsurface.hpp>
+#include <ql/termstructures/volatility/equityfx/griddedlocalvolsurface.hpp>
 #include <ql/termstructures/volatility/equityfx/localconstantvol.hpp>
 #include <ql/termstructures/volatility/equityfx/localvolsurface.hpp>
 #include <ql/termstructures/volatility/equityfx/hestonblackvolsurface.hpp>
@@ -1727,6 +1728,102 @@ TEST_CASE("HestonSLVModel_BarrierPricingViaHestonLocalVol", "[HestonSLVModel]")
     }
 }
 
+TEST_CASE("HestonSLVModel_GriddedLocalVolSurface", "[HestonSLVModel]") {
+    INFO("Testing gridded local volatility surface...");
+
+    SavedSettings backup;
+    const DayCounter dc = Actual365Fixed();
+    const Date todaysDate(5, Nov, 2015);
+    Settings::instance().evaluationDate() = todaysDate;
+
+    const std::shared_ptr<SimpleQuote> spotQuote =
+        std::make_shared<SimpleQuote>(100.0);
+    const Handle<Quote> spot(spotQuote);
+    const Handle<YieldTermStructure> rTS(flatRate(0.03, dc));
+    const Handle<YieldTermStructure> qTS(flatRate(0.01, dc));
+
+    const Handle<HestonModel> hestonModel(
+        std::make_shared<HestonModel>(
+            std::make_shared<HestonProcess>(
+                rTS, qTS, spot, 0.04, 1.0, 0.04, 0.3, -0.5)));
+    const Handle<BlackVolTermStructure> surf(
+        std::make_shared<HestonBlackVolSurface>(hestonModel));
+
+    // Heston implied vols are too noisy for Dupire's formula at very
+    // short times and far from the money; the gridded surface samples
+    // them on its first rows and columns.
+    const Handle<LocalVolTermStructure> localVol(
+        std::make_shared<NoExceptLocalVolSurface>(surf, rTS, qTS, spot, 0.2));
+
+    const Time maxTime = 2.0;
+    const Real minStrike = 50.0, maxStrike = 200.0;
+    GriddedLocalVolSurface linear(localVol, maxTime, 40,
+                                  minStrike, maxStrike, 60,
+                                  GriddedLocalVolSurface::Linear);
+    GriddedLocalVolSurface cubic(localVol, maxTime, 40,
+                                 minStrike, maxStrike, 60,
+                                 GriddedLocalVolSurface::Cubic);
+    GriddedLocalVolSurface cubicMT(localVol, maxTime, 40,
+                                   minStrike, maxStrike, 60,
+                                   GriddedLocalVolSurface::Cubic, 3);
+
+    const Matrix& m1 = cubic.localVols();
+    const Matrix& m3 = cubicMT.localVols();
+    for (Size i=0; i<m1.rows(); ++i) {
+        for (Size j=0; j<m1.columns(); ++j) {
+            if (m1[i][j] != m3[i][j]) {
+                FAIL("local vols sampled on multiple threads differ"
+                     << "\n    single thread: " << m1[i][j]
+                     << "\n    three threads: " << m3[i][j]);
+            }
+        }
+    }
+
+    const Time times[] = { 0.37, 0.77, 1.5, 1.93 };
+    const Real strikes[] = { 72.5, 82.5, 93.0, 104.0, 121.0, 140.0 };
+
+    for (Real s0 : { 100.0, 110.0 }) {
+        // the gridded surfaces are expected to follow the spot
+        spotQuote->setValue(s0);
+
+        for (Time t : times) {
+            for (Real strike : strikes) {
+                const Volatility expected = localVol->localVol(t, strike);
+                const Volatility linearVol = linear.localVol(t, strike);
+                const Volatility cubicVol = cubic.localVol(t, strike);
+
+                if (std::fabs(linearVol - expected) > 1e-3) {
+                    FAIL_CHECK("failed to reproduce local vol with "
+                               "bilinear interpolation"
+                               << "\n    spot:       " << s0
+                               << "\n    time:       " << t
+                               << "\n    strike:     " << strike
+                               << "\n    expected:   " << expected
+                               << "\n    calculated: " << linearVol);
+                }
+                if (std::fabs(cubicVol - expected) > 1e-4) {
+                    FAIL_CHECK("failed to reproduce local vol with "
+                               "cubic interpolation"
+                               << "\n    spot:       " << s0
+                               << "\n    time:       " << t
+                               << "\n    strike:     " << strike
+                               << "\n    expected:   " << expected
+                               << "\n    calculated: " << cubicVol);
+                }
+            }
+        }
+    }
+
+    // flat extrapolation outside the grid
+    const Volatility corner = cubic.localVol(maxTime, maxStrike);
+    const Volatility extrapolated = cubic.localVol(3.0, 400.0, true);
+    if (std::fabs(extrapolated - corner) > 1e-14) {
+        FAIL_CHECK("failed to extrapolate flat"
+                   << "\n    expected:   " << corner
+                   << "\n    calculated: " << extrapolated);
+    }
+}
+
 TEST_CASE("HestonSLVModel_BarrierPricingMixedModels", "[.]") {
     INFO("Testing Barrier pricing with mixed models...");
 
@@ -2069,6 +2166,55 @@ TEST_CASE("HestonSLVModel_MonteCarloCalibration", "[HestonSLVModel]") {
 }
 
 
+TEST_CASE("HestonSLVModel_ParallelMonteCarloCalibration", "[HestonSLVModel]") {
+    INFO("Testing multi-threaded Monte-Carlo calibration...");
+
+    SavedSettings backup;
+
+    const DayCounter dc = ActualActual();
+    const Date todaysDate(5, Jan, 2016);
+    const Date maturityDate = todaysDate + Period(1, Years);
+    Settings::instance().evaluationDate() = todaysDate;
+
+    const Handle<Quote> spot(std::make_shared<SimpleQuote>(100.0));
+    const Handle<YieldTermStructure> rTS(flatRate(0.05, dc));
+    const Handle<YieldTermStructure> qTS(flatRate(0.02, dc));
+
+    const Handle<LocalVolTermStructure> localVol(
+        std::make_shared<LocalConstantVol>(todaysDate, 0.3, dc));
+
+    const Handle<HestonModel> hestonModel(
+        std::make_shared<HestonModel>(
+            std::make_shared<HestonProcess>(
+                rTS, qTS, spot, 0.09, 1.0, 0.06, 0.4, -0.75)));
+
+    const auto leverageFunction = [&](Size threads) {
+        return HestonSLVMCModel(
+            localVol, hestonModel,
+            std::make_shared<MTBrownianGeneratorFactory>(1234ul),
+            maturityDate, 52, 51, 5000, std::vector<Date>(),
+            threads).leverageFunction();
+    };
+
+    const std::shared_ptr<LocalVolTermStructure> l1 = leverageFunction(1);
+    const std::shared_ptr<LocalVolTermStructure> l3 = leverageFunction(3);
+
+    for (Time t = 0.05; t < 1.0; t += 0.1) {
+        for (Real strike = 60.0; strike < 160.0; strike += 5.0) {
+            const Volatility expected = l1->localVol(t, strike, true);
+            const Volatility calculated = l3->localVol(t, strike, true);
+            if (expected != calculated) {
+                FAIL_CHECK("leverage functions calibrated on one and "
+                           "three threads differ"
+                           << "\n    time:          " << t
+                           << "\n    strike:        " << strike
+                           << "\n    one thread:    " << expected
+                           << "\n    three threads: " << calculated);
+            }
+        }
+    }
+}
+
 TEST_CASE("HestonSLVModel_ForwardSkewSLV", "[.]") {
     INFO("Testing the implied volatility skew of "
         "forward starting options in SLV model...");
@@ -0,0 +1,782 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*
+ QuantLib Kernel Benchmark
+
+ Times a set of kernels, one per subsystem (curve bootstrap, finite-
+ difference and lattice rollback, Monte Carlo path generation and
+ pricing, interpolation lookup, model calibration, credit loss
+ models, dense linear algebra) so that a regression can be traced to
+ the subsystem that caused it.  The linear-algebra kernels are also run with reference
+ implementations using plain triple loops, for comparison.
+
+ Each kernel is set up once, run a few times as a warm-up, and then
+ timed over a number of repetitions; the median, 95th percentile,
+ mean and minimum time per iteration are reported together with the
+ number of heap allocations per iteration.  Kernels that can use
+ several threads are also run for each of the given thread counts.
+
+ Usage: quantlib-kernel-benchmark [options]
+   --repetitions=N       timed iterations per kernel (default: 10)
+   --warmup=N            untimed iterations per kernel (default: 2)
+   --threads=N[,M...]    thread counts for threaded kernels (default: 1)
+   --filter=TEXT         only run kernels whose name contains TEXT
+   --json=FILE           write the results to FILE in JSON format
+   --csv=FILE            write the results to FILE in CSV format
+   --baseline=FILE       compare the medians with a CSV file written
+                         by a previous run; the exit code is 2 if any
+                         kernel is slower than the baseline by more
+                         than the tolerance
+   --tolerance=X         relative tolerance for the comparison
+                         (default: 0.10)
+   --list                list the available kernels and exit
+*/
+
+#include <ql/instruments/vanillaoption.hpp>
+#include <ql/discretizedasset.hpp>
+#include <ql/experimental/credit/basket.hpp>
+#include <ql/experimental/credit/fftlossmodel.hpp>
+#include <ql/experimental/credit/pool.hpp>
+#include <ql/experimental/credit/recursivelossmodel.hpp>
+#include <ql/pricingengines/vanilla/fdblackscholesvanillaengine.hpp>
+#include <ql/pricingengines/vanilla/mceuropeanengine.hpp>
+#include <ql/pricingengines/vanilla/analytichestonengine.hpp>
+#include <ql/processes/blackscholesprocess.hpp>
+#include <ql/methods/montecarlo/pathgenerator.hpp>
+#include <ql/math/randomnumbers/rngtraits.hpp>
+#include <ql/math/randomnumbers/mt19937uniformrng.hpp>
+#include <ql/math/interpolations/linearinterpolation.hpp>
+#include <ql/math/interpolations/cubicinterpolation.hpp>
+#include <ql/math/matrixutilities/denselinearalgebra.hpp>
+#include <ql/math/optimization/levenbergmarquardt.hpp>
+#include <ql/models/shortrate/onefactormodels/hullwhite.hpp>
+#include <ql/models/equity/hestonmodel.hpp>
+#include <ql/models/equity/hestonmodelhelper.hpp>
+#include <ql/termstructures/yield/piecewiseyieldcurve.hpp>
+#include <ql/termstructures/yield/ratehelpers.hpp>
+#include <ql/termstructures/yield/flatforward.hpp>
+#include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
+#include <ql/termstructures/credit/flathazardrate.hpp>
+#include <ql/currencies/europe.hpp>
+#include <ql/indexes/ibor/euribor.hpp>
+#include <ql/quotes/simplequote.hpp>
+#include <ql/time/calendars/target.hpp>
+#include <ql/time/daycounters/actual360.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
+#include <ql/time/daycounters/actualactual.hpp>
+#include <ql/time/daycounters/thirty360.hpp>
+#include <ql/settings.hpp>
+#include <ql/version.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace QuantLib;
+
+namespace {
+
+    // number of heap allocations made by the program so far
+    std::atomic<unsigned long> allocationCount(0);
+
+}
+
+// The global allocation functions are replaced so that allocations
+// can be counted; the array forms forward to these by default.
+void* operator new(std::size_t size) {
+    ++allocationCount;
+    if (void* p = std::malloc(size == 0 ? 1 : size))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+
+    // A kernel is set up for a given number of threads, returning the
+    // operation to be timed; the setup itself is not timed.
+    struct Kernel {
+        std::string name;
+        bool threaded;
+        std::function<std::function<void()>(Size threads)> setup;
+    };
+
+    struct Result {
+        std::string name;
+        Size threads;
+        Size repetitions;
+        double median, p95, mean, min;
+        double allocations;
+        std::string key() const {
+            std::ostringstream out;
+            out << name << "@" << threads;
+            return out.str();
+        }
+    };
+
+
+    // curve bootstrap: a 30-year Euribor curve over deposits and swaps;
+    // the first quote is bumped so that all pillars are bootstrapped.
+    std::function<void()> curveBootstrap(Size) {
+        Calendar calendar = TARGET();
+        Date today = calendar.adjust(Date(15, January, 2020));
+        Settings::instance().evaluationDate() = today;
+        Date settlement = calendar.advance(today, 2, Days);
+
+        std::shared_ptr<IborIndex> euribor6m =
+            std::make_shared<Euribor6M>();
+        std::vector<std::shared_ptr<SimpleQuote> > quotes;
+        std::vector<std::shared_ptr<RateHelper> > helpers;
+
+        Integer depositMonths[] = { 1, 2, 3, 6, 9 };
+        for (Integer n : depositMonths) {
+            quotes.push_back(std::make_shared<SimpleQuote>(0.01 + 0.0001*n));
+            helpers.push_back(std::make_shared<DepositRateHelper>(
+                Handle<Quote>(quotes.back()), n*Months, 2, calendar,
+                ModifiedFollowing, true, Actual360()));
+        }
+        for (Integer n=1; n<=30; ++n) {
+            quotes.push_back(std::make_shared<SimpleQuote>(0.012 + 0.0005*n));
+            helpers.push_back(std::make_shared<SwapRateHelper>(
+                Handle<Quote>(quotes.back()), n*Years, calendar, Annual,
+                Unadjusted, Thirty360(Thirty360::BondBasis), euribor6m));
+        }
+
+        std::shared_ptr<YieldTermStructure> curve =
+            std::make_shared<PiecewiseYieldCurve<Discount, LogLinear> >(
+                settlement, helpers, Actual360());
+        std::shared_ptr<SimpleQuote> first = quotes.front();
+        Real base = first->value();
+        Date maturity = settlement + 30*Years;
+        bool bumped = false;
+
+        return [curve, first, base, maturity, bumped]() mutable {
+            bumped = !bumped;
+            first->setValue(bumped ? base + 0.0001 : base);
+            curve->discount(maturity);
+        };
+    }
+
+    std::shared_ptr<GeneralizedBlackScholesProcess> blackScholesProcess() {
+        Date today = Settings::instance().evaluationDate();
+        DayCounter dc = Actual365Fixed();
+        return std::make_shared<BlackScholesMertonProcess>(
+            Handle<Quote>(std::make_shared<SimpleQuote>(100.0)),
+            Handle<YieldTermStructure>(
+                std::make_shared<FlatForward>(today, 0.02, dc)),
+            Handle<YieldTermStructure>(
+                std::make_shared<FlatForward>(today, 0.05, dc)),
+            Handle<BlackVolTermStructure>(
+                std::make_shared<BlackConstantVol>(today, TARGET(),
+                                                   0.20, dc)));
+    }
+
+    // finite-difference rollback: an American put on a 400x400 grid
+    std::function<void()> fdRollback(Size) {
+        Date today(15, January, 2020);
+        Settings::instance().evaluationDate() = today;
+
+        std::shared_ptr<VanillaOption> option =
+            std::make_shared<VanillaOption>(
+                std::make_shared<PlainVanillaPayoff>(Option::Put, 100.0),
+                std::make_shared<AmericanExercise>(today, today + 1*Years));
+        option->setPricingEngine(
+            std::make_shared<FdBlackScholesVanillaEngine>(
+                                   blackScholesProcess(), 400, 400));
+        return [option]() {
+            option->recalculate();
+        };
+    }
+
+    std::shared_ptr<HullWhite> hullWhiteModel() {
+        Date today(15, January, 2020);
+        Settings::instance().evaluationDate() = today;
+
+        return std::make_shared<HullWhite>(
+            Handle<YieldTermStructure>(
+                std::make_shared<FlatForward>(today, 0.02,
+                                              Actual365Fixed())),
+            0.05, 0.01);
+    }
+
+    void rollbackDiscountBond(const std::shared_ptr<Lattice>& lattice) {
+        DiscretizedDiscountBond bond;
+        bond.initialize(lattice, 10.0);
+        bond.rollback(0.0);
+        if (bond.presentValue() < 0.0)
+            std::cout << bond.presentValue() << std::endl;
+    }
+
+    // lattice rollback: a discount bond on a Hull-White tree with
+    // 2000 steps over 10 years, built once
+    std::function<void()> latticeRollback(Size) {
+        std::shared_ptr<Lattice> lattice =
+            hullWhiteModel()->tree(TimeGrid(10.0, 2000));
+        return [lattice]() {
+            rollbackDiscountBond(lattice);
+        };
+    }
+
+    // lattice pricing: as above, but the tree is built at each
+    // iteration, as tree engines do when calculating
+    std::function<void()> latticePricing(Size) {
+        std::shared_ptr<HullWhite> model = hullWhiteModel();
+        return [model]() {
+            rollbackDiscountBond(model->tree(TimeGrid(10.0, 2000)));
+        };
+    }
+
+    // path generation: 10000 pseudo-random paths with 100 steps
+    std::function<void()> mcPathGeneration(Size) {
+        Settings::instance().evaluationDate() = Date(15, January, 2020);
+
+        typedef PseudoRandom::rsg_type rsg_type;
+        const Size steps = 100;
+        std::shared_ptr<PathGenerator<rsg_type> > generator =
+            std::make_shared<PathGenerator<rsg_type> >(
+                blackScholesProcess(), 1.0, steps,
+                PseudoRandom::make_sequence_generator(steps, 42), false);
+        return [generator]() {
+            Real sum = 0.0;
+            for (Size i=0; i<10000; ++i)
+                sum += generator->next().value.back();
+            if (sum < 0.0)
+                std::cout << sum << std::endl;
+        };
+    }
+
+    // Monte Carlo pricing: a European call with 100000 samples
+    std::function<void()> mcEuropean(Size threads) {
+        Date today(15, January, 2020);
+        Settings::instance().evaluationDate() = today;
+
+        std::shared_ptr<VanillaOption> option =
+            std::make_shared<VanillaOption>(
+                std::make_shared<PlainVanillaPayoff>(Option::Call, 100.0),
+                std::make_shared<EuropeanExercise>(today + 1*Years));
+        std::shared_ptr<PricingEngine> engine =
+            MakeMCEuropeanEngine<PseudoRandom>(blackScholesProcess())
+            .withSteps(1)
+            .withSamples(100000)
+            .withSeed(42)
+            .withThreads(threads);
+        option->setPricingEngine(engine);
+        return [option]() {
+            option->recalculate();
+        };
+    }
+
+    // interpolation lookup: 100000 random lookups on 1000 nodes
+    template <class I>
+    std::function<void()> interpolationLookup(Size) {
+        const Size nodes = 1000, lookups = 100000;
+        auto x = std::make_shared<std::vector<Real> >(nodes);
+        auto y = std::make_shared<std::vector<Real> >(nodes);
+        for (Size i=0; i<nodes; ++i) {
+            (*x)[i] = 0.01*i;
+            (*y)[i] = std::sin((*x)[i]);
+        }
+        auto f = std::make_shared<I>(x->begin(), x->end(), y->begin());
+        f->update();
+
+        auto points = std::make_shared<std::vector<Real> >(lookups);
+        MersenneTwisterUniformRng rng(42);
+        for (Size i=0; i<lookups; ++i)
+            (*points)[i] = rng.nextReal() * x->back();
+
+        return [x, y, f, points]() {
+            Real sum = 0.0;
+            for (Real p : *points)
+                sum += (*f)(p);
+            if (sum > 1.0e10)
+                std::cout << sum << std::endl;
+        };
+    }
+
+    // calibration: a Heston model on 40 options
+    std::function<void()> hestonCalibration(Size) {
+        Date today(15, January, 2020);
+        Settings::instance().evaluationDate() = today;
+        DayCounter dc = Actual365Fixed();
+        Calendar calendar = TARGET();
+
+        Handle<YieldTermStructure> riskFree(
+            std::make_shared<FlatForward>(today, 0.02, dc));
+        Handle<YieldTermStructure> dividends(
+            std::make_shared<FlatForward>(today, 0.01, dc));
+        Handle<Quote> spot(std::make_shared<SimpleQuote>(100.0));
+
+        auto model = std::make_shared<HestonModel>(
+            std::make_shared<HestonProcess>(riskFree, dividends, spot,
+                                            0.1, 1.0, 0.1, 0.5, -0.5));
+        auto engine = std::make_shared<AnalyticHestonEngine>(model, 64);
+
+        auto helpers =
+            std::make_shared<std::vector<std::shared_ptr<CalibrationHelper> > >();
+        Integer months[] = { 3, 6, 12, 24, 60 };
+        for (Integer m : months) {
+            for (Size k=0; k<8; ++k) {
+                Real strike = 70.0 + 8.0*k;
+                Real moneyness = std::log(strike/100.0);
+                Volatility vol = 0.20 - 0.10*moneyness
+                    + 0.05*moneyness*moneyness*12.0/m;
+                auto helper = std::make_shared<HestonModelHelper>(
+                    m*Months, calendar, spot, strike,
+                    Handle<Quote>(std::make_shared<SimpleQuote>(vol)),
+                    riskFree, dividends,
+                    CalibrationHelper::ImpliedVolError);
+                helper->setPricingEngine(engine);
+                helpers->push_back(helper);
+            }
+        }
+        Array guess = model->params();
+
+        return [model, helpers, guess]() {
+            model->setParams(guess);
+            LevenbergMarquardt om(1e-8, 1e-8, 1e-8);
+            model->calibrate(*helpers, om,
+                             EndCriteria(400, 40, 1.0e-8, 1.0e-8, 1.0e-8));
+        };
+    }
+
+    // credit loss model: the equity tranche of a homogeneous pool of
+    // 125 names; the correlation is changed at each iteration so that
+    // the conditional loss distributions are recalculated
+    template <class LossModel>
+    std::function<void()> trancheLoss(Size) {
+        Date today(31, August, 2006);
+        Settings::instance().evaluationDate() = today;
+
+        const Size poolSize = 125;
+        auto pool = std::make_shared<Pool>();
+        std::vector<std::string> names;
+        auto hazardRate = std::make_shared<FlatHazardRate>(
+            today, Handle<Quote>(std::make_shared<SimpleQuote>(0.01)),
+            ActualActual());
+        for (Size i=0; i<poolSize; ++i) {
+            std::ostringstream name;
+            name << "issuer-" << i;
+            names.push_back(name.str());
+            std::vector<std::pair<DefaultProbKey,
+                        Handle<DefaultProbabilityTermStructure> > > curves(
+                1, std::make_pair(
+                       NorthAmericaCorpDefaultKey(EURCurrency(), SeniorSec,
+                                                  Period(0, Weeks), 10.),
+                       Handle<DefaultProbabilityTermStructure>(hazardRate)));
+            pool->add(names.back(), Issuer(curves),
+                      NorthAmericaCorpDefaultKey(EURCurrency(), SeniorSec,
+                                                 Period(), 1.));
+        }
+
+        auto correlation = std::make_shared<SimpleQuote>(0.3);
+        auto latentModel = std::make_shared<GaussianConstantLossLM>(
+            Handle<Quote>(correlation), std::vector<Real>(poolSize, 0.4),
+            LatentModelIntegrationType::GaussianQuadrature, poolSize,
+            GaussianCopulaPolicy::initTraits());
+        auto basket = std::make_shared<Basket>(
+            today, names, std::vector<Real>(poolSize, 100.0), pool,
+            0.0, 0.03);
+        basket->setLossModel(std::make_shared<LossModel>(latentModel));
+        Date maturity = today + 5*Years;
+
+        return [basket, correlation, maturity]() {
+            correlation->setValue(correlation->value() == 0.3 ? 0.31 : 0.3);
+            Real loss = basket->expectedTrancheLoss(maturity);
+            if (loss < 0.0)
+                std::cout << loss << std::endl;
+        };
+    }
+
+    // dense linear algebra on 400x400 matrices
+    const Size linearAlgebraSize = 400;
+
+    std::shared_ptr<Matrix> randomMatrix(Size n, bool positiveDefinite) {
+        MersenneTwisterUniformRng rng(42);
+        Matrix a(n, n);
+        for (Real& x : a)
+            x = rng.nextReal() - 0.5;
+        if (!positiveDefinite)
+            return std::make_shared<Matrix>(a);
+        auto s = std::make_shared<Matrix>(a*transpose(a));
+        for (Size i=0; i<n; ++i)
+            (*s)[i][i] += 1.0;
+        return s;
+    }
+
+    std::function<void()> matrixMultiplication(Size threads) {
+        auto a = randomMatrix(linearAlgebraSize, false);
+        return [a, threads]() {
+            Matrix c = matrixProduct(*a, *a, threads);
+            if (c[0][0] > 1.0e10)
+                std::cout << c[0][0] << std::endl;
+        };
+    }
+
+    std::function<void()> referenceMatrixMultiplication(Size) {
+        auto a = randomMatrix(linearAlgebraSize, false);
+        return [a]() {
+            const Size n = a->rows();
+            Matrix c(n, n, 0.0);
+            for (Size i=0; i<n; ++i)
+                for (Size k=0; k<n; ++k)
+                    for (Size j=0; j<n; ++j)
+                        c[i][j] += (*a)[i][k] * (*a)[k][j];
+            if (c[0][0] > 1.0e10)
+                std::cout << c[0][0] << std::endl;
+        };
+    }
+
+    std::function<void()> luInverse(Size threads) {
+        auto a = randomMatrix(linearAlgebraSize, false);
+        return [a, threads]() {
+            Matrix lu(*a);
+            std::vector<Size> pivots;
+            luDecomposition(lu, pivots, threads);
+            Matrix inv(a->rows(), a->rows(), 0.0);
+            for (Size i=0; i<a->rows(); ++i)
+                inv[i][i] = 1.0;
+            luSolve(lu, pivots, inv, threads);
+        };
+    }
+
+    std::function<void()> cholesky(Size threads) {
+        auto s = randomMatrix(linearAlgebraSize, true);
+        return [s, threads]() {
+            Matrix l(*s);
+            choleskyFactorization(l, false, threads);
+        };
+    }
+
+    std::function<void()> referenceCholesky(Size) {
+        auto s = randomMatrix(linearAlgebraSize, true);
+        return [s]() {
+            const Size n = s->rows();
+            Matrix l(n, n, 0.0);
+            for (Size i=0; i<n; ++i) {
+                for (Size j=i; j<n; ++j) {
+                    Real sum = (*s)[i][j];
+                    for (Size k=0; k<i; ++k)
+                        sum -= l[i][k]*l[j][k];
+                    l[j][i] = (i == j) ? std::sqrt(sum) : sum/l[i][i];
+                }
+            }
+        };
+    }
+
+    std::vector<Kernel> kernels() {
+        std::vector<Kernel> k;
+        k.push_back({ "curve/bootstrap", false, curveBootstrap });
+        k.push_back({ "fd/rollback", false, fdRollback });
+        k.push_back({ "lattice/rollback", false, latticeRollback });
+        k.push_back({ "lattice/pricing", false, latticePricing });
+        k.push_back({ "mc/path-generation", false, mcPathGeneration });
+        k.push_back({ "mc/european", true, mcEuropean });
+        k.push_back({ "interpolation/linear-lookup", false,
+                      interpolationLookup<LinearInterpolation> });
+        k.push_back({ "interpolation/cubic-lookup", false,
+                      interpolationLookup<CubicNaturalSpline> });
+        k.push_back({ "calibration/heston", false, hestonCalibration });
+        k.push_back({ "credit/fft-loss", false,
+                      trancheLoss<FFTGaussLossModel> });
+        k.push_back({ "credit/recursive-loss", false,
+                      trancheLoss<RecursiveGaussLossModel> });
+        k.push_back({ "linalg/product", true, matrixMultiplication });
+        k.push_back({ "linalg/product-reference", false,
+                      referenceMatrixMultiplication });
+        k.push_back({ "linalg/lu-inverse", true, luInverse });
+        k.push_back({ "linalg/cholesky", true, cholesky });
+        k.push_back({ "linalg/cholesky-reference", false,
+                      referenceCholesky });
+        return k;
+    }
+
+
+    Result run(const Kernel& kernel, Size threads,
+               Size warmup, Size repetitions) {
+        std::function<void()> f = kernel.setup(threads);
+        for (Size i=0; i<warmup; ++i)
+            f();
+
+        std::vector<double> times(repetitions);
+        unsigned long allocationsBefore = allocationCount.load();
+        for (Size i=0; i<repetitions; ++i) {
+            auto start = std::chrono::steady_clock::now();
+            f();
+            times[i] = std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - start).count();
+        }
+        unsigned long allocated = allocationCount.load() - allocationsBefore;
+
+        Result r;
+        r.name = kernel.name;
+        r.threads = threads;
+        r.repetitions = repetitions;
+        r.allocations = double(allocated) / repetitions;
+        r.mean = 0.0;
+        for (double t : times)
+            r.mean += t;
+        r.mean /= repetitions;
+        std::sort(times.begin(), times.end());
+        r.min = times.front();
+        r.median = (repetitions % 2 == 1) ?
+            times[repetitions/2] :
+            0.5*(times[repetitions/2-1] + times[repetitions/2]);
+        Size p95 = static_cast<Size>(std::ceil(0.95*repetitions));
+        r.p95 = times[std::max<Size>(p95, 1) - 1];
+        return r;
+    }
+
+    void writeCsv(const std::vector<Result>& results,
+                  const std::string& fileName) {
+        std::ofstream out(fileName.c_str());
+        QL_REQUIRE(out, "unable to open " << fileName);
+        out << "kernel,threads,repetitions,median,p95,mean,min,allocations\n"
+            << std::setprecision(9);
+        for (const Result& r : results)
+            out << r.name << "," << r.threads << "," << r.repetitions << ","
+                << r.median << "," << r.p95 << "," << r.mean << ","
+                << r.min << "," << r.allocations << "\n";
+    }
+
+    void writeJson(const std::vector<Result>& results,
+                   Size warmup, const std::string& fileName) {
+        std::ofstream out(fileName.c_str());
+        QL_REQUIRE(out, "unable to open " << fileName);
+        out << "{\n"
+            << "  \"version\": \"" << QL_VERSION << "\",\n"
+            << "  \"warmup\": " << warmup << ",\n"
+            << "  \"unit\": \"seconds\",\n"
+            << "  \"results\": [\n"
+            << std::setprecision(9);
+        for (Size i=0; i<results.size(); ++i) {
+            const Result& r = results[i];
+            out << "    { \"kernel\": \"" << r.name << "\""
+                << ", \"threads\": " << r.threads
+                << ", \"repetitions\": " << r.repetitions
+                << ", \"median\": " << r.median
+                << ", \"p95\": " << r.p95
+                << ", \"mean\": " << r.mean
+                << ", \"min\": " << r.min
+                << ", \"allocations\": " << r.allocations
+                << " }" << (i+1 < results.size() ? "," : "") << "\n";
+        }
+        out << "  ]\n"
+            << "}\n";
+    }
+
+    // medians by kernel and number of threads
+    std::map<std::string, double> readBaseline(const std::string& fileName) {
+        std::ifstream in(fileName.c_str());
+        QL_REQUIRE(in, "unable to open " << fileName);
+        std::map<std::string, double> medians;
+        std::string line;
+        std::getline(in, line); // header
+        while (std::getline(in, line)) {
+            if (line.empty())
+                continue;
+            std::vector<std::string> fields;
+            std::istringstream fs(line);
+            std::string field;
+            while (std::getline(fs, field, ','))
+                fields.push_back(field);
+            QL_REQUIRE(fields.size() >= 4,
+                       "invalid line in " << fileName << ": " << line);
+            medians[fields[0] + "@" + fields[1]] = std::stod(fields[3]);
+        }
+        return medians;
+    }
+
+    std::vector<Size> parseThreads(const std::string& s) {
+        std::vector<Size> threads;
+        std::istringstream in(s);
+        std::string item;
+        while (std::getline(in, item, ',')) {
+            int n = std::stoi(item);
+            QL_REQUIRE(n > 0, "invalid number of threads: " << item);
+            threads.push_back(Size(n));
+        }
+        QL_REQUIRE(!threads.empty(), "no thread count given");
+        return threads;
+    }
+
+    void usage() {
+        std::cerr << "usage: quantlib-kernel-benchmark"
+                  << " [--repetitions=N] [--warmup=N] [--threads=N,...]\n"
+                  << "       [--filter=TEXT] [--json=FILE] [--csv=FILE]"
+                  << " [--baseline=FILE] [--tolerance=X] [--list]"
+                  << std::endl;
+    }
+
+}
+
+#if defined(QL_ENABLE_SESSIONS)
+namespace QuantLib {
+    Integer sessionId() { return 0; }
+}
+#endif
+
+int main(int argc, char* argv[]) {
+
+    try {
+        Size repetitions = 10, warmup = 2;
+        std::vector<Size> threadCounts(1, 1);
+        std::string filter, jsonFile, csvFile, baselineFile;
+        double tolerance = 0.10;
+        bool list = false;
+
+        for (int i=1; i<argc; ++i) {
+            std::string arg(argv[i]);
+            std::string::size_type eq = arg.find('=');
+            std::string key = arg.substr(0, eq);
+            std::string value =
+                eq == std::string::npos ? std::string() : arg.substr(eq+1);
+            if (key == "--repetitions") {
+                repetitions = std::stoul(value);
+                QL_REQUIRE(repetitions > 0, "no repetitions given");
+            } else if (key == "--warmup") {
+                warmup = std::stoul(value);
+            } else if (key == "--threads") {
+                threadCounts = parseThreads(value);
+            } else if (key == "--filter") {
+                filter = value;
+            } else if (key == "--json") {
+                jsonFile = value;
+            } else if (key == "--csv") {
+                csvFile = value;
+            } else if (key == "--baseline") {
+                baselineFile = value;
+            } else if (key == "--tolerance") {
+                tolerance = std::stod(value);
+            } else if (key == "--list") {
+                list = true;
+            } else {
+                usage();
+                return 1;
+            }
+        }
+
+        std::vector<Kernel> all = kernels();
+        if (list) {
+            for (const Kernel& k : all)
+                std::cout << k.name << (k.threaded ? " (threaded)" : "")
+                          << std::endl;
+            return 0;
+        }
+
+        std::map<std::string, double> baseline;
+        if (!baselineFile.empty())
+            baseline = readBaseline(baselineFile);
+
+        std::cout << std::string(100, '-') << std::endl
+                  << "Kernel benchmark, QuantLib " QL_VERSION
+                  << " (" << repetitions << " repetitions, "
+                  << warmup << " warm-up)" << std::endl
+                  << std::string(100, '-') << std::endl
+                  << std::left << std::setw(30) << "kernel"
+                  << std::right << std::setw(8) << "threads"
+                  << std::setw(12) << "median [s]"
+                  << std::setw(12) << "p95 [s]"
+                  << std::setw(12) << "min [s]"
+                  << std::setw(12) << "allocs"
+                  << std::setw(10) << "scaling";
+        if (!baseline.empty())
+            std::cout << std::setw(12) << "vs baseline";
+        std::cout << std::endl;
+
+        std::vector<Result> results;
+        Size regressions = 0;
+        for (const Kernel& k : all) {
+            if (k.name.find(filter) == std::string::npos)
+                continue;
+            std::vector<Size> threads =
+                k.threaded ? threadCounts : std::vector<Size>(1, 1);
+            double reference = 0.0;
+            for (Size t : threads) {
+                Result r = run(k, t, warmup, repetitions);
+                results.push_back(r);
+                if (reference == 0.0)
+                    reference = r.median;
+
+                std::cout << std::left << std::setw(30) << r.name
+                          << std::right << std::setw(8) << r.threads
+                          << std::fixed << std::setprecision(6)
+                          << std::setw(12) << r.median
+                          << std::setw(12) << r.p95
+                          << std::setw(12) << r.min
+                          << std::setprecision(0)
+                          << std::setw(12) << r.allocations
+                          << std::setprecision(2)
+                          << std::setw(9) << reference/r.median << "x";
+                if (!baseline.empty()) {
+                    std::map<std::string, double>::const_iterator b =
+                        baseline.find(r.key());
+                    if (b == baseline.end()) {
+                        std::cout << std::setw(12) << "n/a";
+                    } else {
+                        double change = r.median/b->second - 1.0;
+                        std::cout << std::setw(11) << std::showpos
+                                  << 100.0*change << "%" << std::noshowpos;
+                        if (change > tolerance) {
+                            std::cout << "  REGRESSION";
+                            ++regressions;
+                        }
+                    }
+                }
+                std::cout << std::endl;
+            }
+        }
+        std::cout << std::string(100, '-') << std::endl;
+
+        if (!csvFile.empty())
+            writeCsv(results, csvFile);
+        if (!jsonFile.empty())
+            writeJson(results, warmup, jsonFile);
+
+        if (regressions > 0) {
+            std::cout << regressions << " kernel(s) slower than baseline"
+                      << " by more than " << 100.0*tolerance << "%"
+                      << std::endl;
+            return 2;
+        }
+        return 0;
+
+    } catch (std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    } catch (...) {
+        std::cerr << "unknown error" << std::endl;
+        return 1;
+    }
+}
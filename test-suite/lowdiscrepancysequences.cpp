@@ -1091,3 +1091,79 @@ TEST_CASE("LowDiscrepancy_SobolSkipping", "[LowDiscrepancy]") {
       }
     }
 }
+
+TEST_CASE("LowDiscrepancy_SobolBlocks", "[LowDiscrepancy]") {
+
+    INFO("Testing Sobol sequence generation in blocks...");
+
+    unsigned long seed = 42;
+    Size dimensionality[] = { 1, 10, 100, 1000 };
+    SobolRsg::DirectionIntegers integers[] = { SobolRsg::Unit,
+                                               SobolRsg::Jaeckel,
+                                               SobolRsg::JoeKuoD7 };
+    const Size points = 1000, slices = 4;
+
+    for (Size i=0; i<LENGTH(integers); i++) {
+        for (Size j=0; j<LENGTH(dimensionality); j++) {
+            Size d = dimensionality[j];
+
+            // draw the points one by one, and then in two blocks
+            SobolRsg rsg1(d, seed, integers[i]);
+            SobolRsg rsg2(d, seed, integers[i]);
+            std::vector<unsigned long> first, second;
+            rsg2.nextInt32Block(points/3, first);
+            rsg2.nextInt32Block(points - points/3, second);
+            first.insert(first.end(), second.begin(), second.end());
+            for (Size m=0; m<points; m++) {
+                const std::vector<unsigned long>& s1 =
+                    rsg1.nextInt32Sequence();
+                for (Size n=0; n<d; n++) {
+                    if (s1[n] != first[m*d+n]) {
+                        FAIL("Mismatch in block:"
+                             << "\n  size:     " << d
+                             << "\n  integers: " << integers[i]
+                             << "\n  point:    " << m
+                             << "\n  at index: " << n
+                             << "\n  expected: " << s1[n]
+                             << "\n  found:    " << first[m*d+n]);
+                    }
+                }
+            }
+
+            // the generators must be left in the same state
+            const SobolRsg::sample_type& s1 = rsg1.nextSequence();
+            const SobolRsg::sample_type& s2 = rsg2.nextSequence();
+            for (Size n=0; n<d; n++) {
+                if (s1.value[n] != s2.value[n])
+                    FAIL("Mismatch after block:"
+                         << "\n  size:     " << d
+                         << "\n  integers: " << integers[i]
+                         << "\n  at index: " << n
+                         << "\n  expected: " << s1.value[n]
+                         << "\n  found:    " << s2.value[n]);
+            }
+
+            // disjoint slices drawn after skipping must match the
+            // corresponding points of the whole block
+            SobolRsg rsg3(d, seed, integers[i]);
+            std::vector<Real> whole, slice;
+            rsg3.nextBlock(points, whole);
+            for (Size l=0; l<slices; l++) {
+                SobolRsg rsg4(d, seed, integers[i]);
+                rsg4.skipTo(l*points/slices);
+                rsg4.nextBlock(points/slices, slice);
+                for (Size n=0; n<slice.size(); n++) {
+                    Real expected = whole[l*(points/slices)*d+n];
+                    if (slice[n] != expected)
+                        FAIL("Mismatch in slice:"
+                             << "\n  size:     " << d
+                             << "\n  integers: " << integers[i]
+                             << "\n  slice:    " << l
+                             << "\n  at index: " << n
+                             << "\n  expected: " << expected
+                             << "\n  found:    " << slice[n]);
+                }
+            }
+        }
+    }
+}
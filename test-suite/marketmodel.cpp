@@ -41,6 +41,7 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #include <ql/models/marketmodels/evolvers/lognormalfwdrateipc.hpp>
 #include <ql/models/marketmodels/evolvers/lognormalfwdrateballand.hpp>
 #include <ql/models/marketmodels/evolvers/lognormalfwdratepc.hpp>
+#include <ql/models/marketmodels/evolvers/batchlognormalfwdratepc.hpp>
 #include <ql/models/marketmodels/evolvers/normalfwdratepc.hpp>
 #include <ql/models/marketmodels/discounter.hpp>
 #include <ql/models/marketmodels/models/abcdvol.hpp>
@@ -1597,6 +1598,311 @@ TEST_CASE("MarketModel_CallableSwapNaif", "[MarketModel]") {
     }
 }
 
+TEST_CASE("MarketModel_BatchEvolver", "[MarketModel]") {
+
+    INFO("Testing batch evolution of LIBOR market model paths...");
+
+    setup();
+
+    Real fixedRate = 0.04;
+    MultiStepSwap payerSwap(rateTimes, accruals, accruals, paymentTimes,
+                            fixedRate, true);
+    MultiStepSwap receiverSwap(rateTimes, accruals, accruals, paymentTimes,
+                               fixedRate, false);
+    std::vector<Rate> exerciseTimes(rateTimes);
+    exerciseTimes.pop_back();
+    std::vector<Rate> swapTriggers(exerciseTimes.size(), fixedRate);
+    SwapRateTrigger naifStrategy(rateTimes, swapTriggers, exerciseTimes);
+    NothingExerciseValue nullRebate(rateTimes);
+
+    // callable products terminate at different steps on each path
+    MultiProductComposite allProducts;
+    allProducts.add(payerSwap);
+    allProducts.add(receiverSwap);
+    allProducts.add(CallSpecifiedMultiProduct(MultiStepNothing(
+                                                  payerSwap.evolution()),
+                                              naifStrategy, payerSwap));
+    allProducts.add(CallSpecifiedMultiProduct(receiverSwap, naifStrategy,
+                                              ExerciseAdapter(nullRebate)));
+    allProducts.finalize();
+    EvolutionDescription evolution = allProducts.evolution();
+
+    // the last batch is incomplete
+    Size paths = 1000, batchSize = 64;
+
+    MarketModelType marketModels[] = {
+            ExponentialCorrelationFlatVolatility,
+            ExponentialCorrelationAbcdVolatility};
+    MeasureType measures[] = { MoneyMarket, MoneyMarketPlus, Terminal };
+    for (Size j = 0; j < LENGTH(marketModels); j++) {
+        Size testedFactors[] = {3, todaysForwards.size()};
+        for (Size m = 0; m < LENGTH(testedFactors); ++m) {
+            std::shared_ptr<MarketModel> marketModel =
+                makeMarketModel(true, evolution, testedFactors[m],
+                                marketModels[j]);
+            for (Size k = 0; k < LENGTH(measures); k++) {
+                std::vector<Size> numeraires =
+                    makeMeasure(allProducts, measures[k]);
+                Real initialNumeraireValue =
+                    todaysDiscounts[numeraires.front()];
+                MTBrownianGeneratorFactory generatorFactory(seed_);
+
+                AccountingEngine engine(
+                    std::make_shared<LogNormalFwdRatePc>(
+                        marketModel, generatorFactory, numeraires),
+                    allProducts, initialNumeraireValue);
+                SequenceStatisticsInc stats(allProducts.numberOfProducts());
+                engine.multiplePathValues(stats, paths);
+
+                AccountingEngine batchEngine(
+                    std::make_shared<BatchLogNormalFwdRatePc>(
+                        marketModel, generatorFactory, numeraires,
+                        batchSize),
+                    allProducts, initialNumeraireValue);
+                SequenceStatisticsInc batchStats(
+                                         allProducts.numberOfProducts());
+                batchEngine.multiplePathValues(batchStats, paths);
+
+                std::vector<Real> values = stats.mean(),
+                    batchValues = batchStats.mean();
+                for (Size i = 0; i < values.size(); ++i) {
+                    if (std::fabs(values[i] - batchValues[i]) > 1.0e-14)
+                        FAIL_CHECK("batch evolution mismatch:"
+                                   << "\n    market model: "
+                                   << marketModelTypeToString(marketModels[j])
+                                   << "\n    factors:      "
+                                   << testedFactors[m]
+                                   << "\n    measure:      "
+                                   << measureTypeToString(measures[k])
+                                   << "\n    product:      " << i
+                                   << std::setprecision(16)
+                                   << "\n    path by path: " << values[i]
+                                   << "\n    batch:        "
+                                   << batchValues[i]);
+                }
+                if (stats.samples() != batchStats.samples())
+                    FAIL_CHECK("batch evolution sample count mismatch");
+            }
+        }
+    }
+}
+
+TEST_CASE("MarketModel_ParallelAccountingEngines", "[MarketModel]") {
+
+    INFO("Testing multi-threaded accounting engines...");
+
+    setup();
+
+    Real fixedRate = 0.04;
+    MultiStepSwap payerSwap(rateTimes, accruals, accruals, paymentTimes,
+                            fixedRate, true);
+    std::vector<Rate> exerciseTimes(rateTimes);
+    exerciseTimes.pop_back();
+    std::vector<Rate> swapTriggers(exerciseTimes.size(), fixedRate);
+    SwapRateTrigger naifStrategy(rateTimes, swapTriggers, exerciseTimes);
+
+    MultiProductComposite allProducts;
+    allProducts.add(payerSwap);
+    allProducts.add(CallSpecifiedMultiProduct(MultiStepNothing(
+                                                  payerSwap.evolution()),
+                                              naifStrategy, payerSwap));
+    allProducts.finalize();
+
+    MarketModelPathwiseMultiCaplet caplets(rateTimes, accruals,
+                                           paymentTimes, todaysForwards);
+
+    // the paths are not evenly divisible among workers
+    Size paths = 1000, workers = 3;
+
+    std::shared_ptr<MarketModel> marketModel =
+        makeMarketModel(true, allProducts.evolution(), 3,
+                        ExponentialCorrelationAbcdVolatility);
+    std::vector<Size> numeraires = moneyMarketMeasure(allProducts.evolution());
+    Real initialNumeraireValue = todaysDiscounts[numeraires.front()];
+
+    // each worker draws from its own generator; results must equal
+    // those of sequential engines running each worker's share of paths
+    std::vector<std::shared_ptr<MarketModelEvolver> > evolvers;
+    std::vector<std::shared_ptr<LogNormalFwdRateEuler> > eulerEvolvers;
+    SequenceStatisticsInc expected, expectedPathwise;
+    for (Size w = 0; w < workers; ++w) {
+        MTBrownianGeneratorFactory generatorFactory(seed_ + w);
+        Size workerPaths = (w+1)*paths/workers - w*paths/workers;
+
+        evolvers.push_back(std::make_shared<LogNormalFwdRatePc>(
+                               marketModel, generatorFactory, numeraires));
+        AccountingEngine engine(
+            std::make_shared<LogNormalFwdRatePc>(
+                marketModel, generatorFactory, numeraires),
+            allProducts, initialNumeraireValue);
+        engine.multiplePathValues(expected, workerPaths);
+
+        eulerEvolvers.push_back(std::make_shared<LogNormalFwdRateEuler>(
+                               marketModel, generatorFactory, numeraires));
+        PathwiseAccountingEngine pathwiseEngine(
+            std::make_shared<LogNormalFwdRateEuler>(
+                marketModel, generatorFactory, numeraires),
+            caplets, marketModel, initialNumeraireValue);
+        pathwiseEngine.multiplePathValues(expectedPathwise, workerPaths);
+    }
+
+    AccountingEngine engine(evolvers, allProducts, initialNumeraireValue);
+    SequenceStatisticsInc stats;
+    engine.multiplePathValues(stats, paths);
+
+    PathwiseAccountingEngine pathwiseEngine(eulerEvolvers, caplets,
+                                            marketModel,
+                                            initialNumeraireValue);
+    SequenceStatisticsInc pathwiseStats;
+    pathwiseEngine.multiplePathValues(pathwiseStats, paths);
+
+    if (stats.samples() != paths || pathwiseStats.samples() != paths)
+        FAIL_CHECK("sample count mismatch:"
+                   << "\n    expected: " << paths
+                   << "\n    values:   " << stats.samples()
+                   << "\n    pathwise: " << pathwiseStats.samples());
+
+    std::vector<Real> values = stats.mean(),
+        expectedValues = expected.mean();
+    for (Size i = 0; i < values.size(); ++i) {
+        if (values[i] != expectedValues[i])
+            FAIL_CHECK("multi-threaded value mismatch:"
+                       << "\n    product:    " << i
+                       << std::setprecision(16)
+                       << "\n    sequential: " << expectedValues[i]
+                       << "\n    threaded:   " << values[i]);
+    }
+
+    std::vector<Real> deltas = pathwiseStats.mean(),
+        expectedDeltas = expectedPathwise.mean();
+    for (Size i = 0; i < deltas.size(); ++i) {
+        if (deltas[i] != expectedDeltas[i])
+            FAIL_CHECK("multi-threaded pathwise mismatch:"
+                       << "\n    index:      " << i
+                       << std::setprecision(16)
+                       << "\n    sequential: " << expectedDeltas[i]
+                       << "\n    threaded:   " << deltas[i]);
+    }
+}
+
+TEST_CASE("MarketModel_ParallelPathwiseVegas", "[MarketModel]") {
+
+    INFO("Testing multi-threaded pathwise vega accounting engines...");
+
+    setup();
+
+    MarketModelPathwiseMultiCaplet caplets(rateTimes, accruals,
+                                           paymentTimes, todaysForwards);
+    const EvolutionDescription& evolution = caplets.evolution();
+
+    // the paths are not evenly divisible among workers
+    Size paths = 500, workers = 3, factors = 2;
+
+    std::shared_ptr<MarketModel> marketModel =
+        makeMarketModel(true, evolution, factors,
+                        ExponentialCorrelationAbcdVolatility);
+    std::vector<Size> numeraires = moneyMarketMeasure(evolution);
+    Real initialNumeraireValue = todaysDiscounts[numeraires.front()];
+
+    // one bump per rate and step on the first factor
+    std::vector<std::vector<Matrix> > vegaBumps(evolution.numberOfSteps());
+    for (Size l = 0; l < evolution.numberOfSteps(); ++l) {
+        for (Size k = 0; k < evolution.numberOfRates(); ++k) {
+            Matrix bump(evolution.numberOfRates(), factors, 0.0);
+            if (k >= l)
+                bump[k][0] = 0.01;
+            vegaBumps[l].push_back(bump);
+        }
+    }
+
+    // each worker draws from its own generator; results must equal the
+    // path-weighted means of sequential engines running each worker's
+    // share of paths
+    std::vector<std::shared_ptr<LogNormalFwdRateEuler> > evolvers,
+        outerEvolvers;
+    std::vector<Real> expected, expectedOuter;
+    for (Size w = 0; w < workers; ++w) {
+        MTBrownianGeneratorFactory generatorFactory(seed_ + w);
+        Size workerPaths = (w+1)*paths/workers - w*paths/workers;
+
+        evolvers.push_back(std::make_shared<LogNormalFwdRateEuler>(
+                               marketModel, generatorFactory, numeraires));
+        outerEvolvers.push_back(std::make_shared<LogNormalFwdRateEuler>(
+                               marketModel, generatorFactory, numeraires));
+
+        std::vector<Real> means, errors;
+        PathwiseVegasAccountingEngine engine(
+            std::make_shared<LogNormalFwdRateEuler>(
+                marketModel, generatorFactory, numeraires),
+            caplets, marketModel, vegaBumps, initialNumeraireValue);
+        engine.multiplePathValues(means, errors, workerPaths);
+        expected.resize(means.size(), 0.0);
+        for (Size i = 0; i < means.size(); ++i)
+            expected[i] += means[i]*workerPaths/paths;
+
+        PathwiseVegasOuterAccountingEngine outerEngine(
+            std::make_shared<LogNormalFwdRateEuler>(
+                marketModel, generatorFactory, numeraires),
+            caplets, marketModel, vegaBumps, initialNumeraireValue);
+        outerEngine.multiplePathValues(means, errors, workerPaths);
+        expectedOuter.resize(means.size(), 0.0);
+        for (Size i = 0; i < means.size(); ++i)
+            expectedOuter[i] += means[i]*workerPaths/paths;
+    }
+
+    std::vector<Real> values, outerValues, errors;
+    PathwiseVegasAccountingEngine engine(evolvers, caplets, marketModel,
+                                         vegaBumps, initialNumeraireValue);
+    engine.multiplePathValues(values, errors, paths);
+    PathwiseVegasOuterAccountingEngine outerEngine(outerEvolvers, caplets,
+                                                   marketModel, vegaBumps,
+                                                   initialNumeraireValue);
+    outerEngine.multiplePathValues(outerValues, errors, paths);
+
+    Real tolerance = 1.0e-12;
+    REQUIRE(values.size() == expected.size());
+    for (Size i = 0; i < values.size(); ++i) {
+        if (std::fabs(values[i] - expected[i]) > tolerance)
+            FAIL_CHECK("multi-threaded pathwise vega mismatch:"
+                       << "\n    index:      " << i
+                       << std::setprecision(16)
+                       << "\n    sequential: " << expected[i]
+                       << "\n    threaded:   " << values[i]);
+    }
+    REQUIRE(outerValues.size() == expectedOuter.size());
+    for (Size i = 0; i < outerValues.size(); ++i) {
+        if (std::fabs(outerValues[i] - expectedOuter[i]) > tolerance)
+            FAIL_CHECK("multi-threaded outer pathwise vega mismatch:"
+                       << "\n    index:      " << i
+                       << std::setprecision(16)
+                       << "\n    sequential: " << expectedOuter[i]
+                       << "\n    threaded:   " << outerValues[i]);
+    }
+
+    // a single worker runs the same paths as the sequential engine
+    MTBrownianGeneratorFactory generatorFactory(seed_);
+    std::vector<Real> sequential, single;
+    PathwiseVegasAccountingEngine sequentialEngine(
+        std::make_shared<LogNormalFwdRateEuler>(
+            marketModel, generatorFactory, numeraires),
+        caplets, marketModel, vegaBumps, initialNumeraireValue);
+    sequentialEngine.multiplePathValues(sequential, errors, paths);
+    PathwiseVegasAccountingEngine singleEngine(
+        std::vector<std::shared_ptr<LogNormalFwdRateEuler> >(
+            1, std::make_shared<LogNormalFwdRateEuler>(
+                   marketModel, generatorFactory, numeraires)),
+        caplets, marketModel, vegaBumps, initialNumeraireValue);
+    singleEngine.multiplePathValues(single, errors, paths);
+    for (Size i = 0; i < single.size(); ++i) {
+        if (single[i] != sequential[i])
+            FAIL_CHECK("single-worker pathwise vega mismatch:"
+                       << "\n    index:      " << i
+                       << std::setprecision(16)
+                       << "\n    sequential: " << sequential[i]
+                       << "\n    pool:       " << single[i]);
+    }
+}
+
 TEST_CASE("MarketModel_CallableSwapLS", "[MarketModel]") {
 
     INFO("Pricing callable swap with Longstaff-Schwartz exercise strategy in a LIBOR market model...");
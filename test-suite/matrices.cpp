@@ -23,6 +23,7 @@
 #include "utilities.hpp"
 #include <ql/math/matrix.hpp>
 #include <ql/math/matrixutilities/choleskydecomposition.hpp>
+#include <ql/math/matrixutilities/denselinearalgebra.hpp>
 #include <ql/math/matrixutilities/pseudosqrt.hpp>
 #include <ql/math/matrixutilities/svd.hpp>
 #include <ql/math/matrixutilities/symmetricschurdecomposition.hpp>
@@ -32,6 +33,7 @@
 #include <ql/experimental/math/moorepenroseinverse.hpp>
 
 #include <iostream>
+#include <numeric>
 
 using namespace QuantLib;
 
@@ -555,6 +557,87 @@ TEST_CASE("Matrices_CholeskyDecomposition", "[Matrices]") {
     }
 }
 
+TEST_CASE("Matrices_BlockedKernels", "[Matrices]") {
+
+    INFO("Testing blocked linear-algebra kernels...");
+
+    MersenneTwisterUniformRng rng(42);
+    const Size sizes[] = { 1, 7, 33, 65, 150, 270 };
+    const Size threads[] = { 1, 3 };
+
+    for (Size n : sizes) {
+        const Size k = n + 5, m = 2*n + 1;
+        Matrix a(n, k), b(k, m);
+        for (Matrix::iterator i = a.begin(); i != a.end(); ++i)
+            *i = rng.nextReal() - 0.5;
+        for (Matrix::iterator i = b.begin(); i != b.end(); ++i)
+            *i = rng.nextReal() - 0.5;
+
+        Matrix expected(n, m, 0.0);
+        for (Size i=0; i<n; ++i)
+            for (Size j=0; j<m; ++j)
+                for (Size l=0; l<k; ++l)
+                    expected[i][j] += a[i][l]*b[l][j];
+
+        Matrix square(n, n), spd(n, n);
+        for (Matrix::iterator i = square.begin(); i != square.end(); ++i)
+            *i = rng.nextReal() - 0.5;
+        for (Size i=0; i<n; ++i)
+            for (Size j=0; j<=i; ++j) {
+                spd[i][j] = std::inner_product(square.row_begin(i),
+                                               square.row_end(i),
+                                               square.row_begin(j), 0.0);
+                spd[j][i] = spd[i][j];
+            }
+        for (Size i=0; i<n; ++i)
+            spd[i][i] += 1.0;
+
+        Matrix eins(n, n, 0.0);
+        for (Size i=0; i<n; ++i)
+            eins[i][i] = 1.0;
+
+        for (Size t : threads) {
+            const Real tol = 1.0e-12*n;
+
+            const Matrix product = matrixProduct(a, b, t);
+            if (norm(product - expected) > tol)
+                FAIL_CHECK("blocked product failed for size " << n
+                           << " on " << t << " thread(s) (norm = "
+                           << norm(product - expected) << ")");
+
+            Matrix lu(square);
+            std::vector<Size> pivots;
+            const Real sign = luDecomposition(lu, pivots, t);
+            Matrix inv(eins);
+            luSolve(lu, pivots, inv, t);
+            if (sign == 0.0 || norm(square*inv - eins) > tol*1.0e2)
+                FAIL_CHECK("blocked LU inverse failed for size " << n
+                           << " on " << t << " thread(s) (norm = "
+                           << norm(square*inv - eins) << ")");
+
+            Matrix l(spd);
+            choleskyFactorization(l, false, t);
+            if (norm(l*transpose(l) - spd) > tol)
+                FAIL_CHECK("blocked Cholesky decomposition failed for size "
+                           << n << " on " << t << " thread(s) (norm = "
+                           << norm(l*transpose(l) - spd) << ")");
+            for (Size i=0; i<n; ++i)
+                for (Size j=i+1; j<n; ++j)
+                    if (l[i][j] != 0.0)
+                        FAIL("non-zero element above the diagonal of the "
+                             "Cholesky factor at (" << i << "," << j << ")");
+        }
+
+        // the determinant of the product is the product of determinants
+        const Real detA = determinant(square);
+        const Real detAA = determinant(square*square);
+        if (std::fabs(detAA - detA*detA) > 1.0e-10*detA*detA)
+            FAIL_CHECK("determinant of product failed for size " << n
+                       << "\n det(A)^2: " << detA*detA
+                       << "\n det(AA):  " << detAA);
+    }
+}
+
 TEST_CASE("Matrices_MoorePenroseInverse", "[Matrices]") {
     // this is taken from
     // http://de.mathworks.com/help/matlab/ref/pinv.html
@@ -24,7 +24,9 @@
 #include <ql/termstructures/yield/flatforward.hpp>
 #include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
 #include <ql/processes/stochasticprocessarray.hpp>
+#include <ql/methods/montecarlo/compactlongstaffschwartzpathpricer.hpp>
 #include <ql/methods/montecarlo/lsmbasissystem.hpp>
+#include <ql/methods/montecarlo/multipathgenerator.hpp>
 #include <ql/pricingengines/mclongstaffschwartzengine.hpp>
 #include <ql/pricingengines/vanilla/fdamericanengine.hpp>
 #include <ql/pricingengines/vanilla/mcamericanengine.hpp>
@@ -313,3 +315,84 @@ TEST_CASE("MCLongstaffSchwartzEngine_AmericanMaxOption", "[MCLongstaffSchwartzEn
         }
     }
 }
+
+TEST_CASE("MCLongstaffSchwartzEngine_CompactPathPricer", "[MCLongstaffSchwartzEngine]") {
+
+    INFO("Testing Longstaff-Schwartz path pricer with compact storage...");
+
+    SavedSettings backup;
+
+    const Date today(15, May, 1998);
+    Settings::instance().evaluationDate() = today;
+    const DayCounter dayCounter = Actual365Fixed();
+
+    std::shared_ptr<YieldTermStructure> riskFreeTS(
+        new FlatForward(today, 0.05, dayCounter));
+    Handle<YieldTermStructure> dividendTS(
+        std::shared_ptr<YieldTermStructure>(
+            new FlatForward(today, 0.10, dayCounter)));
+    Handle<BlackVolTermStructure> volTS(
+        std::shared_ptr<BlackVolTermStructure>(
+            new BlackConstantVol(today, NullCalendar(), 0.20, dayCounter)));
+
+    std::shared_ptr<StochasticProcess1D> stochasticProcess(
+        new GeneralizedBlackScholesProcess(
+            Handle<Quote>(std::shared_ptr<Quote>(new SimpleQuote(100.0))),
+            dividendTS, Handle<YieldTermStructure>(riskFreeTS), volTS));
+
+    Matrix corr(2, 2, 0.3);
+    corr[0][0] = corr[1][1] = 1.0;
+    std::shared_ptr<StochasticProcessArray> process(
+        new StochasticProcessArray(
+            std::vector<std::shared_ptr<StochasticProcess1D> >(
+                                                2, stochasticProcess),
+            corr));
+
+    const TimeGrid grid(3.0, 25);
+    std::shared_ptr<EarlyExercisePathPricer<MultiPath> > exercisePricer(
+        new AmericanMaxPathPricer(std::shared_ptr<Payoff>(
+            new PlainVanillaPayoff(Option::Call, 100.0))));
+
+    LongstaffSchwartzPathPricer<MultiPath> pricer(grid, exercisePricer,
+                                                  riskFreeTS);
+    CompactLongstaffSchwartzPathPricer<MultiPath> compactPricer(
+                                         grid, exercisePricer, riskFreeTS);
+
+    typedef PseudoRandom::rsg_type rsg_type;
+    // the number of paths is not a multiple of the block size
+    const Size calibrationPaths = 3000, pricingPaths = 2000;
+    MultiPathGenerator<rsg_type> generator(
+        process, grid,
+        PseudoRandom::make_sequence_generator(2*(grid.size()-1), 42));
+    for (Size i=0; i<calibrationPaths; ++i) {
+        const MultiPath& path = generator.next().value;
+        pricer(path);
+        compactPricer(path);
+    }
+    pricer.calibrate();
+    compactPricer.calibrate();
+
+    Real price = 0.0, compactPrice = 0.0;
+    for (Size i=0; i<pricingPaths; ++i) {
+        const MultiPath& path = generator.next().value;
+        price += pricer(path);
+        compactPrice += compactPricer(path);
+    }
+    price /= pricingPaths;
+    compactPrice /= pricingPaths;
+
+    const Real tolerance = 1.0e-8;
+    if (std::fabs(price - compactPrice) > tolerance)
+        FAIL_CHECK("Failed to reproduce Longstaff-Schwartz price"
+                   << std::setprecision(12)
+                   << "\n    path storage:    " << price
+                   << "\n    compact storage: " << compactPrice
+                   << "\n    tolerance:       " << tolerance);
+    if (std::fabs(pricer.exerciseProbability()
+                  - compactPricer.exerciseProbability()) > tolerance)
+        FAIL_CHECK("Failed to reproduce exercise probability"
+                   << "\n    path storage:    "
+                   << pricer.exerciseProbability()
+                   << "\n    compact storage: "
+                   << compactPricer.exerciseProbability());
+}
@@ -479,3 +479,76 @@ TEST_CASE("MersenneTwister_Values", "[MersenneTwister]") {
         FAIL("Detected interaction between Mersenne Twister instances "
                    "during parallel computation");
 }
+
+TEST_CASE("MersenneTwister_JumpAhead", "[MersenneTwister]") {
+
+    INFO("Testing Mersenne twister jump-ahead...");
+
+    // jumps must give the same numbers as the corresponding draws,
+    // whatever the position in the current block of the generator
+    Size drawn[] = { 0, 1, 623, 624, 1000 };
+    Size jumps[] = { 0, 1, 5, 9, 10, 14 };
+
+    for (Size i=0; i<LENGTH(drawn); i++) {
+        for (Size j=0; j<LENGTH(jumps); j++) {
+            MersenneTwisterUniformRng rng1(42), rng2(42);
+            for (Size l=0; l<drawn[i]; l++) {
+                rng1.nextInt32();
+                rng2.nextInt32();
+            }
+            Size steps = Size(1) << jumps[j];
+            for (Size l=0; l<steps; l++)
+                rng1.nextInt32();
+            rng2.jumpAhead(jumps[j]);
+            for (Size l=0; l<1000; l++) {
+                unsigned long expected = rng1.nextInt32();
+                unsigned long calculated = rng2.nextInt32();
+                if (calculated != expected)
+                    FAIL("Mismatch after jumping ahead:"
+                         << "\n  drawn:      " << drawn[i]
+                         << "\n  jump:       2^" << jumps[j]
+                         << "\n  draw:       " << l
+                         << "\n  expected:   " << expected
+                         << "\n  calculated: " << calculated);
+            }
+        }
+    }
+
+    // streams from the factory start at the expected positions
+    const Size log2Length = 8;
+    MersenneTwisterStreamFactory factory(42, log2Length);
+    MersenneTwisterUniformRng rng(42);
+    for (Size i=0; i<6; i++) {
+        MersenneTwisterUniformRng stream = factory.stream(i);
+        for (Size l=0; l<(Size(1) << log2Length); l++) {
+            unsigned long expected = rng.nextInt32();
+            unsigned long calculated = stream.nextInt32();
+            if (calculated != expected)
+                FAIL("Mismatch in stream " << i << ":"
+                     << "\n  draw:       " << l
+                     << "\n  expected:   " << expected
+                     << "\n  calculated: " << calculated);
+        }
+    }
+}
+
+TEST_CASE("MersenneTwister_Fill", "[MersenneTwister]") {
+
+    INFO("Testing Mersenne twister bulk generation...");
+
+    MersenneTwisterUniformRng rng1(42), rng2(42);
+    Size sizes[] = { 1, 10, 623, 624, 625, 5000 };
+    for (Size i=0; i<LENGTH(sizes); i++) {
+        std::vector<Real> block(sizes[i]);
+        rng2.fill(&block[0], block.size());
+        for (Size l=0; l<block.size(); l++) {
+            Real expected = rng1.nextReal();
+            if (block[l] != expected)
+                FAIL("Mismatch in bulk generation:"
+                     << "\n  block size: " << sizes[i]
+                     << "\n  index:      " << l
+                     << "\n  expected:   " << expected
+                     << "\n  calculated: " << block[l]);
+        }
+    }
+}
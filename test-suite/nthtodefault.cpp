@@ -385,3 +385,112 @@ TEST_CASE("NthToDefault_GaussStudent", "[.]") {
     }
     #endif
 }
+
+TEST_CASE("NthToDefault_RandomLatentModelSimulation", "[NthToDefault]") {
+    INFO("Testing multi-threaded random default latent model simulation...");
+
+    SavedSettings backup;
+
+    Size names = 20;
+    Size numSims = 20000;
+    Real recovery = 0.4;
+    Date asofDate(31, August, 2006);
+    Settings::instance().evaluationDate() = asofDate;
+    DayCounter dc = Actual365Fixed();
+
+    std::vector<std::string> namesIds;
+    std::shared_ptr<Pool> thePool = std::make_shared<Pool>();
+    for (Size i=0; i<names; i++) {
+        namesIds.emplace_back(std::string("Name") + std::to_string(i));
+        Handle<DefaultProbabilityTermStructure> probability(
+            std::make_shared<FlatHazardRate>(asofDate,
+                Handle<Quote>(std::make_shared<SimpleQuote>(0.01 + 0.001*i)),
+                dc));
+        std::vector<Issuer::key_curve_pair> curves(1,
+            std::make_pair(NorthAmericaCorpDefaultKey(
+                EURCurrency(), SeniorSec, Period(), 1.), probability));
+        thePool->add(namesIds.back(), Issuer(curves),
+            NorthAmericaCorpDefaultKey(EURCurrency(), SeniorSec, Period(), 1.));
+    }
+    std::shared_ptr<Basket> basket = std::make_shared<Basket>(asofDate,
+        namesIds, std::vector<Real>(names, 10.), thePool, 0.0, 0.1);
+
+    Handle<Quote> correlation(std::make_shared<SimpleQuote>(0.3));
+    auto latentModel = [&]() {
+        return std::make_shared<GaussianDefProbLM>(correlation, names,
+            LatentModelIntegrationType::GaussianQuadrature,
+            GaussianCopulaPolicy::initTraits());
+    };
+
+    std::vector<Date> horizons;
+    horizons.emplace_back(TARGET().advance(asofDate, 1, Years));
+    horizons.emplace_back(TARGET().advance(asofDate, 5, Years));
+
+    struct Results {
+        std::vector<Real> atLeast, etl, perc;
+        std::vector<std::vector<Probability> > nth;
+    };
+    auto simulate = [&](const std::shared_ptr<DefaultLossModel>& model) {
+        basket->setLossModel(model);
+        Results r;
+        for (const auto& d : horizons) {
+            for (Size n=1; n<=3; n++) {
+                r.atLeast.emplace_back(basket->probAtLeastNEvents(n, d));
+                r.nth.emplace_back(basket->probsBeingNthEvent(n, d));
+            }
+            r.etl.emplace_back(basket->expectedTrancheLoss(d));
+            r.perc.emplace_back(basket->percentile(d, 0.95));
+        }
+        return r;
+    };
+
+    std::vector<Real> recoveries(names, recovery);
+    Results serial = simulate(std::make_shared<GaussianRandomDefaultLM>(
+        latentModel(), recoveries, numSims, 1.e-6, 2863311530UL, 1));
+    Results threaded = simulate(std::make_shared<GaussianRandomDefaultLM>(
+        latentModel(), recoveries, numSims, 1.e-6, 2863311530UL, 3));
+    auto accumulating = std::make_shared<GaussianRandomDefaultLM>(
+        latentModel(), recoveries, numSims, 1.e-6, 2863311530UL, 3);
+    accumulating->accumulateStatistics(horizons);
+    Results accumulated = simulate(accumulating);
+
+    // Sobol points are split among threads, results are unchanged
+    for (Size i=0; i<serial.atLeast.size(); i++) {
+        if (threaded.atLeast[i] != serial.atLeast[i] ||
+            accumulated.atLeast[i] != serial.atLeast[i])
+            FAIL_CHECK("probability of at least n events mismatch:"
+                       << "\n    serial:      " << serial.atLeast[i]
+                       << "\n    threaded:    " << threaded.atLeast[i]
+                       << "\n    accumulated: " << accumulated.atLeast[i]);
+        if (threaded.nth[i] != serial.nth[i] ||
+            accumulated.nth[i] != serial.nth[i])
+            FAIL_CHECK("probabilities of being the nth event mismatch");
+    }
+    for (Size i=0; i<horizons.size(); i++) {
+        if (threaded.etl[i] != serial.etl[i] ||
+            std::fabs(accumulated.etl[i] - serial.etl[i]) > 1.e-10)
+            FAIL_CHECK("expected tranche loss mismatch:"
+                       << "\n    serial:      " << serial.etl[i]
+                       << "\n    threaded:    " << threaded.etl[i]
+                       << "\n    accumulated: " << accumulated.etl[i]);
+        // the accumulated percentile is estimated
+        if (threaded.perc[i] != serial.perc[i] ||
+            std::fabs(accumulated.perc[i] - serial.perc[i]) > 0.5)
+            FAIL_CHECK("loss percentile mismatch:"
+                       << "\n    serial:      " << serial.perc[i]
+                       << "\n    threaded:    " << threaded.perc[i]
+                       << "\n    accumulated: " << accumulated.perc[i]);
+    }
+
+    // Mersenne-Twister streams
+    typedef RandomDefaultLM<GaussianCopulaPolicy,
+        RandomSequenceGenerator<MersenneTwisterUniformRng> > MTRandomDefaultLM;
+    Results mt = simulate(std::make_shared<MTRandomDefaultLM>(
+        latentModel(), recoveries, numSims, 1.e-6, 42, 4));
+    for (Size i=0; i<serial.atLeast.size(); i++) {
+        if (std::fabs(mt.atLeast[i] - serial.atLeast[i]) > 0.01)
+            FAIL_CHECK("probability of at least n events mismatch:"
+                       << "\n    Sobol:            " << serial.atLeast[i]
+                       << "\n    Mersenne-Twister: " << mt.atLeast[i]);
+    }
+}
@@ -90,6 +90,107 @@ TEST_CASE("Observable_ObservableSettings", "[Observable]") {
 }
 
 
+namespace {
+
+    class UnregisteringObserver : public Observer {
+      public:
+        UnregisteringObserver(
+                 const std::shared_ptr<Observable>& observable,
+                 const std::vector<std::shared_ptr<UpdateCounter> >& others)
+        : observable_(observable), others_(others) {}
+        void update() {
+            for (Size i=0; i<others_.size(); i+=2)
+                others_[i]->unregisterWith(observable_);
+        }
+      private:
+        std::shared_ptr<Observable> observable_;
+        std::vector<std::shared_ptr<UpdateCounter> > others_;
+    };
+
+    class RegisteringObserver : public Observer {
+      public:
+        explicit RegisteringObserver(
+                           const std::shared_ptr<Observable>& observable)
+        : observable_(observable) {}
+        void update() {
+            std::shared_ptr<UpdateCounter> counter(new UpdateCounter);
+            counter->registerWith(observable_);
+            registered_.push_back(counter);
+        }
+        const std::vector<std::shared_ptr<UpdateCounter> >& registered() {
+            return registered_;
+        }
+      private:
+        std::shared_ptr<Observable> observable_;
+        std::vector<std::shared_ptr<UpdateCounter> > registered_;
+    };
+
+}
+
+TEST_CASE("Observable_ChangesDuringNotification", "[Observable]") {
+
+    INFO("Testing observer registration changes during notification...");
+
+    const std::shared_ptr<SimpleQuote> quote(new SimpleQuote(100.0));
+
+    // enough observers to go beyond the inline storage and the
+    // threshold for indexed lookup
+    const Size n = 100;
+    std::vector<std::shared_ptr<UpdateCounter> > counters;
+    for (Size i=0; i<n; ++i)
+        counters.push_back(std::make_shared<UpdateCounter>());
+
+    std::shared_ptr<UnregisteringObserver> unregistering =
+        std::make_shared<UnregisteringObserver>(quote, counters);
+    unregistering->registerWith(quote);
+    for (Size i=0; i<n; ++i) {
+        counters[i]->registerWith(quote);
+        // registering twice must not duplicate notifications
+        counters[i]->registerWith(quote);
+    }
+    std::shared_ptr<RegisteringObserver> registering =
+        std::make_shared<RegisteringObserver>(quote);
+    registering->registerWith(quote);
+
+    quote->setValue(1.0);
+    // observers removed during the notification might or might not
+    // have been notified, depending on the implementation
+    std::vector<Size> notified(n);
+    for (Size i=0; i<n; ++i) {
+        notified[i] = counters[i]->counter();
+        if ((i % 2 == 1 && notified[i] != 1) || notified[i] > 1)
+            FAIL_CHECK("observer #" << i << " notified "
+                       << notified[i] << " times after first notification");
+    }
+    if (registering->registered().size() != 1)
+        FAIL("one observer should have been registered");
+    if (registering->registered()[0]->counter() != 0)
+        FAIL("observer registered during notification "
+             "should not have been notified");
+
+    quote->setValue(2.0);
+    for (Size i=0; i<n; ++i) {
+        Size expected = (i % 2 == 0) ? notified[i] : 2;
+        if (counters[i]->counter() != expected)
+            FAIL_CHECK("observer #" << i << " notified "
+                       << counters[i]->counter() << " times, "
+                       << expected << " expected after second notification");
+    }
+    if (registering->registered().size() != 2)
+        FAIL("two observers should have been registered");
+    if (registering->registered()[0]->counter() != 1)
+        FAIL("observer registered during first notification "
+             "should have been notified once");
+
+    // observers going out of scope must unregister themselves
+    counters.clear();
+    unregistering.reset();
+    quote->setValue(3.0);
+    if (registering->registered().size() != 3)
+        FAIL("three observers should have been registered");
+}
+
+
 #ifdef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
 
 #include <list>
@@ -0,0 +1,154 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*
+ Observer Pattern Benchmark
+
+ Measures time and resident memory needed to build large numbers of
+ observables, i.e., one million quotes and a leg of 100k Ibor coupons
+ all registered with the same index and evaluation date, as well as
+ the time needed to notify them.
+*/
+
+#include <ql/quotes/simplequote.hpp>
+#include <ql/cashflows/iborcoupon.hpp>
+#include <ql/indexes/ibor/euribor.hpp>
+#include <ql/termstructures/yield/flatforward.hpp>
+#include <ql/time/daycounters/actual360.hpp>
+#include <ql/settings.hpp>
+#include <ql/version.hpp>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <unistd.h>
+
+using namespace QuantLib;
+
+namespace {
+
+    // resident set size in megabytes, or a negative number if unknown
+    double residentMemory() {
+        std::ifstream statm("/proc/self/statm");
+        unsigned long pages, resident;
+        if (!(statm >> pages >> resident))
+            return -1.0;
+        return static_cast<double>(resident)
+            * static_cast<double>(sysconf(_SC_PAGESIZE)) / (1024.0*1024.0);
+    }
+
+    class Probe {
+      public:
+        explicit Probe(const std::string& name)
+        : name_(name), memory_(residentMemory()),
+          start_(std::chrono::steady_clock::now()) {}
+        void report() const {
+            double elapsed = std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - start_).count();
+            double memory = residentMemory();
+            std::cout << name_
+                      << std::string(name_.length() < 45 ?
+                                     45 - name_.length() : 1, ' ')
+                      << std::fixed << std::setprecision(3)
+                      << std::setw(9) << elapsed << " s";
+            if (memory_ >= 0.0 && memory >= 0.0)
+                std::cout << std::setprecision(1)
+                          << std::setw(11) << memory - memory_ << " MB";
+            std::cout << std::endl;
+        }
+      private:
+        std::string name_;
+        double memory_;
+        std::chrono::time_point<std::chrono::steady_clock> start_;
+    };
+
+}
+
+#if defined(QL_ENABLE_SESSIONS)
+namespace QuantLib {
+    Integer sessionId() { return 0; }
+}
+#endif
+
+int main() {
+
+    try {
+        std::cout << std::string(70, '-') << std::endl
+                  << "Observer pattern benchmark, QuantLib " QL_VERSION
+                  << std::endl
+                  << std::string(70, '-') << std::endl;
+
+        const Size nQuotes = 1000000, nCoupons = 100000;
+
+        Date today(15, January, 2020);
+        Settings::instance().evaluationDate() = today;
+
+        {
+            Probe probe("build 1M quotes");
+            std::vector<std::shared_ptr<SimpleQuote> > quotes;
+            quotes.reserve(nQuotes);
+            for (Size i=0; i<nQuotes; ++i)
+                quotes.push_back(
+                    std::make_shared<SimpleQuote>(static_cast<Real>(i)));
+            probe.report();
+
+            Probe links("link 1M handles to the quotes");
+            std::vector<RelinkableHandle<Quote> > handles(nQuotes);
+            for (Size i=0; i<nQuotes; ++i)
+                handles[i].linkTo(quotes[i]);
+            links.report();
+        }
+
+        {
+            Handle<YieldTermStructure> curve(
+                std::make_shared<FlatForward>(today, 0.01, Actual360()));
+            std::shared_ptr<IborIndex> index =
+                std::make_shared<Euribor6M>(curve);
+
+            Probe probe("build a leg of 100k Ibor coupons");
+            Leg leg;
+            leg.reserve(nCoupons);
+            for (Size i=0; i<nCoupons; ++i) {
+                // coupons are spread over 50 years of semiannual periods
+                Date start = today + Period(6*Integer(i % 100), Months);
+                Date end = start + Period(6, Months);
+                leg.push_back(std::make_shared<IborCoupon>(
+                                        end, 100.0, start, end, 2, index));
+            }
+            probe.report();
+
+            Probe notification("notify the 100k coupons");
+            Settings::instance().evaluationDate() = today + 1;
+            notification.report();
+
+            Probe destruction("destroy the 100k coupons");
+            leg.clear();
+            destruction.report();
+        }
+
+        std::cout << std::string(70, '-') << std::endl;
+        return 0;
+
+    } catch (std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    } catch (...) {
+        std::cerr << "unknown error" << std::endl;
+        return 1;
+    }
+}
@@ -34,6 +34,8 @@
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
 #include <ql/math/optimization/differentialevolution.hpp>
 #include <ql/math/optimization/goldstein.hpp>
+#include <ql/experimental/math/fireflyalgorithm.hpp>
+#include <ql/experimental/math/particleswarmoptimization.hpp>
 
 using namespace QuantLib;
 
@@ -552,3 +554,81 @@ TEST_CASE("Optimizers_DifferentialEvolution", "[Optimizers]") {
         }
     }
 }
+
+TEST_CASE("Optimizers_ParallelPopulation", "[Optimizers]") {
+    INFO("Testing parallel evaluation of populations...");
+
+    Griewangk costFunction;
+    Size n = 5;
+    BoundaryConstraint constraint(-600.0, 600.0);
+    EndCriteria endCriteria(50, 40, 1e-12, 1e-10, Null<Real>());
+    unsigned long seed = 42;
+
+    struct Result {
+        Array x;
+        Real value;
+        Integer evaluations;
+    };
+    auto run = [&](OptimizationMethod& method) {
+        Problem problem(costFunction, constraint, Array(n, 100.0));
+        method.minimize(problem, endCriteria);
+        Result r = { problem.currentValue(), problem.functionValue(),
+                     problem.functionEvaluation() };
+        return r;
+    };
+    auto differentialEvolution = [&](Size threads) {
+        DifferentialEvolution de(
+            DifferentialEvolution::Configuration()
+            .withPopulationMembers(50)
+            .withStrategy(DifferentialEvolution::Rand1SelfadaptiveWithRotation)
+            .withAdaptiveCrossover()
+            .withSeed(seed)
+            .withThreads(threads));
+        return run(de);
+    };
+    auto particleSwarm = [&](Size threads) {
+        ParticleSwarmOptimization pso(
+            50, std::make_shared<KNeighbors>(10),
+            std::make_shared<LevyFlightInertia>(1.5, 20, seed),
+            2.05, 2.05, seed, threads);
+        return run(pso);
+    };
+    auto firefly = [&](Size threads, Size Mde, bool synchronousDE) {
+        FireflyAlgorithm fa(
+            50, std::make_shared<ExponentialIntensity>(10.0, 1e-8, 1.0),
+            std::make_shared<LevyFlightWalk>(1.5, 0.5, 1.0, seed),
+            Mde, 1.0, 0.5, seed, threads, synchronousDE);
+        return run(fa);
+    };
+
+    auto check = [](const std::string& name,
+                    const Result& r1, const Result& r2) {
+        if (r1.value != r2.value || r1.evaluations != r2.evaluations) {
+            FAIL_CHECK(name << ": results depend on the number of threads"
+                       << "\n    value:       " << r1.value
+                       << " vs " << r2.value
+                       << "\n    evaluations: " << r1.evaluations
+                       << " vs " << r2.evaluations);
+        }
+        for (Size i=0; i<r1.x.size(); ++i) {
+            if (r1.x[i] != r2.x[i]) {
+                FAIL_CHECK(name << ": minimum depends on the number of threads"
+                           << "\n    x[" << i << "]: " << r1.x[i]
+                           << " vs " << r2.x[i]);
+            }
+        }
+    };
+
+    check("differential evolution",
+          differentialEvolution(1), differentialEvolution(3));
+    check("particle swarm", particleSwarm(1), particleSwarm(3));
+    check("firefly", firefly(1, 0, false), firefly(3, 0, false));
+    check("hybrid firefly", firefly(1, 20, false), firefly(3, 20, false));
+    check("hybrid firefly with synchronous DE",
+          firefly(1, 20, true), firefly(3, 20, true));
+
+    try {
+        DifferentialEvolution::Configuration().withThreads(0);
+        FAIL_CHECK("zero threads accepted");
+    } catch (Error&) {}
+}
@@ -38,6 +38,7 @@
 #include <ql/cashflows/couponpricer.hpp>
 #include <ql/currencies/europe.hpp>
 #include <ql/utilities/dataformatters.hpp>
+#include <ql/utilities/stringutils.hpp>
 
 #include <iostream>
 #include <iomanip>
@@ -424,3 +425,71 @@ TEST_CASE("OvernightIndexedSwap_Bootstrap", "[OvernightIndexedSwap]") {
     }
     */
 }
+
+
+TEST_CASE("OvernightIndexedSwap_SeasonedFixings", "[OvernightIndexedSwap]") {
+
+    INFO("Testing Eonia-swap past fixings after clearing them...");
+
+    CommonVars vars;
+    IndexHistoryCleaner cleaner;
+    // forecasting starts today
+    vars.eoniaTermStructure.linkTo(flatRate(vars.today, 0.05,
+                                            Actual365Fixed()));
+
+    Date effective = vars.calendar.advance(vars.today, -2*Months);
+    shared_ptr<OvernightIndexedSwap> swap =
+        MakeOIS(1*Years, vars.eoniaIndex, 0.04)
+        .withEffectiveDate(effective)
+        .withNominal(vars.nominal)
+        .withDiscountingTermStructure(vars.eoniaTermStructure);
+
+    std::vector<Date> dates;
+    std::vector<Real> fixings;
+    for (Date d = effective; d < vars.today; ++d) {
+        if (vars.eoniaIndex->isValidFixingDate(d)) {
+            dates.push_back(d);
+            fixings.push_back(0.03 + 0.0001*dates.size());
+        }
+    }
+    vars.eoniaIndex->addFixings(dates.begin(), dates.end(),
+                                fixings.begin());
+
+    // names are case insensitive
+    IndexManager::HistoryId id =
+        IndexManager::instance().historyId(
+                                  to_lower_copy(vars.eoniaIndex->name()));
+    if (IndexManager::instance().getHistory(id)[dates.front()] != fixings[0])
+        FAIL_CHECK("fixing not retrieved through its history id");
+
+    Real npv = swap->NPV();
+
+    Flag flag;
+    flag.registerWith(vars.eoniaIndex);
+    vars.eoniaIndex->clearFixings();
+    if (!flag.isUp())
+        FAIL_CHECK("observer not notified of cleared fixings");
+    if (IndexManager::instance().hasHistory(vars.eoniaIndex->name()))
+        FAIL_CHECK("fixings still stored after being cleared");
+    if (!IndexManager::instance().getHistory(id).empty())
+        FAIL_CHECK("history id refers to cleared fixings");
+    bool missingFixings = false;
+    try {
+        swap->NPV();
+    } catch (Error&) {
+        missingFixings = true;
+    }
+    if (!missingFixings)
+        FAIL_CHECK("cleared fixings still used by the swap");
+
+    flag.lower();
+    vars.eoniaIndex->addFixings(dates.begin(), dates.end(),
+                                fixings.begin());
+    if (!flag.isUp())
+        FAIL_CHECK("observer not notified of restored fixings");
+    if (std::fabs(swap->NPV() - npv) > 1.0e-12)
+        FAIL_CHECK("swap value not recovered with the restored fixings:"
+                   << std::setprecision(12)
+                   << "\n    original: " << npv
+                   << "\n    restored: " << swap->NPV());
+}
@@ -809,6 +809,96 @@ TEST_CASE("PiecewiseYieldCurve_Observability", "[PiecewiseYieldCurve]") {
 }
 
 
+TEST_CASE("PiecewiseYieldCurve_IncrementalBootstrap", "[PiecewiseYieldCurve]") {
+
+    INFO("Testing re-bootstrap after changes of a few quotes...");
+
+    CommonVars vars, reference;
+
+    typedef PiecewiseYieldCurve<Discount,LogLinear> Curve;
+    std::shared_ptr<Curve> curve =
+        std::make_shared<Curve>(vars.settlementDays, vars.calendar,
+                                vars.instruments, Actual360(), 1.0e-12);
+    curve->recalculate();
+
+    const Size n = vars.deposits + vars.swaps;
+    Size changed[] = { n-1, n/2, 0, n-1 };
+    for (Size k=0; k<LENGTH(changed); ++k) {
+        const Size j = changed[k];
+        const std::vector<Real> before = curve->data();
+
+        vars.rates[j]->setValue(vars.rates[j]->value() + 0.0005*(k+1));
+        reference.rates[j]->setValue(vars.rates[j]->value());
+        const std::vector<Real>& after = curve->data();
+
+        // the curve is compared with one bootstrapped from scratch
+        Curve expected(reference.settlementDays, reference.calendar,
+                       reference.instruments, Actual360(), 1.0e-12);
+        const std::vector<Real>& data = expected.data();
+
+        REQUIRE(after.size() == data.size());
+        for (Size i=0; i<data.size(); ++i) {
+            if (std::fabs(after[i] - data[i]) > 1.0e-10)
+                FAIL_CHECK("re-bootstrapped curve differs from new curve"
+                           << "\n    changed quote: " << io::ordinal(j+1)
+                           << "\n    pillar:        " << io::ordinal(i)
+                           << "\n    calculated:    " << after[i]
+                           << "\n    expected:      " << data[i]);
+        }
+        // pillars before the changed one are not affected
+        for (Size i=0; i<=j; ++i) {
+            if (after[i] != before[i])
+                FAIL_CHECK("unaffected pillar changed after quote change"
+                           << "\n    changed quote: " << io::ordinal(j+1)
+                           << "\n    pillar:        " << io::ordinal(i)
+                           << "\n    before:        " << before[i]
+                           << "\n    after:         " << after[i]);
+        }
+    }
+}
+
+
+TEST_CASE("PiecewiseYieldCurve_IncrementalBootstrapWithJumps", "[PiecewiseYieldCurve]") {
+
+    INFO("Testing re-bootstrap after changes of jumps and quotes...");
+
+    CommonVars vars, reference;
+
+    typedef PiecewiseYieldCurve<Discount,LogLinear> Curve;
+    std::shared_ptr<SimpleQuote> jump = std::make_shared<SimpleQuote>(0.999);
+    std::vector<Handle<Quote> > jumps(1, Handle<Quote>(jump));
+    std::vector<Date> jumpDates(1, vars.settlement + 2*Years);
+    std::shared_ptr<Curve> curve =
+        std::make_shared<Curve>(vars.settlementDays, vars.calendar,
+                                vars.instruments, Actual360(),
+                                jumps, jumpDates, 1.0e-12);
+    curve->recalculate();
+
+    // the jump and the last quote change before the curve is used
+    const Size j = vars.deposits + vars.swaps - 1;
+    jump->setValue(0.995);
+    vars.rates[j]->setValue(vars.rates[j]->value() + 0.0005);
+    reference.rates[j]->setValue(vars.rates[j]->value());
+    const std::vector<Real>& after = curve->data();
+
+    std::vector<Handle<Quote> > expectedJumps(
+        1, Handle<Quote>(std::make_shared<SimpleQuote>(jump->value())));
+    Curve expected(reference.settlementDays, reference.calendar,
+                   reference.instruments, Actual360(),
+                   expectedJumps, jumpDates, 1.0e-12);
+    const std::vector<Real>& data = expected.data();
+
+    REQUIRE(after.size() == data.size());
+    for (Size i=0; i<data.size(); ++i) {
+        if (std::fabs(after[i] - data[i]) > 1.0e-10)
+            FAIL_CHECK("re-bootstrapped curve differs from new curve"
+                       << "\n    pillar:     " << io::ordinal(i)
+                       << "\n    calculated: " << after[i]
+                       << "\n    expected:   " << data[i]);
+    }
+}
+
+
 TEST_CASE("PiecewiseYieldCurve_LiborFixing", "[PiecewiseYieldCurve]") {
 
     INFO(
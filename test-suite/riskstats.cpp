@@ -23,6 +23,8 @@
 #include <ql/math/statistics/incrementalstatistics.hpp>
 #include <ql/math/statistics/sequencestatistics.hpp>
 #include <ql/math/randomnumbers/sobolrsg.hpp>
+#include <ql/math/randomnumbers/mt19937uniformrng.hpp>
+#include <ql/math/distributions/normaldistribution.hpp>
 #include <ql/math/comparison.hpp>
 
 using namespace QuantLib;
@@ -605,3 +607,159 @@ TEST_CASE("RiskStatistics_Results", "[RiskStatistics]") {
     }
 }
 
+TEST_CASE("RiskStatistics_TDigest", "[RiskStatistics]") {
+
+    INFO("Testing risk measures with bounded memory...");
+
+    const Size nSamples = 200000, nBatches = 4;
+
+    MersenneTwisterUniformRng rng(42);
+    InverseCumulativeNormal invNormal(0.01, 0.2);
+
+    RiskStatistics exact;
+    TDigestRiskStatistics digest;
+    std::vector<TDigestRiskStatistics> batches(nBatches);
+    SequenceStatistics exactSequence(2);
+    SequenceStatisticsTDigest sequence(2), sequenceBatch(2);
+    std::vector<Real> point(2);
+
+    for (Size i=0; i<nSamples; ++i) {
+        Real x = invNormal(rng.nextReal());
+        exact.add(x);
+        digest.add(x);
+        batches[i % nBatches].add(x);
+        point[0] = x;
+        point[1] = x*x;
+        exactSequence.add(point);
+        if (i % 2 == 0)
+            sequence.add(point);
+        else
+            sequenceBatch.add(point);
+    }
+
+    TDigestRiskStatistics merged;
+    for (Size i=0; i<nBatches; ++i)
+        merged.merge(batches[i]);
+    sequence.merge(sequenceBatch);
+
+    if (digest.centroids() > digest.compression())
+        FAIL("too many centroids stored: " << digest.centroids()
+             << " for compression " << digest.compression());
+
+    Real percentiles[] = { 0.01, 0.05, 0.25, 0.5, 0.75, 0.95, 0.99 };
+
+    const TDigestRiskStatistics* digests[] = { &digest, &merged };
+    for (Size k=0; k<LENGTH(digests); ++k) {
+        const TDigestRiskStatistics& s = *digests[k];
+
+        if (s.samples() != exact.samples())
+            FAIL("wrong number of samples\n"
+                 << "    calculated: " << s.samples() << "\n"
+                 << "    expected:   " << exact.samples());
+
+        Real tolerance = 1.0e-10;
+        Real moments[][2] = {
+            { s.mean(), exact.mean() },
+            { s.variance(), exact.variance() },
+            { s.skewness(), exact.skewness() },
+            { s.kurtosis(), exact.kurtosis() },
+            { s.min(), exact.min() },
+            { s.max(), exact.max() }
+        };
+        for (Size j=0; j<LENGTH(moments); ++j) {
+            if (std::fabs(moments[j][0]-moments[j][1]) > tolerance)
+                FAIL("wrong moment #" << j
+                     << (k == 0 ? "" : " for merged statistics") << "\n"
+                     << std::setprecision(16)
+                     << "    calculated: " << moments[j][0] << "\n"
+                     << "    expected:   " << moments[j][1]);
+        }
+
+        // well within the sampling error of the estimates
+        tolerance = 1.0e-3;
+        for (Size j=0; j<LENGTH(percentiles); ++j) {
+            Real calculated = s.percentile(percentiles[j]);
+            Real expected = exact.percentile(percentiles[j]);
+            if (std::fabs(calculated-expected) > tolerance)
+                FAIL("wrong " << percentiles[j] << " percentile"
+                     << (k == 0 ? "" : " for merged statistics") << "\n"
+                     << std::setprecision(16)
+                     << "    calculated: " << calculated << "\n"
+                     << "    expected:   " << expected << "\n"
+                     << "    tolerance:  " << tolerance);
+            calculated = s.topPercentile(percentiles[j]);
+            expected = exact.topPercentile(percentiles[j]);
+            if (std::fabs(calculated-expected) > tolerance)
+                FAIL("wrong " << percentiles[j] << " top percentile"
+                     << (k == 0 ? "" : " for merged statistics") << "\n"
+                     << std::setprecision(16)
+                     << "    calculated: " << calculated << "\n"
+                     << "    expected:   " << expected << "\n"
+                     << "    tolerance:  " << tolerance);
+        }
+
+        Real calculated = s.valueAtRisk(0.99);
+        Real expected = exact.valueAtRisk(0.99);
+        if (std::fabs(calculated-expected) > tolerance)
+            FAIL("wrong value-at-risk"
+                 << (k == 0 ? "" : " for merged statistics") << "\n"
+                 << std::setprecision(16)
+                 << "    calculated: " << calculated << "\n"
+                 << "    expected:   " << expected << "\n"
+                 << "    tolerance:  " << tolerance);
+
+        calculated = s.expectedShortfall(0.99);
+        expected = exact.expectedShortfall(0.99);
+        tolerance = std::fabs(expected)*1.0e-2;
+        if (std::fabs(calculated-expected) > tolerance)
+            FAIL("wrong expected shortfall"
+                 << (k == 0 ? "" : " for merged statistics") << "\n"
+                 << std::setprecision(16)
+                 << "    calculated: " << calculated << "\n"
+                 << "    expected:   " << expected << "\n"
+                 << "    tolerance:  " << tolerance);
+    }
+
+    Matrix calculated = sequence.covariance();
+    Matrix expected = exactSequence.covariance();
+    std::vector<Real> calculatedVaR = sequence.valueAtRisk(0.99);
+    std::vector<Real> expectedVaR = exactSequence.valueAtRisk(0.99);
+    for (Size i=0; i<2; ++i) {
+        for (Size j=0; j<2; ++j) {
+            if (std::fabs(calculated[i][j]-expected[i][j]) > 1.0e-10)
+                FAIL("wrong covariance for merged sequence statistics\n"
+                     << std::setprecision(16)
+                     << "    calculated: " << calculated[i][j] << "\n"
+                     << "    expected:   " << expected[i][j]);
+        }
+        if (std::fabs(calculatedVaR[i]-expectedVaR[i]) > 1.0e-3)
+            FAIL("wrong value-at-risk for merged sequence statistics\n"
+                 << std::setprecision(16)
+                 << "    calculated: " << calculatedVaR[i] << "\n"
+                 << "    expected:   " << expectedVaR[i]);
+    }
+
+    // the compression is passed on to the statistics of each dimension
+    TDigestRiskStatistics prototype(TDigestStatistics(50.0));
+    if (prototype.compression() != 50.0)
+        FAIL("compression not set: " << prototype.compression()
+             << " instead of 50");
+    TDigestRiskStatistics coarse = prototype;
+    SequenceStatisticsTDigest coarseSequence(0, prototype);
+    for (Size i=0; i<nSamples; ++i) {
+        Real x = invNormal(rng.nextReal());
+        coarse.add(x);
+        point[0] = x;
+        point[1] = x*x;
+        coarseSequence.add(point);
+    }
+    if (coarse.centroids() > 50)
+        FAIL("too many centroids stored: " << coarse.centroids()
+             << " for compression 50");
+    Real coarseVaR = coarseSequence.valueAtRisk(0.99)[0];
+    if (coarseVaR != coarse.valueAtRisk(0.99))
+        FAIL("compression not used by sequence statistics\n"
+             << std::setprecision(16)
+             << "    calculated: " << coarseVaR << "\n"
+             << "    expected:   " << coarse.valueAtRisk(0.99));
+}
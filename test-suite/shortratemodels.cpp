@@ -286,6 +286,97 @@ TEST_CASE("ShortRateModel_CachedHullWhite2", "[ShortRateModel]") {
     }
 }
 
+TEST_CASE("ShortRateModel_ParallelCalibration", "[ShortRateModel]") {
+    INFO("Testing multi-threaded Hull-White calibration against serial one...");
+
+    SavedSettings backup;
+    IndexHistoryCleaner cleaner;
+
+    Date today(15, February, 2002);
+    Date settlement(19, February, 2002);
+    Settings::instance().evaluationDate() = today;
+    Handle<YieldTermStructure> termStructure(flatRate(settlement,0.04875825,
+                                                      Actual365Fixed()));
+    std::shared_ptr<IborIndex> index(new Euribor6M(termStructure));
+
+    std::vector<std::shared_ptr<Quote> > vols;
+    std::vector<std::pair<Integer, Integer> > tenors;
+    for (Integer start=1; start<=5; ++start) {
+        for (Integer length=1; length<=5; ++length) {
+            tenors.emplace_back(start, length);
+            vols.emplace_back(new SimpleQuote(0.12 - 0.003*start
+                                              - 0.002*length));
+        }
+    }
+
+    // builds a model and its own helpers and engine
+    auto makeReplica = [&]() {
+        CalibratedModel::Replica r;
+        std::shared_ptr<HullWhite> model(new HullWhite(termStructure));
+        std::shared_ptr<PricingEngine> engine(
+                                         new JamshidianSwaptionEngine(model));
+        for (Size i=0; i<tenors.size(); i++) {
+            std::shared_ptr<CalibrationHelper> helper(
+                             new SwaptionHelper(Period(tenors[i].first, Years),
+                                                Period(tenors[i].second, Years),
+                                                Handle<Quote>(vols[i]),
+                                                index,
+                                                Period(1, Years), Thirty360(),
+                                                Actual360(), termStructure));
+            helper->setPricingEngine(engine);
+            r.helpers.push_back(helper);
+        }
+        r.model = model;
+        return r;
+    };
+
+    EndCriteria endCriteria(10000, 100, 1e-6, 1e-8, 1e-8);
+
+    for (Size k=0; k<2; ++k) {
+        // with and without the Jacobian provided by the cost function
+        bool useCostFunctionsJacobian = (k == 1);
+
+        CalibratedModel::Replica serial = makeReplica();
+        LevenbergMarquardt serialMethod(1.0e-8, 1.0e-8, 1.0e-8,
+                                        useCostFunctionsJacobian);
+        serial.model->calibrate(serial.helpers, serialMethod, endCriteria);
+
+        CalibratedModel::Replica parallel = makeReplica();
+        parallel.model->setCalibrationThreads(3, makeReplica);
+        LevenbergMarquardt parallelMethod(1.0e-8, 1.0e-8, 1.0e-8,
+                                          useCostFunctionsJacobian);
+        parallel.model->calibrate(parallel.helpers, parallelMethod,
+                                  endCriteria);
+
+        Array expected = serial.model->params();
+        Array calculated = parallel.model->params();
+        for (Size i=0; i<expected.size(); ++i) {
+            if (calculated[i] != expected[i])
+                FAIL_CHECK("parameter #" << i << " differs from serial "
+                           "calibration "
+                           << (useCostFunctionsJacobian ?
+                               "(cost-function Jacobian)" : "") << ":\n"
+                           << std::setprecision(16)
+                           << "    calculated: " << calculated[i] << "\n"
+                           << "    expected:   " << expected[i]);
+        }
+        if (parallel.model->functionEvaluation()
+            != serial.model->functionEvaluation())
+            FAIL_CHECK("number of function evaluations differs from "
+                       "serial calibration:\n"
+                       << "    calculated: "
+                       << parallel.model->functionEvaluation() << "\n"
+                       << "    expected:   "
+                       << serial.model->functionEvaluation());
+        for (Size i=0; i<serial.helpers.size(); ++i) {
+            if (parallel.helpers[i]->modelValue()
+                != serial.helpers[i]->modelValue())
+                FAIL_CHECK("model value of helper #" << i
+                           << " differs from serial calibration");
+        }
+    }
+}
+
 TEST_CASE("ShortRateModel_Swaps", "[ShortRateModel]") {
     INFO("Testing Hull-White swap pricing against known values...");
 
@@ -21,8 +21,13 @@
 #include "utilities.hpp"
 #include <ql/timeseries.hpp>
 #include <ql/prices.hpp>
+#include <ql/indexes/fixingsloader.hpp>
 #include <ql/time/calendars/unitedstates.hpp>
+#include <ql/utilities/densedatemap.hpp>
+#include <cstdio>
+#include <fstream>
 #include <functional>
+#include <limits>
 
 #if defined(__GNUC__) && (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
 #pragma GCC diagnostic push
@@ -192,3 +197,175 @@ TEST_CASE("TimeSeries_Iterators", "[TimeSeries]") {
         FAIL_CHECK("lastDate does not match");
     }
 }
+
+TEST_CASE("TimeSeries_DenseContainer", "[TimeSeries]") {
+    INFO("Testing time series with dense storage...");
+
+    typedef TimeSeries<Real, DenseDateMap<Real> > DenseTimeSeries;
+
+    std::vector<Date> dates = { Date(25, March, 2005),
+                                Date(29, March, 2005),
+                                Date(15, March, 2005) };
+    std::vector<Real> prices = { 25.0, 23.0, 20.0 };
+    TimeSeries<Real> ts(dates.begin(), dates.end(), prices.begin());
+    DenseTimeSeries dense(dates.begin(), dates.end(), prices.begin());
+
+    if (dense.size() != ts.size())
+        FAIL_CHECK("size does not match: " << dense.size()
+                   << " instead of " << ts.size());
+    if (dense.firstDate() != ts.firstDate())
+        FAIL_CHECK("first date does not match");
+    if (dense.lastDate() != ts.lastDate())
+        FAIL_CHECK("last date does not match");
+    if (dense.dates() != ts.dates())
+        FAIL_CHECK("dates do not match");
+    if (dense.values() != ts.values())
+        FAIL_CHECK("values do not match");
+
+    std::vector<std::pair<Date,Real> > data(ts.size());
+    std::copy(dense.crbegin(), dense.crend(), data.begin());
+    if (data[0] != std::make_pair(Date(29, March, 2005), 23.0)
+        || data[2] != std::make_pair(Date(15, March, 2005), 20.0))
+        FAIL_CHECK("reverse iteration does not match");
+
+    std::vector<Date> reversedDates(ts.size());
+    std::copy(dense.crbegin_time(), dense.crend_time(),
+              reversedDates.begin());
+    if (reversedDates[1] != Date(25, March, 2005))
+        FAIL_CHECK("reverse time iteration does not match");
+
+    // missing days are null, and only added when written
+    const DenseTimeSeries& constDense = dense;
+    if (constDense[Date(20, March, 2005)] != Null<Real>()
+        || constDense[Date(1, January, 2005)] != Null<Real>()
+        || constDense[Date(1, January, 2006)] != Null<Real>())
+        FAIL_CHECK("missing datum is not null");
+    if (dense.size() != 3)
+        FAIL_CHECK("missing datum was added by lookup");
+
+    // adding dates before the first one and after the last one
+    dense[Date(1, March, 2005)] = 18.0;
+    dense[Date(4, April, 2005)] = 24.0;
+    dense[Date(25, March, 2005)] = 26.0;
+    if (dense.size() != 5
+        || dense.firstDate() != Date(1, March, 2005)
+        || dense.lastDate() != Date(4, April, 2005)
+        || constDense[Date(15, March, 2005)] != 20.0
+        || constDense[Date(25, March, 2005)] != 26.0)
+        FAIL_CHECK("insertion of data failed");
+
+    // nulls written through the non-const accessor are kept as data,
+    // as for the default container
+    dense[Date(21, March, 2005)];
+    ts[Date(21, March, 2005)];
+    if (dense.size() != 6 || ts.size() != 4)
+        FAIL_CHECK("null datum was not added");
+
+    // conversion between containers
+    TimeSeries<Real> converted = dense;
+    if (converted.dates() != dense.dates()
+        || converted.values() != dense.values())
+        FAIL_CHECK("conversion to map-based time series failed");
+    DenseTimeSeries roundTrip = converted;
+    if (roundTrip.dates() != dense.dates()
+        || roundTrip.values() != dense.values())
+        FAIL_CHECK("conversion to dense time series failed");
+
+    // the count of data follows writes and removals
+    DenseDateMap<Real> map;
+    map.assign(Date(1, March, 2005), prices.begin(), prices.end());
+    map[Date(10, March, 2005)] = 21.0;
+    map[Date(20, March, 2005)];
+    map.erase(Date(2, March, 2005));
+    map.erase(Date(5, March, 2005));
+    if (map.size() != 3 || map.empty())
+        FAIL_CHECK("wrong number of data: " << map.size()
+                   << " instead of 3");
+    map[Date(11, March, 2005)] = 22.0;
+    const DenseDateMap<Real>& constMap = map;
+    if (constMap.size() != 4)
+        FAIL_CHECK("datum just written is not counted");
+    map[Date(10, March, 2005)] = std::numeric_limits<Real>::quiet_NaN();
+    if (map.size() != 3 || map.lookup(Date(10, March, 2005)) != nullptr)
+        FAIL_CHECK("datum overwritten by NaN is still counted");
+    map.clear();
+    if (map.size() != 0 || !map.empty())
+        FAIL_CHECK("data left after clearing");
+}
+
+TEST_CASE("TimeSeries_FixingsLoader", "[TimeSeries]") {
+    INFO("Testing bulk loading of index fixings...");
+
+    IndexHistoryCleaner cleaner;
+
+    const std::string csvFile = "quantlib-test-fixings.csv";
+    const std::string binaryFile = "quantlib-test-fixings.bin";
+    {
+        std::ofstream out(csvFile.c_str());
+        out << "# name,date,fixing\n"
+            << "Euribor6M Actual/360,2024-01-16,0.0391\n"
+            << "Euribor6M Actual/360,2024-01-15,0.0390\n"
+            << "\n"
+            << "EuriBor6M Actual/360 , 2024-01-19 , 0.0393\n"
+            << "ESTRActual/360,2023-12-29,0.0390\n"
+            << "ESTRActual/360,2024-01-02,0.03905\n";
+    }
+
+    // fixings loaded from CSV replace the stored ones
+    TimeSeries<Real> stale;
+    stale[Date(3, January, 2024)] = 0.04;
+    IndexManager::instance().setHistory("ESTRActual/360", stale);
+    Size loaded = loadFixingsFromCsv(csvFile);
+    std::remove(csvFile.c_str());
+    if (loaded != 2)
+        FAIL_CHECK(loaded << " indexes loaded instead of 2");
+
+    const FixingTimeSeries& euribor =
+        IndexManager::instance().getHistory("EURIBOR6M ACTUAL/360");
+    const FixingTimeSeries& estr =
+        IndexManager::instance().getHistory("ESTRACTUAL/360");
+    if (euribor.size() != 3 || euribor.firstDate() != Date(15, January, 2024)
+        || euribor[Date(16, January, 2024)] != 0.0391
+        || euribor[Date(17, January, 2024)] != Null<Real>()
+        || euribor[Date(19, January, 2024)] != 0.0393)
+        FAIL_CHECK("Euribor fixings not loaded correctly");
+    if (estr.size() != 2 || estr[Date(2, January, 2024)] != 0.03905
+        || estr[Date(3, January, 2024)] != Null<Real>())
+        FAIL_CHECK("ESTR fixings not loaded correctly");
+
+    // binary round trip, read into a buffer or mapped in memory
+    const std::vector<Date> euriborDates = euribor.dates();
+    const std::vector<Real> euriborFixings = euribor.values();
+    const std::vector<Date> estrDates = estr.dates();
+    const std::vector<Real> estrFixings = estr.values();
+    saveFixingsToBinary(binaryFile);
+
+    for (bool memoryMapped : { false, true }) {
+        IndexManager::instance().clearHistories();
+        loaded = loadFixingsFromBinary(binaryFile, memoryMapped);
+        if (loaded != 2)
+            FAIL_CHECK(loaded << " indexes loaded instead of 2"
+                       << (memoryMapped ? " from mapped file" : ""));
+        if (euribor.dates() != euriborDates
+            || euribor.values() != euriborFixings
+            || estr.dates() != estrDates
+            || estr.values() != estrFixings)
+            FAIL_CHECK("fixings not restored"
+                       << (memoryMapped ? " from mapped file" : ""));
+    }
+    std::remove(binaryFile.c_str());
+
+    {
+        std::ofstream out(csvFile.c_str());
+        out << "Euribor6M Actual/360,2024-01-42,0.0391\n";
+    }
+    bool thrown = false;
+    try {
+        loadFixingsFromCsv(csvFile);
+    } catch (Error&) {
+        thrown = true;
+    }
+    std::remove(csvFile.c_str());
+    if (!thrown)
+        FAIL_CHECK("invalid fixing date was not detected");
+}